@@ -75,7 +75,7 @@ int launch_window_application(int argc, char* argv[], SDL_Window* window, SDL_GL
 {
     ng::application app(argc, argv);
 
-    // We render at 60 fps
+    // We tick at 60 fps, rendering is interpolated between ticks
     const ng::frame_duration tick_delay{1.0 / 60.0};
 
     ng::frame_duration previous_duration = tick_delay;
@@ -107,9 +107,9 @@ int launch_window_application(int argc, char* argv[], SDL_Window* window, SDL_GL
             tick_accumulator -= tick_delay;
         }
 
-        // Render current frame
-        // TODO: Add interpolation between frames at some point
-        app.render();
+        // Render current frame between the last two ticks using the time left in the accumulator
+        const float alpha = static_cast<float>(tick_accumulator / tick_delay);
+        app.render(alpha);
         SDL_GL_SwapWindow(window);
 
         // Give back CPU to OS the goal is to minimize interruption in the middle of a frame
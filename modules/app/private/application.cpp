@@ -21,18 +21,28 @@ application::application()
 
 application::application(int argc, char* argv[])
 : running_(true)
+, workers_()
+, tree_()
+, interpolated_transforms_()
 {
 
 }
 
 void application::tick(frame_duration dt)
 {
+    // The transforms reached by the previous tick are the ones the renderer interpolates from
+    tree_.capture_world_transforms();
 
+    tree_.scheduler().tick(dt, workers_);
+    tree_.events().dispatch_queued();
+
+    // And the transforms reached by this tick are the ones it interpolates to
+    tree_.update_world_transforms(workers_);
 }
 
-void application::render()
+void application::render(float alpha)
 {
-
+    tree_.transforms().interpolate(alpha, interpolated_transforms_);
 }
 
 bool application::running() const noexcept
@@ -40,6 +50,16 @@ bool application::running() const noexcept
     return running_;
 }
 
+node_tree& application::tree() noexcept
+{
+    return tree_;
+}
+
+const node_tree& application::tree() const noexcept
+{
+    return tree_;
+}
+
 void application::on_quit()
 {
     running_ = false;
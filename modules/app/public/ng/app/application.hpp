@@ -2,6 +2,10 @@
 #define NGINE_APP_APPLICATION_HPP
 
 #include <ng/core/time.hpp>
+#include <ng/core/thread_pool.hpp>
+#include <ng/core/affine2d.hpp>
+#include <ng/gameplay/node_tree.hpp>
+#include <vector>
 #include <cstdint>
 
 namespace ng
@@ -18,6 +22,13 @@ class application
 {
     uint16_t key_modifiers_;
     bool running_;
+
+    // Ticks the thread safe tick groups of the tree
+    thread_pool workers_;
+    node_tree tree_;
+
+    // World transform of every node2d for the frame being rendered, indexed by transform slot
+    std::vector<affine2d> interpolated_transforms_;
 public:
     /**
      * Should be called once before an application is instanced
@@ -34,13 +45,18 @@ public:
     /**
      * Called every frame by host to give application a chance to periodically update itself
      * @param dt The duration of the previous frame in seconds
+     * @note Captures the world transforms reached by the previous tick, then ticks the tick groups of the tree,
+     *       sends the queued events and computes the world transforms reached by this tick
      */
     void tick(frame_duration dt);
 
     /**
      * Called every frame by host to give application the signal to render it's current state onto the screen
+     * @param alpha How far the frame is between the last two ticks, in [0, 1)
+     * @note The application renders world transforms interpolated between the last two ticks with alpha,
+     *       so the display stays smooth even when ticking at a lower rate than it renders
      */
-    void render();
+    void render(float alpha);
 
     /**
      * Check if the application is still running
@@ -49,6 +65,13 @@ public:
      */
     [[nodiscard]] bool running() const noexcept;
 
+    /**
+     * Returns the tree of nodes of the application
+     * @return The tree ticked by the application
+     */
+    [[nodiscard]] node_tree& tree() noexcept;
+    [[nodiscard]] const node_tree& tree() const noexcept;
+
     /**
      * Called by host when the user is requesting the game to quit
      */
@@ -0,0 +1,89 @@
+#include "aabb2d.hpp"
+#include "affine2d.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ng
+{
+
+aabb2d aabb2d::from_center(const glm::vec2& center, const glm::vec2& half_extents) noexcept
+{
+    return aabb2d{center - half_extents, center + half_extents};
+}
+
+bool aabb2d::empty() const noexcept
+{
+    return min.x > max.x || min.y > max.y;
+}
+
+glm::vec2 aabb2d::center() const noexcept
+{
+    return (min + max) * 0.5f;
+}
+
+glm::vec2 aabb2d::size() const noexcept
+{
+    return max - min;
+}
+
+bool aabb2d::contains(const glm::vec2& point) const noexcept
+{
+    return point.x >= min.x && point.x <= max.x
+        && point.y >= min.y && point.y <= max.y;
+}
+
+bool aabb2d::contains(const aabb2d& other) const noexcept
+{
+    return other.min.x >= min.x && other.max.x <= max.x
+        && other.min.y >= min.y && other.max.y <= max.y;
+}
+
+bool aabb2d::intersects(const aabb2d& other) const noexcept
+{
+    return other.min.x <= max.x && other.max.x >= min.x
+        && other.min.y <= max.y && other.max.y >= min.y;
+}
+
+float aabb2d::distance_squared(const glm::vec2& point) const noexcept
+{
+    const float dx = std::max({min.x - point.x, 0.f, point.x - max.x});
+    const float dy = std::max({min.y - point.y, 0.f, point.y - max.y});
+
+    return dx * dx + dy * dy;
+}
+
+aabb2d aabb2d::merge(const aabb2d& other) const noexcept
+{
+    if(empty())
+    {
+        return other;
+    }
+
+    if(other.empty())
+    {
+        return *this;
+    }
+
+    return aabb2d{glm::min(min, other.min), glm::max(max, other.max)};
+}
+
+aabb2d aabb2d::transform(const affine2d& transform) const noexcept
+{
+    if(empty())
+    {
+        return *this;
+    }
+
+    // Transform the center and project the half extents on each world axis instead of transforming the four corners
+    const glm::vec2 half_extents = size() * 0.5f;
+    const glm::vec2 transformed_center = transform.transform_point(center());
+    const glm::vec2 transformed_half_extents{
+        std::abs(transform.m00) * half_extents.x + std::abs(transform.m10) * half_extents.y,
+        std::abs(transform.m01) * half_extents.x + std::abs(transform.m11) * half_extents.y
+    };
+
+    return aabb2d{transformed_center - transformed_half_extents, transformed_center + transformed_half_extents};
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include "affine2d.hpp"
+#include "transform2d.hpp"
+
+#include <glm/gtc/constants.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace ng
+{
+
+namespace
+{
+
+// Components of an affine transform, the rows of its linear part are a rotation of the x axis scaled by scale_x,
+// and a rotation of the y axis scaled by scale_y and sheared along the x axis
+struct affine_components
+{
+    glm::vec2 translation;
+    float rotation;
+    float scale_x;
+    float scale_y;
+    float shear;
+};
+
+affine_components decompose(const affine2d& transform) noexcept
+{
+    affine_components components;
+    components.translation = glm::vec2{transform.tx, transform.ty};
+    components.scale_x = std::hypot(transform.m00, transform.m10);
+
+    // Without any x axis there is no rotation to find, the y axis is kept as it is
+    float cos_rotation = 1.f;
+    float sin_rotation = 0.f;
+    if(components.scale_x > 0.f)
+    {
+        cos_rotation = transform.m00 / components.scale_x;
+        sin_rotation = -transform.m10 / components.scale_x;
+    }
+
+    components.rotation = std::atan2(sin_rotation, cos_rotation);
+    components.shear = transform.m01 * cos_rotation - transform.m11 * sin_rotation;
+    components.scale_y = transform.m01 * sin_rotation + transform.m11 * cos_rotation;
+
+    return components;
+}
+
+affine2d compose(const affine_components& components) noexcept
+{
+    const float cos_rotation = std::cos(components.rotation);
+    const float sin_rotation = std::sin(components.rotation);
+
+    return affine2d{
+        components.scale_x * cos_rotation,
+        components.shear * cos_rotation + components.scale_y * sin_rotation,
+        -components.scale_x * sin_rotation,
+        components.scale_y * cos_rotation - components.shear * sin_rotation,
+        components.translation.x,
+        components.translation.y
+    };
+}
+
+}
+
+affine2d::affine2d(const transform2d& transform) noexcept
+{
+    // Same as transform.matrix() without building the translation, scale and rotation matrices
+    const float cos_rotation = std::cos(transform.rotation);
+    const float sin_rotation = std::sin(transform.rotation);
+
+    m00 = transform.scale.x * cos_rotation;
+    m01 = transform.scale.y * sin_rotation;
+    m10 = -transform.scale.x * sin_rotation;
+    m11 = transform.scale.y * cos_rotation;
+    tx = transform.translation.x;
+    ty = transform.translation.y;
+}
+
+affine2d::affine2d(const glm::mat3& matrix) noexcept
+: m00{matrix[0][0]}, m01{matrix[0][1]}
+, m10{matrix[1][0]}, m11{matrix[1][1]}
+, tx{matrix[2][0]}, ty{matrix[2][1]}
+{
+
+}
+
+glm::mat3 affine2d::matrix() const noexcept
+{
+    return glm::mat3{
+        m00, m01, 0.f,
+        m10, m11, 0.f,
+        tx,  ty,  1.f
+    };
+}
+
+affine2d affine2d::inverse() const noexcept
+{
+    const float inverse_determinant = 1.f / (m00 * m11 - m10 * m01);
+
+    const float inverse_m00 = m11 * inverse_determinant;
+    const float inverse_m01 = -m01 * inverse_determinant;
+    const float inverse_m10 = -m10 * inverse_determinant;
+    const float inverse_m11 = m00 * inverse_determinant;
+
+    return affine2d{
+        inverse_m00, inverse_m01,
+        inverse_m10, inverse_m11,
+        -(inverse_m00 * tx + inverse_m10 * ty),
+        -(inverse_m01 * tx + inverse_m11 * ty)
+    };
+}
+
+glm::vec2 affine2d::transform_point(const glm::vec2& point) const noexcept
+{
+    return glm::vec2{m00 * point.x + m10 * point.y + tx,
+                     m01 * point.x + m11 * point.y + ty};
+}
+
+glm::vec2 affine2d::transform_vector(const glm::vec2& vector) const noexcept
+{
+    return glm::vec2{m00 * vector.x + m10 * vector.y,
+                     m01 * vector.x + m11 * vector.y};
+}
+
+affine2d affine2d::operator*(const affine2d& other) const noexcept
+{
+    return affine2d{
+        m00 * other.m00 + m10 * other.m01,
+        m01 * other.m00 + m11 * other.m01,
+        m00 * other.m10 + m10 * other.m11,
+        m01 * other.m10 + m11 * other.m11,
+        m00 * other.tx + m10 * other.ty + tx,
+        m01 * other.tx + m11 * other.ty + ty
+    };
+}
+
+void interpolate(const affine2d* from,
+                 const affine2d* to,
+                 affine2d* interpolated,
+                 std::size_t count,
+                 float alpha) noexcept
+{
+    assert((from && to && interpolated) || count == 0);
+
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        // Most nodes don't move between two ticks, they don't need to be decomposed
+        if(std::memcmp(&from[i], &to[i], sizeof(affine2d)) == 0)
+        {
+            interpolated[i] = to[i];
+            continue;
+        }
+
+        const affine_components start = decompose(from[i]);
+        const affine_components end = decompose(to[i]);
+
+        // Wrap the rotation delta in [-pi, pi] so we never turn the long way around
+        const float rotation_delta = std::remainder(end.rotation - start.rotation, glm::two_pi<float>());
+
+        affine_components components;
+        components.translation = start.translation + (end.translation - start.translation) * alpha;
+        components.rotation = start.rotation + rotation_delta * alpha;
+        components.scale_x = start.scale_x + (end.scale_x - start.scale_x) * alpha;
+        components.scale_y = start.scale_y + (end.scale_y - start.scale_y) * alpha;
+        components.shear = start.shear + (end.shear - start.shear) * alpha;
+
+        interpolated[i] = compose(components);
+    }
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,231 @@
+#include "mapped_file.hpp"
+
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace ng
+{
+
+namespace
+{
+
+#ifdef _WIN32
+
+[[noreturn]] void throw_last_error(const char* what)
+{
+    throw std::system_error{static_cast<int>(GetLastError()), std::system_category(), what};
+}
+
+#else
+
+[[noreturn]] void throw_last_error(const char* what)
+{
+    throw std::system_error{errno, std::generic_category(), what};
+}
+
+/**
+ * Close a file descriptor when leaving a scope, the mapping stays valid once the file is closed
+ */
+struct file_descriptor_guard
+{
+    int descriptor;
+
+    ~file_descriptor_guard()
+    {
+        close(descriptor);
+    }
+};
+
+#endif
+
+}
+
+#ifdef _WIN32
+
+mapped_file::mapped_file(const std::filesystem::path& path)
+: data_{nullptr}
+, size_{0}
+, file_handle_{INVALID_HANDLE_VALUE}
+, mapping_handle_{nullptr}
+{
+    file_handle_ = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file_handle_ == INVALID_HANDLE_VALUE)
+    {
+        throw_last_error("failed to open the mapped file");
+    }
+
+    LARGE_INTEGER file_size;
+    if(!GetFileSizeEx(file_handle_, &file_size))
+    {
+        unmap();
+        throw_last_error("failed to read the size of the mapped file");
+    }
+
+    size_ = static_cast<std::size_t>(file_size.QuadPart);
+
+    // Empty files can't be mapped
+    if(size_ == 0)
+    {
+        return;
+    }
+
+    mapping_handle_ = CreateFileMappingW(file_handle_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(!mapping_handle_)
+    {
+        unmap();
+        throw_last_error("failed to map the file");
+    }
+
+    data_ = MapViewOfFile(mapping_handle_, FILE_MAP_READ, 0, 0, 0);
+    if(!data_)
+    {
+        unmap();
+        throw_last_error("failed to map the file");
+    }
+}
+
+void mapped_file::unmap() noexcept
+{
+    if(data_)
+    {
+        UnmapViewOfFile(data_);
+    }
+
+    if(mapping_handle_)
+    {
+        CloseHandle(mapping_handle_);
+    }
+
+    if(file_handle_ != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(file_handle_);
+    }
+
+    data_ = nullptr;
+    size_ = 0;
+    mapping_handle_ = nullptr;
+    file_handle_ = INVALID_HANDLE_VALUE;
+}
+
+mapped_file::mapped_file(mapped_file&& other) noexcept
+: data_{std::exchange(other.data_, nullptr)}
+, size_{std::exchange(other.size_, 0)}
+, file_handle_{std::exchange(other.file_handle_, INVALID_HANDLE_VALUE)}
+, mapping_handle_{std::exchange(other.mapping_handle_, nullptr)}
+{
+
+}
+
+mapped_file& mapped_file::operator=(mapped_file&& other) noexcept
+{
+    if(this != &other)
+    {
+        unmap();
+
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        file_handle_ = std::exchange(other.file_handle_, INVALID_HANDLE_VALUE);
+        mapping_handle_ = std::exchange(other.mapping_handle_, nullptr);
+    }
+
+    return *this;
+}
+
+#else
+
+mapped_file::mapped_file(const std::filesystem::path& path)
+: data_{nullptr}
+, size_{0}
+{
+    const int descriptor = open(path.c_str(), O_RDONLY);
+    if(descriptor < 0)
+    {
+        throw_last_error("failed to open the mapped file");
+    }
+
+    file_descriptor_guard guard{descriptor};
+
+    struct stat file_status;
+    if(fstat(descriptor, &file_status) != 0)
+    {
+        throw_last_error("failed to read the size of the mapped file");
+    }
+
+    // Empty files can't be mapped
+    if(file_status.st_size == 0)
+    {
+        return;
+    }
+
+    void* data = mmap(nullptr, static_cast<std::size_t>(file_status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if(data == MAP_FAILED)
+    {
+        throw_last_error("failed to map the file");
+    }
+
+    data_ = data;
+    size_ = static_cast<std::size_t>(file_status.st_size);
+}
+
+void mapped_file::unmap() noexcept
+{
+    if(data_)
+    {
+        munmap(const_cast<void*>(data_), size_);
+    }
+
+    data_ = nullptr;
+    size_ = 0;
+}
+
+mapped_file::mapped_file(mapped_file&& other) noexcept
+: data_{std::exchange(other.data_, nullptr)}
+, size_{std::exchange(other.size_, 0)}
+{
+
+}
+
+mapped_file& mapped_file::operator=(mapped_file&& other) noexcept
+{
+    if(this != &other)
+    {
+        unmap();
+
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+
+    return *this;
+}
+
+#endif
+
+mapped_file::~mapped_file()
+{
+    unmap();
+}
+
+const void* mapped_file::data() const noexcept
+{
+    return data_;
+}
+
+std::size_t mapped_file::size() const noexcept
+{
+    return size_;
+}
+
+}
\ No newline at end of file
@@ -88,6 +88,11 @@ std::string name::string() const noexcept
     return entry_ ? entry_->string() : std::string{};
 }
 
+uint64_t name::hash() const noexcept
+{
+    return entry_ ? entry_->hash() : 0;
+}
+
 bool name::operator==(const name& other) const noexcept
 {
     return entry_ == other.entry_;
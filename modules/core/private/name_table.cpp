@@ -3,13 +3,14 @@
 #include <cassert>
 #include <algorithm>
 #include <numeric>
+#include <mutex>
 
 namespace ng
 {
 
 name_table_entry::name_table_entry(std::string_view str, uint64_t hash, name_table_entry* next, std::size_t table_index)
 : next_{next}
-, prev_{next_ ? next_->prev_ : nullptr}
+, prev_{nullptr}
 , string_{str}
 , hash_{hash}
 , refcount_{1}
@@ -26,14 +27,26 @@ name_table_entry::~name_table_entry()
 
 void name_table_entry::addref()
 {
-    ++refcount_;
+    refcount_.fetch_add(1, std::memory_order_relaxed);
 }
 
 bool name_table_entry::release()
 {
-    --refcount_;
+    return refcount_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+}
+
+bool name_table_entry::release_shared() noexcept
+{
+    uint64_t refcount = refcount_.load(std::memory_order_relaxed);
+    while(refcount > 1)
+    {
+        if(refcount_.compare_exchange_weak(refcount, refcount - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+        {
+            return true;
+        }
+    }
 
-    return refcount_ == 0;
+    return false;
 }
 
 const char* name_table_entry::c_str() const noexcept
@@ -46,6 +59,11 @@ std::string name_table_entry::string() const noexcept
     return string_;
 }
 
+uint64_t name_table_entry::hash() const noexcept
+{
+    return hash_;
+}
+
 name_table::name_table()
 : entries_{nullptr}
 , mutex_{}
@@ -92,6 +110,10 @@ name_table_entry* name_table::find_or_add(std::string_view str)
 
     // Create a new entry
     name_table_entry* new_entry = new name_table_entry{str, str_hash, entries_[table_index], table_index};
+    if(new_entry->next_)
+    {
+        new_entry->next_->prev_ = new_entry;
+    }
     entries_[table_index] = new_entry;
 
     return new_entry;
@@ -119,9 +141,16 @@ name_table_entry* name_table::find(std::string_view str) const
 
 void name_table::release(name_table_entry* entry)
 {
+    // Moved names and the names still referenced elsewhere don't need the table. The last reference is only
+    // released with the table locked, so a name can't be found while its entry is freed
+    if(!entry || entry->release_shared())
+    {
+        return;
+    }
+
     std::unique_lock lock(mutex_);
 
-    if(entry && entry->release())
+    if(entry->release())
     {
         // Remove entry from table
 
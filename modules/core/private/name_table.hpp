@@ -1,6 +1,7 @@
 #ifndef NGINE_NAME_TABLE_HPP
 #define NGINE_NAME_TABLE_HPP
 
+#include <atomic>
 #include <cstdint>
 #include <cstddef>
 #include <string>
@@ -21,7 +22,9 @@ class name_table_entry
     name_table_entry* prev_;
     std::string string_;
     uint64_t hash_;
-    uint64_t refcount_;
+
+    // Names are copied without locking the table, from any thread
+    std::atomic<uint64_t> refcount_;
     std::size_t table_index_;
 
 public:
@@ -40,6 +43,13 @@ public:
      */
     [[nodiscard]] bool release();
 
+    /**
+     * Decrease refcount if another reference is left
+     * @return true when the refcount was decreased or false when this is the last reference
+     * @note Never frees the entry, so it doesn't require locking the table
+     */
+    [[nodiscard]] bool release_shared() noexcept;
+
     /**
      * Returns the c string
      * @return The c string associated with entry
@@ -51,6 +61,12 @@ public:
      * @return The string representation
      */
     [[nodiscard]] std::string string() const noexcept;
+
+    /**
+     * Returns the hash of the string
+     * @return The hash of the string
+     */
+    [[nodiscard]] uint64_t hash() const noexcept;
 };
 
 /**
@@ -0,0 +1,137 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace ng
+{
+
+thread_pool::thread_pool(std::size_t worker_count)
+: workers_()
+, mutex_()
+, job_available_()
+, job_done_()
+, job_{}
+, generation_{0}
+, busy_workers_{0}
+, stopping_{false}
+, next_chunk_{0}
+, remaining_chunks_{0}
+{
+    workers_.reserve(worker_count);
+
+    for(std::size_t i = 0; i < worker_count; ++i)
+    {
+        workers_.emplace_back(&thread_pool::work, this);
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    {
+        std::lock_guard lock{mutex_};
+        stopping_ = true;
+    }
+
+    job_available_.notify_all();
+
+    for(std::thread& worker : workers_)
+    {
+        worker.join();
+    }
+}
+
+std::size_t thread_pool::default_worker_count() noexcept
+{
+    const std::size_t hardware_threads = std::thread::hardware_concurrency();
+
+    return hardware_threads > 1 ? hardware_threads - 1 : 0;
+}
+
+std::size_t thread_pool::worker_count() const noexcept
+{
+    return workers_.size();
+}
+
+void thread_pool::work()
+{
+    uint64_t last_generation = 0;
+
+    std::unique_lock lock{mutex_};
+    while(true)
+    {
+        job_available_.wait(lock, [this, last_generation]() { return stopping_ || generation_ != last_generation; });
+
+        if(stopping_)
+        {
+            return;
+        }
+
+        last_generation = generation_;
+        const job current_job = job_;
+        ++busy_workers_;
+
+        lock.unlock();
+        run_chunks(current_job);
+        lock.lock();
+
+        if(--busy_workers_ == 0)
+        {
+            job_done_.notify_all();
+        }
+    }
+}
+
+void thread_pool::run_chunks(const job& current_job) noexcept
+{
+    for(std::size_t chunk = next_chunk_.fetch_add(1, std::memory_order_relaxed);
+        chunk < current_job.chunk_count;
+        chunk = next_chunk_.fetch_add(1, std::memory_order_relaxed))
+    {
+        const std::size_t begin = chunk * current_job.grain;
+        const std::size_t end = std::min(begin + current_job.grain, current_job.count);
+
+        current_job.run(current_job.context, begin, end);
+
+        remaining_chunks_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+void thread_pool::run(const job& new_job)
+{
+    if(new_job.chunk_count == 0)
+    {
+        return;
+    }
+
+    // Not worth waking the workers
+    if(workers_.empty() || new_job.chunk_count == 1)
+    {
+        new_job.run(new_job.context, 0, new_job.count);
+        return;
+    }
+
+    {
+        std::unique_lock lock{mutex_};
+
+        // A worker that woke up late for the previous job could still be looking for chunks
+        job_done_.wait(lock, [this]() { return busy_workers_ == 0; });
+
+        job_ = new_job;
+        next_chunk_.store(0, std::memory_order_relaxed);
+        remaining_chunks_.store(new_job.chunk_count, std::memory_order_relaxed);
+        ++generation_;
+    }
+
+    job_available_.notify_all();
+
+    run_chunks(new_job);
+
+    std::unique_lock lock{mutex_};
+    job_done_.wait(lock, [this]()
+    {
+        return remaining_chunks_.load(std::memory_order_acquire) == 0 && busy_workers_ == 0;
+    });
+}
+
+}
\ No newline at end of file
@@ -1,10 +1,223 @@
 #include "transform2d.hpp"
+#include "affine2d.hpp"
+#include "memory_pool.hpp"
 #include <glm/gtx/matrix_transform_2d.hpp>
 #include <glm/gtc/epsilon.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#if defined(__AVX2__)
+#define NG_TRANSFORM2D_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NG_TRANSFORM2D_SSE2 1
+#include <emmintrin.h>
+#endif
 
 namespace ng
 {
 
+namespace
+{
+
+affine2d make_affine_coefficients(const glm::mat3& matrix, float translation_weight) noexcept
+{
+    return affine2d{
+        matrix[0][0], matrix[0][1],
+        matrix[1][0], matrix[1][1],
+        matrix[2][0] * translation_weight, matrix[2][1] * translation_weight
+    };
+}
+
+inline void transform_interleaved_scalar(const affine2d& c, const float* in, float* out, std::size_t count) noexcept
+{
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        const float x = in[i * 2];
+        const float y = in[i * 2 + 1];
+
+        out[i * 2] = c.m00 * x + c.m10 * y + c.tx;
+        out[i * 2 + 1] = c.m11 * y + c.m01 * x + c.ty;
+    }
+}
+
+inline void transform_planar_scalar(const affine2d& c,
+                                    const float* xs, const float* ys,
+                                    float* out_xs, float* out_ys,
+                                    std::size_t count) noexcept
+{
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        const float x = xs[i];
+        const float y = ys[i];
+
+        out_xs[i] = c.m00 * x + c.m10 * y + c.tx;
+        out_ys[i] = c.m01 * x + c.m11 * y + c.ty;
+    }
+}
+
+#if defined(NG_TRANSFORM2D_AVX2) || defined(NG_TRANSFORM2D_SSE2)
+/**
+ * Returns how many elements must be processed before an address is aligned on a simd register
+ */
+inline std::size_t elements_until_aligned(const void* address, std::size_t element_size, std::size_t alignment) noexcept
+{
+    const std::uintptr_t misalignment = reinterpret_cast<std::uintptr_t>(address) % alignment;
+
+    // Element boundaries can never reach the alignment, process everything as unaligned
+    if(misalignment % element_size != 0)
+    {
+        return 0;
+    }
+
+    return misalignment == 0 ? 0 : (alignment - misalignment) / element_size;
+}
+#endif
+
+#if defined(NG_TRANSFORM2D_AVX2)
+constexpr std::size_t register_alignment = 32;
+
+// [x0 y0 x1 y1 ...] -> [y0 x0 y1 x1 ...]
+constexpr int swap_pairs = _MM_SHUFFLE(2, 3, 0, 1);
+
+void transform_interleaved(const affine2d& c, const float* in, float* out, std::size_t count) noexcept
+{
+    // Peel points until the output is aligned so the main loop can use aligned stores
+    const std::size_t head = std::min(count, elements_until_aligned(out, sizeof(float) * 2, register_alignment));
+    transform_interleaved_scalar(c, in, out, head);
+
+    const __m256 diagonal = _mm256_setr_ps(c.m00, c.m11, c.m00, c.m11, c.m00, c.m11, c.m00, c.m11);
+    const __m256 cross = _mm256_setr_ps(c.m10, c.m01, c.m10, c.m01, c.m10, c.m01, c.m10, c.m01);
+    const __m256 translation = _mm256_setr_ps(c.tx, c.ty, c.tx, c.ty, c.tx, c.ty, c.tx, c.ty);
+    const bool aligned_output = is_address_aligned(out + head * 2, register_alignment);
+
+    std::size_t i = head;
+    for(; i + 4 <= count; i += 4)
+    {
+        const __m256 points = _mm256_loadu_ps(in + i * 2);
+        const __m256 swapped = _mm256_permute_ps(points, swap_pairs);
+        const __m256 result = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(points, diagonal),
+                                                          _mm256_mul_ps(swapped, cross)),
+                                            translation);
+
+        if(aligned_output)
+        {
+            _mm256_store_ps(out + i * 2, result);
+        }
+        else
+        {
+            _mm256_storeu_ps(out + i * 2, result);
+        }
+    }
+
+    transform_interleaved_scalar(c, in + i * 2, out + i * 2, count - i);
+}
+
+void transform_planar(const affine2d& c,
+                      const float* xs, const float* ys,
+                      float* out_xs, float* out_ys,
+                      std::size_t count) noexcept
+{
+    const __m256 m00 = _mm256_set1_ps(c.m00);
+    const __m256 m01 = _mm256_set1_ps(c.m01);
+    const __m256 m10 = _mm256_set1_ps(c.m10);
+    const __m256 m11 = _mm256_set1_ps(c.m11);
+    const __m256 tx = _mm256_set1_ps(c.tx);
+    const __m256 ty = _mm256_set1_ps(c.ty);
+
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        const __m256 x = _mm256_loadu_ps(xs + i);
+        const __m256 y = _mm256_loadu_ps(ys + i);
+
+        _mm256_storeu_ps(out_xs + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m00, x), _mm256_mul_ps(m10, y)), tx));
+        _mm256_storeu_ps(out_ys + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m01, x), _mm256_mul_ps(m11, y)), ty));
+    }
+
+    transform_planar_scalar(c, xs + i, ys + i, out_xs + i, out_ys + i, count - i);
+}
+#elif defined(NG_TRANSFORM2D_SSE2)
+constexpr std::size_t register_alignment = 16;
+
+// [x0 y0 x1 y1] -> [y0 x0 y1 x1]
+constexpr int swap_pairs = _MM_SHUFFLE(2, 3, 0, 1);
+
+void transform_interleaved(const affine2d& c, const float* in, float* out, std::size_t count) noexcept
+{
+    // Peel points until the output is aligned so the main loop can use aligned stores
+    const std::size_t head = std::min(count, elements_until_aligned(out, sizeof(float) * 2, register_alignment));
+    transform_interleaved_scalar(c, in, out, head);
+
+    const __m128 diagonal = _mm_setr_ps(c.m00, c.m11, c.m00, c.m11);
+    const __m128 cross = _mm_setr_ps(c.m10, c.m01, c.m10, c.m01);
+    const __m128 translation = _mm_setr_ps(c.tx, c.ty, c.tx, c.ty);
+    const bool aligned_output = is_address_aligned(out + head * 2, register_alignment);
+
+    std::size_t i = head;
+    for(; i + 2 <= count; i += 2)
+    {
+        const __m128 points = _mm_loadu_ps(in + i * 2);
+        const __m128 swapped = _mm_shuffle_ps(points, points, swap_pairs);
+        const __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(points, diagonal),
+                                                    _mm_mul_ps(swapped, cross)),
+                                         translation);
+
+        if(aligned_output)
+        {
+            _mm_store_ps(out + i * 2, result);
+        }
+        else
+        {
+            _mm_storeu_ps(out + i * 2, result);
+        }
+    }
+
+    transform_interleaved_scalar(c, in + i * 2, out + i * 2, count - i);
+}
+
+void transform_planar(const affine2d& c,
+                      const float* xs, const float* ys,
+                      float* out_xs, float* out_ys,
+                      std::size_t count) noexcept
+{
+    const __m128 m00 = _mm_set1_ps(c.m00);
+    const __m128 m01 = _mm_set1_ps(c.m01);
+    const __m128 m10 = _mm_set1_ps(c.m10);
+    const __m128 m11 = _mm_set1_ps(c.m11);
+    const __m128 tx = _mm_set1_ps(c.tx);
+    const __m128 ty = _mm_set1_ps(c.ty);
+
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4)
+    {
+        const __m128 x = _mm_loadu_ps(xs + i);
+        const __m128 y = _mm_loadu_ps(ys + i);
+
+        _mm_storeu_ps(out_xs + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m10, y)), tx));
+        _mm_storeu_ps(out_ys + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m01, x), _mm_mul_ps(m11, y)), ty));
+    }
+
+    transform_planar_scalar(c, xs + i, ys + i, out_xs + i, out_ys + i, count - i);
+}
+#else
+void transform_interleaved(const affine2d& c, const float* in, float* out, std::size_t count) noexcept
+{
+    transform_interleaved_scalar(c, in, out, count);
+}
+
+void transform_planar(const affine2d& c,
+                      const float* xs, const float* ys,
+                      float* out_xs, float* out_ys,
+                      std::size_t count) noexcept
+{
+    transform_planar_scalar(c, xs, ys, out_xs, out_ys, count);
+}
+#endif
+
+}
+
 transform2d::transform2d() noexcept
 : translation()
 , rotation{0.f}
@@ -52,6 +265,15 @@ transform2d transform2d::inverse() const noexcept
     return transform2d{inverse_matrix};
 }
 
+glm::mat3x3 transform2d::inverse_matrix() const noexcept
+{
+    // (T * S * R)^-1 = R^-1 * S^-1 * T^-1
+    const glm::mat3 inverse_rotation = glm::rotate(glm::mat3{1.f}, -rotation);
+    const glm::mat3 inverse_scale_rotation = glm::scale(inverse_rotation, glm::vec2{1.f / scale.x, 1.f / scale.y});
+
+    return glm::translate(inverse_scale_rotation, -translation);
+}
+
 glm::mat3x3 transform2d::rotation_matrix() const noexcept
 {
     return glm::rotate(glm::mat3{1.f}, rotation);
@@ -82,6 +304,44 @@ glm::vec2 transform2d::transform_vector(const glm::vec2& vector) const noexcept
     return matrix() * glm::vec3{vector.x, vector.y, 0.0f};
 }
 
+void transform2d::transform_points(const glm::vec2* points, glm::vec2* transformed_points, std::size_t count) const noexcept
+{
+    assert(points || count == 0);
+    assert(transformed_points || count == 0);
+
+    const affine2d coefficients = make_affine_coefficients(matrix(), 1.f);
+
+    transform_interleaved(coefficients,
+                          reinterpret_cast<const float*>(points),
+                          reinterpret_cast<float*>(transformed_points),
+                          count);
+}
+
+void transform2d::transform_points(const float* xs, const float* ys,
+                                   float* transformed_xs, float* transformed_ys,
+                                   std::size_t count) const noexcept
+{
+    assert((xs && ys && transformed_xs && transformed_ys) || count == 0);
+
+    const affine2d coefficients = make_affine_coefficients(matrix(), 1.f);
+
+    transform_planar(coefficients, xs, ys, transformed_xs, transformed_ys, count);
+}
+
+void transform2d::transform_vectors(const glm::vec2* vectors, glm::vec2* transformed_vectors, std::size_t count) const noexcept
+{
+    assert(vectors || count == 0);
+    assert(transformed_vectors || count == 0);
+
+    // Vectors are not affected by the translation
+    const affine2d coefficients = make_affine_coefficients(matrix(), 0.f);
+
+    transform_interleaved(coefficients,
+                          reinterpret_cast<const float*>(vectors),
+                          reinterpret_cast<float*>(transformed_vectors),
+                          count);
+}
+
 glm::vec2 transform2d::right() const noexcept
 {
     return rotation_matrix() * glm::vec3{1.f, 0.f, 0.f};
@@ -148,4 +408,78 @@ std::ostream& operator<<(std::ostream& out, const transform2d& transform)
                << " S=(" << transform.scale.x << ", " << transform.scale.y << ')' << std::endl;
 }
 
+void transform_points(const transform2d* transforms,
+                      const glm::vec2* points,
+                      glm::vec2* transformed_points,
+                      std::size_t count) noexcept
+{
+    assert((transforms && points && transformed_points) || count == 0);
+
+    // Matrices are expanded by blocks into planar coefficients so the multiply loop is branchless and can be
+    // vectorized by the compiler, most of the cost remains the sine and cosine of each rotation
+    constexpr std::size_t block_size = 64;
+
+    float m00[block_size];
+    float m01[block_size];
+    float m10[block_size];
+    float m11[block_size];
+
+    for(std::size_t block_begin = 0; block_begin < count; block_begin += block_size)
+    {
+        const std::size_t block_count = std::min(block_size, count - block_begin);
+
+        // Same as translation_matrix() * scale_matrix() * rotation_matrix() without building the matrices
+        for(std::size_t i = 0; i < block_count; ++i)
+        {
+            const transform2d& transform = transforms[block_begin + i];
+            const float cos_rotation = std::cos(transform.rotation);
+            const float sin_rotation = std::sin(transform.rotation);
+
+            m00[i] = transform.scale.x * cos_rotation;
+            m01[i] = transform.scale.y * sin_rotation;
+            m10[i] = -transform.scale.x * sin_rotation;
+            m11[i] = transform.scale.y * cos_rotation;
+        }
+
+        const glm::vec2* block_points = points + block_begin;
+        glm::vec2* block_transformed_points = transformed_points + block_begin;
+        const transform2d* block_transforms = transforms + block_begin;
+
+        for(std::size_t i = 0; i < block_count; ++i)
+        {
+            const float x = block_points[i].x;
+            const float y = block_points[i].y;
+
+            block_transformed_points[i] = glm::vec2{
+                m00[i] * x + m10[i] * y + block_transforms[i].translation.x,
+                m01[i] * x + m11[i] * y + block_transforms[i].translation.y
+            };
+        }
+    }
+}
+
+transform2d interpolate(const transform2d& from, const transform2d& to, float alpha) noexcept
+{
+    // Wrap the rotation delta in [-pi, pi] so we never turn the long way around
+    const float rotation_delta = std::remainder(to.rotation - from.rotation, glm::two_pi<float>());
+
+    return transform2d{from.translation + (to.translation - from.translation) * alpha,
+                       from.rotation + rotation_delta * alpha,
+                       from.scale + (to.scale - from.scale) * alpha};
+}
+
+void interpolate(const transform2d* from,
+                 const transform2d* to,
+                 transform2d* interpolated,
+                 std::size_t count,
+                 float alpha) noexcept
+{
+    assert((from && to && interpolated) || count == 0);
+
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        interpolated[i] = interpolate(from[i], to[i], alpha);
+    }
+}
+
 }
\ No newline at end of file
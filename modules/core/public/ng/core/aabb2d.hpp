@@ -0,0 +1,113 @@
+#ifndef NGINE_CORE_AABB2D_HPP
+#define NGINE_CORE_AABB2D_HPP
+
+#include <glm/glm.hpp>
+
+namespace ng
+{
+
+struct affine2d;
+
+/**
+ * Represents a 2d axis aligned bounding box
+ * @note A box whose min is greater than its max on an axis is empty
+ */
+struct aabb2d
+{
+    glm::vec2 min;
+    glm::vec2 max;
+
+    /**
+     * Construct an empty box
+     */
+    constexpr aabb2d() noexcept
+    : min{1.f, 1.f}
+    , max{0.f, 0.f}
+    {
+
+    }
+
+    /**
+     * Construct a box from its corners
+     * @param min The corner with the smallest coordinates
+     * @param max The corner with the largest coordinates
+     */
+    constexpr aabb2d(const glm::vec2& min, const glm::vec2& max) noexcept
+    : min{min}
+    , max{max}
+    {
+
+    }
+
+    /**
+     * Build a box from its center
+     * @param center The center of the box
+     * @param half_extents Half of the size of the box on each axis
+     * @return The box
+     */
+    [[nodiscard]] static aabb2d from_center(const glm::vec2& center, const glm::vec2& half_extents) noexcept;
+
+    /**
+     * Check if this box is empty
+     * @return true when this box contains no point
+     */
+    [[nodiscard]] bool empty() const noexcept;
+
+    /**
+     * Returns the center of this box
+     * @return The center of this box
+     */
+    [[nodiscard]] glm::vec2 center() const noexcept;
+
+    /**
+     * Returns the size of this box
+     * @return The size of this box on each axis
+     */
+    [[nodiscard]] glm::vec2 size() const noexcept;
+
+    /**
+     * Check if a point is inside this box
+     * @param point The point to check
+     * @return true when the point is inside this box or on its edges
+     */
+    [[nodiscard]] bool contains(const glm::vec2& point) const noexcept;
+
+    /**
+     * Check if another box is completely inside this box
+     * @param other The other box
+     * @return true when other is inside this box
+     */
+    [[nodiscard]] bool contains(const aabb2d& other) const noexcept;
+
+    /**
+     * Check if this box overlaps another box
+     * @param other The other box
+     * @return true when the boxes share at least a point
+     */
+    [[nodiscard]] bool intersects(const aabb2d& other) const noexcept;
+
+    /**
+     * Returns the squared distance between a point and this box
+     * @param point The point
+     * @return The squared distance to the closest point of this box, 0 when the point is inside
+     */
+    [[nodiscard]] float distance_squared(const glm::vec2& point) const noexcept;
+
+    /**
+     * Returns the smallest box containing this box and another box
+     * @param other The other box
+     * @return The merged box
+     */
+    [[nodiscard]] aabb2d merge(const aabb2d& other) const noexcept;
+
+    /**
+     * Returns the bounds of this box once transformed
+     * @param transform The transform to apply to the box
+     * @return The smallest axis aligned box containing the transformed box
+     */
+    [[nodiscard]] aabb2d transform(const affine2d& transform) const noexcept;
+};
+
+}
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef NGINE_CORE_AFFINE2D_HPP
+#define NGINE_CORE_AFFINE2D_HPP
+
+#include <glm/glm.hpp>
+#include <cstddef>
+
+namespace ng
+{
+
+struct transform2d;
+
+/**
+ * Represents a 2d affine transform as the six meaningful coefficients of a 3x3 matrix
+ * Coefficients are stored column by column like glm:
+ *   x' = m00 * x + m10 * y + tx
+ *   y' = m01 * x + m11 * y + ty
+ * @note Unlike transform2d, combining affine transforms doesn't require any decomposition
+ */
+struct affine2d
+{
+    float m00, m01;
+    float m10, m11;
+    float tx, ty;
+
+    /**
+     * Construct an identity transform
+     */
+    constexpr affine2d() noexcept
+    : m00{1.f}, m01{0.f}
+    , m10{0.f}, m11{1.f}
+    , tx{0.f}, ty{0.f}
+    {
+
+    }
+
+    /**
+     * Construct an affine transform from its coefficients
+     */
+    constexpr affine2d(float m00, float m01, float m10, float m11, float tx, float ty) noexcept
+    : m00{m00}, m01{m01}
+    , m10{m10}, m11{m11}
+    , tx{tx}, ty{ty}
+    {
+
+    }
+
+    /**
+     * Build the affine transform of a transform
+     * @param transform The transform to convert
+     */
+    explicit affine2d(const transform2d& transform) noexcept;
+
+    /**
+     * Extract the affine part of a matrix
+     * @param matrix The matrix to convert
+     */
+    explicit affine2d(const glm::mat3& matrix) noexcept;
+
+    /**
+     * Returns the matrix representation of this affine transform
+     * @return The matrix representation of this affine transform
+     */
+    [[nodiscard]] glm::mat3 matrix() const noexcept;
+
+    /**
+     * Returns the inverse transform
+     * @return The inverse transform
+     */
+    [[nodiscard]] affine2d inverse() const noexcept;
+
+    /**
+     * Transform a point with this transform
+     * @param point The point to transform
+     * @return The transformed point
+     */
+    [[nodiscard]] glm::vec2 transform_point(const glm::vec2& point) const noexcept;
+
+    /**
+     * Transform a vector with this transform
+     * @param vector The vector to transform
+     * @return The transformed vector
+     */
+    [[nodiscard]] glm::vec2 transform_vector(const glm::vec2& vector) const noexcept;
+
+    /**
+     * Combine this transform with another transform, other is applied first
+     * @param other The other transform
+     * @return The combined transform
+     */
+    [[nodiscard]] affine2d operator*(const affine2d& other) const noexcept;
+};
+
+/**
+ * Interpolate between two ranges of affine transforms
+ * Each transform is decomposed in a translation, a rotation, a scale and a shear, the rotation is interpolated on
+ * the shortest arc and the other components linearly, so a spinning node keeps its size
+ * @param from The transforms when alpha is 0
+ * @param to The transforms when alpha is 1
+ * @param interpolated Where the interpolated transforms are written
+ * @param count The number of transforms to interpolate
+ * @param alpha How far the results are between from and to
+ */
+void interpolate(const affine2d* from,
+                 const affine2d* to,
+                 affine2d* interpolated,
+                 std::size_t count,
+                 float alpha) noexcept;
+
+}
+
+#endif
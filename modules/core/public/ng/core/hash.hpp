@@ -10,23 +10,28 @@ namespace ng
 {
 
 /**
- * Hash a range of bytes
+ * The hash of an empty range, hashing starts from this value
+ */
+constexpr const uint64_t hash_offset_basis = 0xcbf29ce484222325;
+
+/**
+ * Extend a hash with a range of bytes
  * @tparam It The iterator on the range of byte
+ * @param seed The hash of the bytes before the range
  * @param begin The first iterator on the range
  * @param end The iterator after the last on the range
- * @return The hash value of the range
- * @note FNV-1a implementation
+ * @return The hash value of the bytes before the range followed by the range
+ * @note Hashing a range in multiple parts gives the same value as hashing it at once
  */
 template<typename It>
-[[nodiscard]] constexpr uint64_t hash(It begin, It end) noexcept
+[[nodiscard]] constexpr uint64_t hash(uint64_t seed, It begin, It end) noexcept
 {
     using iterator_value_type = typename std::iterator_traits<It>::value_type;
     static_assert(std::is_convertible_v<iterator_value_type, uint8_t>, "Iterator must be on bytes");
 
-    constexpr const uint64_t fnv_offset_basis = 0xcbf29ce484222325;
     constexpr const uint64_t fnv_prime = 0x00000100000001B3;
 
-    uint64_t h = fnv_offset_basis;
+    uint64_t h = seed;
 
     for (; begin != end; ++begin)
     {
@@ -37,6 +42,20 @@ template<typename It>
     return h;
 }
 
+/**
+ * Hash a range of bytes
+ * @tparam It The iterator on the range of byte
+ * @param begin The first iterator on the range
+ * @param end The iterator after the last on the range
+ * @return The hash value of the range
+ * @note FNV-1a implementation
+ */
+template<typename It>
+[[nodiscard]] constexpr uint64_t hash(It begin, It end) noexcept
+{
+    return hash(hash_offset_basis, begin, end);
+}
+
 /**
  * Hash a string
  * @param str The string to hash
@@ -47,6 +66,17 @@ template<typename It>
     return hash(str.begin(), str.end());
 }
 
+/**
+ * Extend a hash with a string
+ * @param seed The hash of the characters before the string
+ * @param str The string to hash
+ * @return The hash value of the characters before the string followed by the string
+ */
+[[nodiscard]] constexpr uint64_t hash(uint64_t seed, std::string_view str) noexcept
+{
+    return hash(seed, str.begin(), str.end());
+}
+
 /**
  * Hash a memory block
  * @param memory The memory block to hash
@@ -0,0 +1,57 @@
+#ifndef NGINE_CORE_MAPPED_FILE_HPP
+#define NGINE_CORE_MAPPED_FILE_HPP
+
+#include <filesystem>
+#include <cstddef>
+
+namespace ng
+{
+
+/**
+ * A file mapped in memory in read only mode
+ * The pages of the file are loaded by the system when they are first read, nothing is copied by the process
+ */
+class mapped_file
+{
+    const void* data_;
+    std::size_t size_;
+
+#ifdef _WIN32
+    void* file_handle_;
+    void* mapping_handle_;
+#endif
+
+    void unmap() noexcept;
+
+public:
+    /**
+     * Map a whole file
+     * @param path The path of the file
+     * @throw std::system_error When the file can't be opened or mapped
+     */
+    explicit mapped_file(const std::filesystem::path& path);
+
+    mapped_file(mapped_file&& other) noexcept;
+    mapped_file& operator=(mapped_file&& other) noexcept;
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    ~mapped_file();
+
+    /**
+     * Returns the content of the file
+     * @return The first byte of the file, aligned on a page, nullptr when the file is empty
+     */
+    [[nodiscard]] const void* data() const noexcept;
+
+    /**
+     * Returns the size of the file
+     * @return The size of the file in bytes
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+};
+
+}
+
+#endif
@@ -1,10 +1,12 @@
 #ifndef NGINE_CORE_MEMORY_POOL_HPP
 #define NGINE_CORE_MEMORY_POOL_HPP
 
+#include <cassert>
 #include <cstddef>
 #include <cstdint>
 #include <algorithm>
 #include <memory>
+#include <new>
 #include <vector>
 
 namespace ng
@@ -63,6 +65,16 @@ public:
     memory_pool_view(uint8_t* memory, std::size_t capacity) noexcept
     : free_{nullptr}
     , count_{0}
+    {
+        add_memory(memory, capacity);
+    }
+
+    /**
+     * Add a block of memory to the pool
+     * @param memory The memory to add, the pool doesn't own it
+     * @param capacity The size in bytes of the memory
+     */
+    void add_memory(uint8_t* memory, std::size_t capacity) noexcept
     {
         const std::size_t block_size = std::max(sizeof(object_cell), ObjectSize);
         const std::size_t block_alignment = std::max(alignof(object_cell), ObjectAlignment);
@@ -71,21 +83,26 @@ public:
         std::size_t aligned_capacity = capacity;
         aligned_memory_address = std::align(block_alignment, capacity, aligned_memory_address, aligned_capacity);
 
+        if(!aligned_memory_address)
+        {
+            return;
+        }
+
         uint8_t* aligned_memory = reinterpret_cast<uint8_t*>(aligned_memory_address);
 
-        // Now we initialize every blocks
-        object_cell* previous_cell = nullptr;
+        // Now we initialize every blocks, the first block ends up at the head of the free list
+        object_cell* previous_cell = free_;
         const std::size_t block_count = aligned_capacity / block_size;
-        for(std::size_t block_index = 0; block_index < block_count; ++block_index)
+        for(std::size_t block_index = block_count; block_index > 0; --block_index)
         {
             // TODO: Check if padding must be added if object alignment is bigger than the cell's
-            previous_cell = new(aligned_memory + block_index * block_size) object_cell{previous_cell};
+            previous_cell = new(aligned_memory + (block_index - 1) * block_size) object_cell{previous_cell};
 
             assert(is_address_aligned(previous_cell, alignof(object_cell)));
         }
 
         free_ = previous_cell;
-        count_ = block_count;
+        count_ += block_count;
     }
 
     ~memory_pool_view() noexcept
@@ -200,6 +217,118 @@ public:
 template<typename T>
 using type_memory_pool_view = memory_pool_view<sizeof(T), alignof(T)>;
 
+/**
+ * A pool of memory that owns its memory and grows when it is full
+ * Memory is allocated in chunks holding many elements, so elements allocated together are stored together
+ * @tparam ObjectSize The size of individual elements inside the pool
+ * @tparam ObjectAlignment The alignment individual elements inside the pool must have
+ */
+template<std::size_t ObjectSize, std::size_t ObjectAlignment>
+class memory_pool
+{
+    static constexpr std::size_t block_size = std::max(sizeof(void*), ObjectSize);
+    static constexpr std::size_t max_chunk_capacity = 64 * 1024;
+
+    // Declared before the view so it is destroyed after it, the view checks its free list when destroyed
+    std::vector<std::unique_ptr<uint8_t[]>> chunks_;
+    memory_pool_view<ObjectSize, ObjectAlignment> view_;
+    std::size_t next_chunk_capacity_;
+    std::size_t size_;
+
+    void add_chunk(std::size_t object_count)
+    {
+        // Extra space to align the first element
+        const std::size_t chunk_size = object_count * block_size + ObjectAlignment;
+
+        chunks_.push_back(std::make_unique<uint8_t[]>(chunk_size));
+        view_.add_memory(chunks_.back().get(), chunk_size);
+    }
+
+public:
+    memory_pool(const memory_pool&) = delete;
+    memory_pool& operator=(const memory_pool&) = delete;
+
+    /**
+     * Construct an empty pool
+     * @param first_chunk_capacity The number of elements of the first chunk, each chunk is twice bigger than the previous one
+     */
+    explicit memory_pool(std::size_t first_chunk_capacity = 64) noexcept
+    : chunks_{}
+    , view_{}
+    , next_chunk_capacity_{std::max<std::size_t>(first_chunk_capacity, 1)}
+    , size_{0}
+    {
+
+    }
+
+    /**
+     * Allocate a block of memory, growing the pool if needed
+     * @return The allocated memory
+     */
+    [[nodiscard]] void* allocate()
+    {
+        void* memory = view_.allocate(std::nothrow);
+        if(!memory)
+        {
+            add_chunk(next_chunk_capacity_);
+            next_chunk_capacity_ = std::min(next_chunk_capacity_ * 2, max_chunk_capacity);
+
+            memory = view_.allocate();
+        }
+
+        ++size_;
+
+        return memory;
+    }
+
+    /**
+     * Free a block of memory allocated by this pool
+     * @param memory The memory to free
+     */
+    void free(void* memory) noexcept
+    {
+        view_.free(memory);
+
+        --size_;
+    }
+
+    /**
+     * Make sure a number of elements can be allocated without growing the pool
+     * @param count The number of elements
+     */
+    void reserve(std::size_t count)
+    {
+        const std::size_t available = capacity() - size_;
+        if(available < count)
+        {
+            // Growing by at least the next chunk keeps the number of chunks small when reserving a few elements often
+            add_chunk(std::max(count - available, next_chunk_capacity_));
+            next_chunk_capacity_ = std::min(next_chunk_capacity_ * 2, max_chunk_capacity);
+        }
+    }
+
+    /**
+     * Returns the number of elements that can be stored without growing the pool
+     * @return The number of elements that can be stored
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept
+    {
+        return view_.capacity();
+    }
+
+    /**
+     * Returns the number of allocated elements
+     * @return The number of allocated elements
+     */
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return size_;
+    }
+};
+
+template<typename T>
+using type_memory_pool = memory_pool<sizeof(T), alignof(T)>;
+
 }
 
 #endif
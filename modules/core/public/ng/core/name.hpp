@@ -2,6 +2,9 @@
 #define NGINE_CORE_NAME_HPP
 
 #include <string_view>
+#include <string>
+#include <cstdint>
+#include <functional>
 
 namespace ng
 {
@@ -66,6 +69,13 @@ public:
      */
     [[nodiscard]] std::string string() const noexcept;
 
+    /**
+     * Returns the hash of the string associated with this name
+     * @return The hash of the string or 0 when the name is empty
+     * @note The hash is computed once when the string is added to the name table
+     */
+    [[nodiscard]] uint64_t hash() const noexcept;
+
     bool operator==(const name& other) const noexcept;
     bool operator!=(const name& other) const noexcept;
 };
@@ -87,4 +97,18 @@ using unsafe_name = name;
 
 }
 
+namespace std
+{
+
+template<>
+struct hash<ng::name>
+{
+    std::size_t operator()(const ng::name& name) const noexcept
+    {
+        return static_cast<std::size_t>(name.hash());
+    }
+};
+
+}
+
 #endif
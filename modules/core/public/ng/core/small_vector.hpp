@@ -0,0 +1,280 @@
+#ifndef NGINE_CORE_SMALL_VECTOR_HPP
+#define NGINE_CORE_SMALL_VECTOR_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+namespace ng
+{
+
+/**
+ * A vector storing its first elements inside itself, it only allocates once it grows past its inline capacity
+ * @tparam T The type of the elements, they are copied as bytes
+ * @tparam InlineCapacity The number of elements stored without allocating
+ */
+template<typename T, std::size_t InlineCapacity>
+class small_vector
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Elements of a small vector are copied as bytes");
+    static_assert(InlineCapacity > 0, "Expecting an inline capacity");
+
+    T* data_;
+    std::size_t size_;
+    std::size_t capacity_;
+    alignas(T) unsigned char inline_storage_[sizeof(T) * InlineCapacity];
+
+    [[nodiscard]] T* inline_data() noexcept
+    {
+        return reinterpret_cast<T*>(inline_storage_);
+    }
+
+    [[nodiscard]] bool uses_inline_storage() const noexcept
+    {
+        return data_ == reinterpret_cast<const T*>(inline_storage_);
+    }
+
+    void release_storage() noexcept
+    {
+        if(!uses_inline_storage())
+        {
+            delete[] reinterpret_cast<unsigned char*>(data_);
+        }
+    }
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    small_vector() noexcept
+    : data_{inline_data()}
+    , size_{0}
+    , capacity_{InlineCapacity}
+    {
+
+    }
+
+    small_vector(const small_vector& other)
+    : small_vector()
+    {
+        assign(other.data(), other.size());
+    }
+
+    small_vector(small_vector&& other) noexcept
+    : small_vector()
+    {
+        *this = std::move(other);
+    }
+
+    ~small_vector()
+    {
+        release_storage();
+    }
+
+    small_vector& operator=(const small_vector& other)
+    {
+        if(&other != this)
+        {
+            assign(other.data(), other.size());
+        }
+
+        return *this;
+    }
+
+    small_vector& operator=(small_vector&& other) noexcept
+    {
+        if(&other == this)
+        {
+            return *this;
+        }
+
+        if(other.uses_inline_storage())
+        {
+            // Inline elements can't be stolen, they always fit in this vector without allocating
+            std::memcpy(data_, other.data_, other.size_ * sizeof(T));
+            size_ = other.size_;
+        }
+        else
+        {
+            release_storage();
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            size_ = other.size_;
+
+            other.data_ = other.inline_data();
+            other.capacity_ = InlineCapacity;
+        }
+
+        other.size_ = 0;
+
+        return *this;
+    }
+
+    /**
+     * Replace the elements of this vector
+     * @param values The new elements
+     * @param count The number of new elements
+     */
+    void assign(const T* values, std::size_t count)
+    {
+        size_ = 0;
+        append(values, count);
+    }
+
+    /**
+     * Make sure a number of elements can be stored without allocating
+     * @param new_capacity The number of elements to store
+     */
+    void reserve(std::size_t new_capacity)
+    {
+        if(new_capacity <= capacity_)
+        {
+            return;
+        }
+
+        T* new_data = reinterpret_cast<T*>(new unsigned char[new_capacity * sizeof(T)]);
+        std::memcpy(new_data, data_, size_ * sizeof(T));
+
+        release_storage();
+        data_ = new_data;
+        capacity_ = new_capacity;
+    }
+
+    /**
+     * Add an element at the end of this vector
+     * @param value The element to add
+     */
+    void push_back(const T& value)
+    {
+        if(size_ == capacity_)
+        {
+            // The value could be an element of this vector
+            const T copy = value;
+            reserve(capacity_ * 2);
+            data_[size_++] = copy;
+        }
+        else
+        {
+            data_[size_++] = value;
+        }
+    }
+
+    /**
+     * Add a range of elements at the end of this vector
+     * @param values The elements to add, they can't be elements of this vector
+     * @param count The number of elements to add
+     */
+    void append(const T* values, std::size_t count)
+    {
+        if(size_ + count > capacity_)
+        {
+            reserve(std::max(size_ + count, capacity_ * 2));
+        }
+
+        if(count > 0)
+        {
+            std::memcpy(data_ + size_, values, count * sizeof(T));
+        }
+
+        size_ += count;
+    }
+
+    /**
+     * Remove the last element of this vector
+     */
+    void pop_back() noexcept
+    {
+        assert(size_ > 0);
+
+        --size_;
+    }
+
+    /**
+     * Remove every element, the memory is kept
+     */
+    void clear() noexcept
+    {
+        size_ = 0;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    [[nodiscard]] T* data() noexcept
+    {
+        return data_;
+    }
+
+    [[nodiscard]] const T* data() const noexcept
+    {
+        return data_;
+    }
+
+    [[nodiscard]] T& operator[](std::size_t index) noexcept
+    {
+        assert(index < size_);
+
+        return data_[index];
+    }
+
+    [[nodiscard]] const T& operator[](std::size_t index) const noexcept
+    {
+        assert(index < size_);
+
+        return data_[index];
+    }
+
+    [[nodiscard]] T& back() noexcept
+    {
+        assert(size_ > 0);
+
+        return data_[size_ - 1];
+    }
+
+    [[nodiscard]] const T& back() const noexcept
+    {
+        assert(size_ > 0);
+
+        return data_[size_ - 1];
+    }
+
+    [[nodiscard]] iterator begin() noexcept
+    {
+        return data_;
+    }
+
+    [[nodiscard]] iterator end() noexcept
+    {
+        return data_ + size_;
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept
+    {
+        return data_;
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept
+    {
+        return data_ + size_;
+    }
+};
+
+}
+
+#endif
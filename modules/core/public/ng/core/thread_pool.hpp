@@ -0,0 +1,106 @@
+#ifndef NGINE_CORE_THREAD_POOL_HPP
+#define NGINE_CORE_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ng
+{
+
+/**
+ * A fixed set of worker threads used to split loops across cores
+ * The thread calling parallel_for also processes a share of the loop, then waits for the workers to finish
+ * @note Only one loop runs at a time, parallel_for must not be called from inside a loop of the same pool
+ */
+class thread_pool
+{
+    struct job
+    {
+        void (*run)(void* context, std::size_t begin, std::size_t end);
+        void* context;
+        std::size_t count;
+        std::size_t grain;
+        std::size_t chunk_count;
+    };
+
+    std::vector<std::thread> workers_;
+
+    std::mutex mutex_;
+    std::condition_variable job_available_;
+    std::condition_variable job_done_;
+
+    job job_;
+
+    // Incremented every time a job is published so workers can tell a new job from the previous one
+    uint64_t generation_;
+
+    // Workers currently processing chunks of the job
+    std::size_t busy_workers_;
+
+    bool stopping_;
+
+    std::atomic<std::size_t> next_chunk_;
+    std::atomic<std::size_t> remaining_chunks_;
+
+    void work();
+    void run_chunks(const job& current_job) noexcept;
+    void run(const job& new_job);
+
+public:
+    /**
+     * Start the worker threads
+     * @param worker_count The number of worker threads, the calling thread is not counted
+     */
+    explicit thread_pool(std::size_t worker_count = default_worker_count());
+    ~thread_pool();
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    /**
+     * Returns a worker count that keeps every core busy, including the calling thread
+     * @return The number of hardware threads minus one
+     */
+    [[nodiscard]] static std::size_t default_worker_count() noexcept;
+
+    /**
+     * Returns the number of worker threads
+     * @return The number of worker threads
+     */
+    [[nodiscard]] std::size_t worker_count() const noexcept;
+
+    /**
+     * Call a function on ranges covering [0, count) from multiple threads and wait for all ranges to be processed
+     * @param count The number of items to process
+     * @param grain The number of items processed by a single call, the last range can be smaller
+     * @param function Called with the beginning and the end of each range, it must not throw
+     * @note Ranges are independent, which range a thread processes is not deterministic
+     */
+    template<typename Function>
+    void parallel_for(std::size_t count, std::size_t grain, Function&& function)
+    {
+        using function_type = std::remove_reference_t<Function>;
+
+        job new_job;
+        new_job.run = [](void* context, std::size_t begin, std::size_t end)
+        {
+            (*static_cast<function_type*>(context))(begin, end);
+        };
+        new_job.context = const_cast<void*>(static_cast<const void*>(&function));
+        new_job.count = count;
+        new_job.grain = grain > 0 ? grain : 1;
+        new_job.chunk_count = (count + new_job.grain - 1) / new_job.grain;
+
+        run(new_job);
+    }
+};
+
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <glm/glm.hpp>
 #include <glm/gtc/constants.hpp>
+#include <cstddef>
 #include <ostream>
 
 namespace ng
@@ -42,6 +43,13 @@ struct transform2d
      */
     [[nodiscard]] transform2d inverse() const noexcept;
 
+    /**
+     * Returns the matrix of the inverse transform
+     * @return The inverse of matrix()
+     * @note Cheaper than inverting matrix() because it is built from the inverse of each component
+     */
+    [[nodiscard]] glm::mat3x3 inverse_matrix() const noexcept;
+
     /**
      * Returns the rotation matrix of this transform
      * @return The rotation matrix
@@ -80,6 +88,35 @@ struct transform2d
      */
     [[nodiscard]] glm::vec2 transform_vector(const glm::vec2& vector) const noexcept;
 
+    /**
+     * Transform a range of points with this transform
+     * @param points The points to transform
+     * @param transformed_points Where the transformed points are written, can be the same range as points
+     * @param count The number of points to transform
+     * @note The matrix is only built once for the whole range
+     */
+    void transform_points(const glm::vec2* points, glm::vec2* transformed_points, std::size_t count) const noexcept;
+
+    /**
+     * Transform a range of points stored as separate x and y arrays with this transform
+     * @param xs The x coordinates of the points to transform
+     * @param ys The y coordinates of the points to transform
+     * @param transformed_xs Where the transformed x coordinates are written, can be the same array as xs
+     * @param transformed_ys Where the transformed y coordinates are written, can be the same array as ys
+     * @param count The number of points to transform
+     */
+    void transform_points(const float* xs, const float* ys,
+                          float* transformed_xs, float* transformed_ys,
+                          std::size_t count) const noexcept;
+
+    /**
+     * Transform a range of vectors with this transform
+     * @param vectors The vectors to transform
+     * @param transformed_vectors Where the transformed vectors are written, can be the same range as vectors
+     * @param count The number of vectors to transform
+     */
+    void transform_vectors(const glm::vec2* vectors, glm::vec2* transformed_vectors, std::size_t count) const noexcept;
+
     /**
      * Returns the right vector from this transform
      * @return The right vector
@@ -127,6 +164,42 @@ struct transform2d
 
 std::ostream& operator<<(std::ostream& out, const transform2d& transform);
 
+/**
+ * Transform each point by its own transform
+ * @param transforms The transforms to apply, one per point
+ * @param points The points to transform
+ * @param transformed_points Where the transformed points are written, can be the same range as points
+ * @param count The number of transforms and points
+ */
+void transform_points(const transform2d* transforms,
+                      const glm::vec2* points,
+                      glm::vec2* transformed_points,
+                      std::size_t count) noexcept;
+
+/**
+ * Interpolate between two transforms
+ * @param from The transform when alpha is 0
+ * @param to The transform when alpha is 1
+ * @param alpha How far the result is between from and to
+ * @return The interpolated transform
+ * @note The rotation is interpolated on the shortest arc
+ */
+[[nodiscard]] transform2d interpolate(const transform2d& from, const transform2d& to, float alpha) noexcept;
+
+/**
+ * Interpolate between two ranges of transforms
+ * @param from The transforms when alpha is 0
+ * @param to The transforms when alpha is 1
+ * @param interpolated Where the interpolated transforms are written
+ * @param count The number of transforms to interpolate
+ * @param alpha How far the results are between from and to
+ */
+void interpolate(const transform2d* from,
+                 const transform2d* to,
+                 transform2d* interpolated,
+                 std::size_t count,
+                 float alpha) noexcept;
+
 }
 
 #endif
@@ -0,0 +1,295 @@
+#include "component_store.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace ng
+{
+
+namespace
+{
+
+std::size_t align_offset(std::size_t offset, std::size_t alignment) noexcept
+{
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+}
+
+std::size_t next_component_index() noexcept
+{
+    static std::atomic<std::size_t> next_index{0};
+
+    return next_index++;
+}
+
+void component_archetype::chunk_deleter::operator()(std::byte* memory) const noexcept
+{
+    ::operator delete(memory, std::align_val_t{chunk_alignment});
+}
+
+component_archetype::component_archetype(component_mask mask, const std::vector<const component_type*>& types)
+: mask_{mask}
+, columns_()
+, column_indices_()
+, chunk_capacity_{0}
+, chunks_()
+, size_{0}
+{
+    column_indices_.fill(no_column);
+
+    std::size_t row_size = sizeof(node*);
+    for(const component_type* type : types)
+    {
+        column_indices_[type->index] = static_cast<uint8_t>(columns_.size());
+        columns_.push_back(column{type, 0});
+        row_size += type->size;
+    }
+
+    // Arrays are laid out one after the other, each one aligned for its component
+    const auto layout = [this](std::size_t capacity) noexcept
+    {
+        std::size_t offset = sizeof(node*) * capacity;
+        for(column& c : columns_)
+        {
+            offset = align_offset(offset, c.type->alignment);
+            c.offset = offset;
+            offset += c.type->size * capacity;
+        }
+
+        return offset;
+    };
+
+    chunk_capacity_ = std::max<std::size_t>(chunk_size / row_size, 1);
+    while(chunk_capacity_ > 1 && layout(chunk_capacity_) > chunk_size)
+    {
+        --chunk_capacity_;
+    }
+
+    layout(chunk_capacity_);
+}
+
+component_archetype::~component_archetype()
+{
+    for(std::size_t row = 0; row < size_; ++row)
+    {
+        for(std::size_t c = 0; c < columns_.size(); ++c)
+        {
+            columns_[c].type->destroy(component(static_cast<row_type>(row), c));
+        }
+    }
+}
+
+node** component_archetype::nodes(std::size_t chunk) const noexcept
+{
+    return reinterpret_cast<node**>(chunks_[chunk].get());
+}
+
+void* component_archetype::component(row_type row, std::size_t column) const noexcept
+{
+    const std::size_t chunk = row / chunk_capacity_;
+    const std::size_t index = row % chunk_capacity_;
+
+    return chunks_[chunk].get() + columns_[column].offset + index * columns_[column].type->size;
+}
+
+component_archetype::row_type component_archetype::push(node* n)
+{
+    if(size_ == chunks_.size() * chunk_capacity_)
+    {
+        void* memory = ::operator new(chunk_size, std::align_val_t{chunk_alignment});
+        chunks_.emplace_back(static_cast<std::byte*>(memory));
+    }
+
+    const auto row = static_cast<row_type>(size_++);
+    nodes(row / chunk_capacity_)[row % chunk_capacity_] = n;
+
+    return row;
+}
+
+node* component_archetype::pop(row_type row) noexcept
+{
+    assert(row < size_);
+
+    const auto last = static_cast<row_type>(--size_);
+
+    node* moved = nullptr;
+    if(row != last)
+    {
+        for(std::size_t c = 0; c < columns_.size(); ++c)
+        {
+            columns_[c].type->relocate(component(row, c), component(last, c));
+        }
+
+        moved = nodes(last / chunk_capacity_)[last % chunk_capacity_];
+        nodes(row / chunk_capacity_)[row % chunk_capacity_] = moved;
+    }
+
+    // A single empty chunk is kept so a node moving back and forth doesn't allocate every time
+    if(chunks_.size() > chunk_count() + 1)
+    {
+        chunks_.pop_back();
+    }
+
+    return moved;
+}
+
+component_mask component_archetype::mask() const noexcept
+{
+    return mask_;
+}
+
+std::size_t component_archetype::size() const noexcept
+{
+    return size_;
+}
+
+std::size_t component_archetype::chunk_count() const noexcept
+{
+    return (size_ + chunk_capacity_ - 1) / chunk_capacity_;
+}
+
+std::size_t component_archetype::chunk_rows(std::size_t chunk) const noexcept
+{
+    assert(chunk < chunk_count());
+
+    return std::min(chunk_capacity_, size_ - chunk * chunk_capacity_);
+}
+
+node* const* component_archetype::chunk_nodes(std::size_t chunk) const noexcept
+{
+    return nodes(chunk);
+}
+
+component_store::component_store()
+: types_()
+, archetypes_()
+, archetype_indices_()
+, query_chunks_()
+{
+    types_.fill(nullptr);
+}
+
+component_store::archetype_type component_store::archetype_of(component_mask mask)
+{
+    const auto found = archetype_indices_.find(mask);
+    if(found != archetype_indices_.end())
+    {
+        return found->second;
+    }
+
+    std::vector<const component_type*> types;
+    for(std::size_t index = 0; index < max_component_types; ++index)
+    {
+        if(mask & (component_mask{1} << index))
+        {
+            assert(types_[index]);
+            types.push_back(types_[index]);
+        }
+    }
+
+    const auto archetype = static_cast<archetype_type>(archetypes_.size());
+    archetypes_.push_back(std::unique_ptr<component_archetype>{new component_archetype{mask, types}});
+    archetype_indices_.emplace(mask, archetype);
+
+    return archetype;
+}
+
+void component_store::move(node* n, component_mask mask)
+{
+    if(mask == 0)
+    {
+        remove_all(n);
+        return;
+    }
+
+    const archetype_type target_index = archetype_of(mask);
+
+    component_archetype& target = *archetypes_[target_index];
+    const component_archetype::row_type row = target.push(n);
+
+    if(n->component_archetype_ != no_archetype)
+    {
+        component_archetype& source = *archetypes_[n->component_archetype_];
+        for(std::size_t c = 0; c < source.columns_.size(); ++c)
+        {
+            void* component = source.component(n->component_row_, c);
+
+            const uint8_t target_column = target.column_indices_[source.columns_[c].type->index];
+            if(target_column != component_archetype::no_column)
+            {
+                source.columns_[c].type->relocate(target.component(row, target_column), component);
+            }
+            else
+            {
+                source.columns_[c].type->destroy(component);
+            }
+        }
+
+        if(node* moved = source.pop(n->component_row_))
+        {
+            moved->component_row_ = n->component_row_;
+        }
+    }
+
+    n->component_archetype_ = target_index;
+    n->component_row_ = row;
+}
+
+void* component_store::insert(node* n, const component_type& type)
+{
+    types_[type.index] = &type;
+
+    const component_mask mask = n->component_archetype_ != no_archetype ? archetypes_[n->component_archetype_]->mask() : 0;
+    move(n, mask | (component_mask{1} << type.index));
+
+    const component_archetype& archetype = *archetypes_[n->component_archetype_];
+
+    return archetype.component(n->component_row_, archetype.column_indices_[type.index]);
+}
+
+void* component_store::find(const node* n, std::size_t index) const noexcept
+{
+    if(n->component_archetype_ == no_archetype)
+    {
+        return nullptr;
+    }
+
+    const component_archetype& archetype = *archetypes_[n->component_archetype_];
+
+    const uint8_t column = archetype.column_indices_[index];
+    if(column == component_archetype::no_column)
+    {
+        return nullptr;
+    }
+
+    return archetype.component(n->component_row_, column);
+}
+
+void component_store::remove_all(node* n) noexcept
+{
+    if(n->component_archetype_ == no_archetype)
+    {
+        return;
+    }
+
+    component_archetype& archetype = *archetypes_[n->component_archetype_];
+    for(std::size_t c = 0; c < archetype.columns_.size(); ++c)
+    {
+        archetype.columns_[c].type->destroy(archetype.component(n->component_row_, c));
+    }
+
+    if(node* moved = archetype.pop(n->component_row_))
+    {
+        moved->component_row_ = n->component_row_;
+    }
+
+    n->component_archetype_ = no_archetype;
+}
+
+const std::vector<std::unique_ptr<component_archetype>>& component_store::archetypes() const noexcept
+{
+    return archetypes_;
+}
+
+}
\ No newline at end of file
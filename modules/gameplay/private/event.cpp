@@ -0,0 +1,56 @@
+#include "event.hpp"
+
+#include <atomic>
+
+namespace ng
+{
+
+event::event() noexcept
+: target_{nullptr}
+, current_node_{nullptr}
+, phase_{phases::at_target}
+, propagation_stopped_{false}
+, immediate_propagation_stopped_{false}
+{
+
+}
+
+node* event::target() const noexcept
+{
+    return target_;
+}
+
+node* event::current_node() const noexcept
+{
+    return current_node_;
+}
+
+event::phases event::phase() const noexcept
+{
+    return phase_;
+}
+
+void event::stop_propagation() noexcept
+{
+    propagation_stopped_ = true;
+}
+
+void event::stop_immediate_propagation() noexcept
+{
+    propagation_stopped_ = true;
+    immediate_propagation_stopped_ = true;
+}
+
+bool event::propagation_stopped() const noexcept
+{
+    return propagation_stopped_;
+}
+
+std::size_t next_event_type_index() noexcept
+{
+    static std::atomic<std::size_t> next_index{0};
+
+    return next_index++;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,487 @@
+#include "event_dispatcher.hpp"
+#include "node.hpp"
+
+#include <ng/core/small_vector.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace ng
+{
+
+namespace
+{
+
+/**
+ * Counts the events being sent while in scope
+ */
+struct dispatch_scope
+{
+    std::size_t& depth;
+
+    explicit dispatch_scope(std::size_t& depth) noexcept
+    : depth{depth}
+    {
+        ++depth;
+    }
+
+    ~dispatch_scope()
+    {
+        --depth;
+    }
+};
+
+}
+
+event_dispatcher::event_dispatcher() noexcept
+: types_()
+, listener_locations_()
+, next_listener_id_{0}
+, dispatch_depth_{0}
+, pending_listeners_()
+, pending_removals_()
+, pending_destroyed_nodes_{false}
+, pools_()
+, queued_events_()
+, dispatched_events_()
+{
+
+}
+
+event_dispatcher::~event_dispatcher()
+{
+    for(const queued_event& queued : queued_events_)
+    {
+        queued.pool->destroy(queued.queued);
+    }
+}
+
+event_dispatcher::listener_id event_dispatcher::add_listener(std::size_t type, node* listener_node,
+                                                             listener_function function, uint8_t phases,
+                                                             bool decorator)
+{
+    assert(listener_node);
+
+    const listener_id id = next_listener_id_++;
+    listener new_listener{id, std::move(function), phases, false};
+
+    listener_locations_.emplace(id, listener_location{type, listener_node});
+
+    if(dispatch_depth_ > 0)
+    {
+        pending_listeners_.push_back(pending_listener{type, listener_node, std::move(new_listener), decorator});
+    }
+    else
+    {
+        insert_listener(type, listener_node, std::move(new_listener), decorator);
+    }
+
+    listener_node->event_listener_ = true;
+
+    return id;
+}
+
+void event_dispatcher::insert_listener(std::size_t type, node* listener_node, listener new_listener, bool decorator)
+{
+    if(type >= types_.size())
+    {
+        types_.resize(type + 1);
+    }
+
+    type_listeners& listeners = types_[type];
+
+    auto [it, inserted] = listeners.by_node.try_emplace(listener_node);
+    node_listeners& receiver_listeners = it->second;
+    if(inserted)
+    {
+        receiver_listeners.node_index = listeners.nodes.size();
+        listeners.nodes.push_back(listening_node{listener_node, &receiver_listeners});
+    }
+
+    if(decorator)
+    {
+        receiver_listeners.listeners.insert(receiver_listeners.listeners.begin() + receiver_listeners.decorator_count,
+                                            std::move(new_listener));
+        ++receiver_listeners.decorator_count;
+    }
+    else
+    {
+        receiver_listeners.listeners.push_back(std::move(new_listener));
+    }
+}
+
+void event_dispatcher::erase_listener(listener_id id) noexcept
+{
+    auto location_it = listener_locations_.find(id);
+    if(location_it == listener_locations_.end())
+    {
+        return;
+    }
+
+    const listener_location location = location_it->second;
+    listener_locations_.erase(location_it);
+
+    type_listeners& listeners = types_[location.type];
+
+    auto it = listeners.by_node.find(location.listener_node);
+    assert(it != listeners.by_node.end());
+
+    node_listeners& receiver_listeners = it->second;
+    auto listener_it = std::find_if(receiver_listeners.listeners.begin(), receiver_listeners.listeners.end(),
+                                    [id](const listener& l) { return l.id == id; });
+    assert(listener_it != receiver_listeners.listeners.end());
+
+    if(static_cast<std::size_t>(listener_it - receiver_listeners.listeners.begin()) < receiver_listeners.decorator_count)
+    {
+        --receiver_listeners.decorator_count;
+    }
+
+    receiver_listeners.listeners.erase(listener_it);
+
+    if(receiver_listeners.listeners.empty())
+    {
+        erase_listening_node(listeners, it);
+    }
+}
+
+void event_dispatcher::erase_listening_node(type_listeners& listeners,
+                                            std::unordered_map<const node*, node_listeners>::iterator it) noexcept
+{
+    assert(dispatch_depth_ == 0);
+
+    // The other nodes keep their place, they are still broadcast to in the order they started listening
+    listeners.nodes[it->second.node_index] = listening_node{nullptr, nullptr};
+    ++listeners.hole_count;
+    listeners.by_node.erase(it);
+
+    if(listeners.hole_count * 2 < listeners.nodes.size())
+    {
+        return;
+    }
+
+    std::size_t kept_count = 0;
+    for(const listening_node& kept : listeners.nodes)
+    {
+        if(kept.listener_node)
+        {
+            kept.listeners->node_index = kept_count;
+            listeners.nodes[kept_count++] = kept;
+        }
+    }
+
+    listeners.nodes.erase(listeners.nodes.begin() + static_cast<std::ptrdiff_t>(kept_count), listeners.nodes.end());
+    listeners.hole_count = 0;
+}
+
+void event_dispatcher::erase_destroyed_nodes() noexcept
+{
+    for(type_listeners& listeners : types_)
+    {
+        for(auto it = listeners.by_node.begin(); it != listeners.by_node.end();)
+        {
+            if(!it->second.destroyed)
+            {
+                ++it;
+                continue;
+            }
+
+            for(const listener& removed_listener : it->second.listeners)
+            {
+                listener_locations_.erase(removed_listener.id);
+            }
+
+            erase_listening_node(listeners, it++);
+        }
+    }
+}
+
+event_dispatcher::listener* event_dispatcher::find_listener(listener_id id) noexcept
+{
+    auto location_it = listener_locations_.find(id);
+    if(location_it == listener_locations_.end() || location_it->second.type >= types_.size())
+    {
+        return nullptr;
+    }
+
+    type_listeners& listeners = types_[location_it->second.type];
+
+    auto it = listeners.by_node.find(location_it->second.listener_node);
+    if(it == listeners.by_node.end())
+    {
+        return nullptr;
+    }
+
+    for(listener& current_listener : it->second.listeners)
+    {
+        if(current_listener.id == id)
+        {
+            return &current_listener;
+        }
+    }
+
+    return nullptr;
+}
+
+void event_dispatcher::apply_pending_changes()
+{
+    if(pending_destroyed_nodes_)
+    {
+        erase_destroyed_nodes();
+        pending_destroyed_nodes_ = false;
+    }
+
+    for(listener_id id : pending_removals_)
+    {
+        erase_listener(id);
+    }
+
+    pending_removals_.clear();
+
+    for(pending_listener& pending : pending_listeners_)
+    {
+        insert_listener(pending.type, pending.listener_node, std::move(pending.new_listener), pending.decorator);
+    }
+
+    pending_listeners_.clear();
+}
+
+void event_dispatcher::unlisten(listener_id id)
+{
+    // A listener added while sending an event is not stored with the other listeners yet
+    auto pending_it = std::find_if(pending_listeners_.begin(), pending_listeners_.end(),
+                                   [id](const pending_listener& pending) { return pending.new_listener.id == id; });
+    if(pending_it != pending_listeners_.end())
+    {
+        pending_listeners_.erase(pending_it);
+        listener_locations_.erase(id);
+        return;
+    }
+
+    if(dispatch_depth_ > 0)
+    {
+        // The listener could be running, it is only erased once the event was sent
+        if(listener* removed_listener = find_listener(id))
+        {
+            removed_listener->removed = true;
+            pending_removals_.push_back(id);
+        }
+    }
+    else
+    {
+        erase_listener(id);
+    }
+}
+
+void event_dispatcher::unlisten_all(const node* listener_node) noexcept
+{
+    // Listeners added while sending an event are not stored with the other listeners yet
+    const auto pending_end = std::remove_if(pending_listeners_.begin(), pending_listeners_.end(),
+                                            [listener_node](const pending_listener& pending)
+                                            {
+                                                return pending.listener_node == listener_node;
+                                            });
+    for(auto it = pending_end; it != pending_listeners_.end(); ++it)
+    {
+        listener_locations_.erase(it->new_listener.id);
+    }
+
+    pending_listeners_.erase(pending_end, pending_listeners_.end());
+
+    for(type_listeners& listeners : types_)
+    {
+        auto it = listeners.by_node.find(listener_node);
+        if(it == listeners.by_node.end() || it->second.destroyed)
+        {
+            continue;
+        }
+
+        if(dispatch_depth_ > 0)
+        {
+            // The listeners could be running, the node is erased once the event was sent and is not visited meanwhile
+            for(listener& removed_listener : it->second.listeners)
+            {
+                removed_listener.removed = true;
+            }
+
+            it->second.destroyed = true;
+            pending_destroyed_nodes_ = true;
+            continue;
+        }
+
+        for(const listener& removed_listener : it->second.listeners)
+        {
+            listener_locations_.erase(removed_listener.id);
+        }
+
+        erase_listening_node(listeners, it);
+    }
+}
+
+void event_dispatcher::deliver(event& e, node* receiving_node, const node_listeners& listeners, event::phases phase)
+{
+    e.current_node_ = receiving_node;
+    e.phase_ = phase;
+
+    for(const listener& current_listener : listeners.listeners)
+    {
+        if((current_listener.phases & phase) && !current_listener.removed)
+        {
+            current_listener.function(e);
+
+            if(e.immediate_propagation_stopped_)
+            {
+                return;
+            }
+        }
+    }
+}
+
+void event_dispatcher::dispatch(event& e, std::size_t type, node* target)
+{
+    assert(target);
+
+    e.target_ = target;
+    e.propagation_stopped_ = false;
+    e.immediate_propagation_stopped_ = false;
+
+    if(type >= types_.size() || types_[type].by_node.empty())
+    {
+        return;
+    }
+
+    const type_listeners& listeners = types_[type];
+
+    struct listening_ancestor
+    {
+        node* ancestor;
+        const node_listeners* listeners;
+    };
+
+    // Only the ancestors with listeners receive the event, from the parent of the target to the top
+    small_vector<listening_ancestor, 16> ancestors;
+    for(node* ancestor = target->parent(); ancestor; ancestor = ancestor->parent())
+    {
+        auto it = listeners.by_node.find(ancestor);
+        if(it != listeners.by_node.end())
+        {
+            ancestors.push_back(listening_ancestor{ancestor, &it->second});
+        }
+    }
+
+    auto target_it = listeners.by_node.find(target);
+
+    {
+        const dispatch_scope scope{dispatch_depth_};
+
+        for(std::size_t i = ancestors.size(); i > 0 && !e.propagation_stopped_; --i)
+        {
+            deliver(e, ancestors[i - 1].ancestor, *ancestors[i - 1].listeners, event::capture);
+        }
+
+        if(target_it != listeners.by_node.end() && !e.propagation_stopped_)
+        {
+            deliver(e, target, target_it->second, event::at_target);
+        }
+
+        for(std::size_t i = 0; i < ancestors.size() && !e.propagation_stopped_; ++i)
+        {
+            deliver(e, ancestors[i].ancestor, *ancestors[i].listeners, event::bubble);
+        }
+    }
+
+    if(dispatch_depth_ == 0)
+    {
+        apply_pending_changes();
+    }
+}
+
+void event_dispatcher::broadcast(event& e, std::size_t type, node* subtree_root)
+{
+    assert(subtree_root);
+
+    e.target_ = subtree_root;
+    e.propagation_stopped_ = false;
+    e.immediate_propagation_stopped_ = false;
+
+    if(type >= types_.size())
+    {
+        return;
+    }
+
+    const type_listeners& listeners = types_[type];
+
+    {
+        const dispatch_scope scope{dispatch_depth_};
+
+        // Listening nodes don't change while the event is sent, destroyed nodes are only erased after
+        for(const listening_node& receiver : listeners.nodes)
+        {
+            if(!receiver.listener_node || receiver.listeners->destroyed)
+            {
+                continue;
+            }
+
+            if(receiver.listener_node != subtree_root && !receiver.listener_node->in_hierarchy(subtree_root))
+            {
+                continue;
+            }
+
+            deliver(e, receiver.listener_node, *receiver.listeners, event::broadcast);
+
+            if(e.propagation_stopped_)
+            {
+                break;
+            }
+        }
+    }
+
+    if(dispatch_depth_ == 0)
+    {
+        apply_pending_changes();
+    }
+}
+
+void event_dispatcher::dispatch_queued()
+{
+    assert(dispatch_depth_ == 0);
+    assert(dispatched_events_.empty());
+
+    // Events queued by the listeners are sent by the next call
+    dispatched_events_.swap(queued_events_);
+
+    struct destroy_dispatched_events
+    {
+        std::vector<queued_event>& events;
+
+        ~destroy_dispatched_events()
+        {
+            for(const queued_event& queued : events)
+            {
+                queued.pool->destroy(queued.queued);
+            }
+
+            events.clear();
+        }
+    };
+
+    const destroy_dispatched_events cleanup{dispatched_events_};
+
+    for(const queued_event& queued : dispatched_events_)
+    {
+        if(queued.broadcast)
+        {
+            broadcast(*queued.queued, queued.type, queued.target);
+        }
+        else
+        {
+            dispatch(*queued.queued, queued.type, queued.target);
+        }
+    }
+}
+
+std::size_t event_dispatcher::queued_count() const noexcept
+{
+    return queued_events_.size();
+}
+
+}
\ No newline at end of file
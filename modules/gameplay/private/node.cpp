@@ -1,28 +1,69 @@
 #include "node.hpp"
+#include "node_tree.hpp"
+#include "node2d.hpp"
+#include "node_child_index.hpp"
+#include <ng/core/hash.hpp>
 #include <algorithm>
+#include <atomic>
 
 #include <cassert>
 
 namespace ng
 {
 
+namespace
+{
+
+// Under this number of children, comparing every name is faster than hashing
+constexpr std::size_t child_index_threshold = 32;
+
+// The index is only dropped well under the threshold so a node hovering around it doesn't rebuild it constantly
+constexpr std::size_t child_index_release_threshold = 8;
+
+}
+
+std::size_t next_node_type_index() noexcept
+{
+    // node and node2d use the first indices
+    static std::atomic<std::size_t> next_index{2};
+
+    return next_index++;
+}
+
+void node::on_structure_changed() noexcept
+{
+    structure_version_ = owner_->next_structure_version();
+}
+
 void node::set_owner(node_tree* owner)
 {
     owner_ = owner;
 
-    for(auto& child : children_)
+    for(node* child = first_child_; child; child = child->next_sibling_)
     {
         child->set_owner(owner);
     }
 }
 
-node::node(safe_name name, node* parent) noexcept
+node::node(node_tree& owner, safe_name name, node* parent)
 : name_{std::move(name)}
-// A node is owned by the same tree as its parent
-, owner_{nullptr}
+, owner_{&owner}
 , parent_{nullptr}
-, children_()
-, decorators_()
+, first_child_{nullptr}
+, last_child_{nullptr}
+, next_sibling_{nullptr}
+, previous_sibling_{nullptr}
+, child_count_{0}
+, child_index_()
+, structure_version_{owner.next_structure_version()}
+, component_archetype_{component_store::no_archetype}
+, component_row_{0}
+, type_mask_{node_type_bit<node>()}
+// Nodes created while the tree is collecting survive the collection
+, mark_epoch_{owner.mark_epoch_}
+, decorated_{false}
+, event_listener_{false}
+, tick_registered_{false}
 {
     if(parent)
     {
@@ -30,19 +71,104 @@ node::node(safe_name name, node* parent) noexcept
     }
 }
 
+node::~node()
+{
+    if(event_listener_)
+    {
+        owner_->events_.unlisten_all(this);
+    }
+
+    if(tick_registered_)
+    {
+        owner_->scheduler_.remove(this);
+    }
+
+    if(component_archetype_ != component_store::no_archetype)
+    {
+        owner_->components_.remove_all(this);
+    }
+
+    if(decorated_)
+    {
+        owner_->decorators_.erase(this);
+    }
+}
+
+void node::on_tick(frame_duration)
+{
+
+}
+
 const safe_name& node::name() const noexcept
 {
     return name_;
 }
 
+void node::rename(safe_name new_name)
+{
+    if(new_name == name_)
+    {
+        return;
+    }
+
+    if(parent_)
+    {
+        if(parent_->find_child(new_name))
+        {
+            throw invalid_node_name{new_name};
+        }
+
+        // The index of the parent is keyed by the name
+        if(parent_->child_index_)
+        {
+            parent_->child_index_->erase(this);
+        }
+    }
+
+    name_ = std::move(new_name);
+
+    if(parent_)
+    {
+        if(parent_->child_index_)
+        {
+            parent_->child_index_->insert(this);
+        }
+
+        parent_->on_structure_changed();
+    }
+
+    on_structure_changed();
+}
+
 void node::add_decorator(std::unique_ptr<node_decorator> decorator)
 {
-    decorators_.push_back(std::move(decorator));
+    assert(decorator);
+
+    decorator->node_ = this;
+    owner_->decorators_[this].push_back(std::move(decorator));
+    decorated_ = true;
 }
 
 void node::clear_decorators()
 {
-    decorators_.clear();
+    if(decorated_)
+    {
+        owner_->decorators_.erase(this);
+        decorated_ = false;
+    }
+}
+
+std::size_t node::decorator_count() const noexcept
+{
+    if(!decorated_)
+    {
+        return 0;
+    }
+
+    const auto found = owner_->decorators_.find(this);
+    assert(found != owner_->decorators_.end());
+
+    return found->second.size();
 }
 
 void node::attach_to(node* parent)
@@ -64,26 +190,32 @@ void node::detach_child(node* child)
 {
     assert(child);
 
-    for(std::size_t i = 0; i < children_.size(); ++i)
+    if(child->parent_ != this)
     {
-        if(children_[i] == child)
-        {
-            // Make sure the children doesn't reference this node
-            child->parent_ = nullptr;
-
-            std::swap(children_[i], children_.back());
-            children_.pop_back();
-        }
+        return;
     }
+
+    unlink_child(child);
+
+    on_structure_changed();
+    child->on_structure_changed();
+
+    child->parent_changed();
 }
 
 void node::attach_child(node* child)
 {
     assert(child);
 
+    // If it is already attached to this node, stop right here, nothing needs to be done
+    if(child->parent_ == this)
+    {
+        return;
+    }
+
     // If this node already has a child with the same name as the new node to add
     // we cannot proceed further
-    if(std::any_of(children_.begin(), children_.end(), [child](const node* child_node) { return child_node->name() == child->name(); }))
+    if(find_child(child->name()))
     {
         throw invalid_node_name{child->name()};
     }
@@ -91,65 +223,220 @@ void node::attach_child(node* child)
     // Make sure to detach child from it's parent before attaching it to a new node
     if(node* current_parent = child->parent_)
     {
-        // Check if the child is not already attached to this node
-        if(current_parent != this)
+        current_parent->detach_child(child);
+    }
+
+    // The tree could have already looked for reachable nodes under this node
+    owner_->on_child_attached(this, child);
+
+    link_child(child);
+
+    on_structure_changed();
+    child->on_structure_changed();
+
+    child->parent_changed();
+}
+
+void node::link_child(node* child, node* next_sibling)
+{
+    assert(!child->parent_);
+    assert(!next_sibling || next_sibling->parent_ == this);
+
+    child->parent_ = this;
+    child->next_sibling_ = next_sibling;
+
+    if(next_sibling)
+    {
+        child->previous_sibling_ = next_sibling->previous_sibling_;
+        next_sibling->previous_sibling_ = child;
+    }
+    else
+    {
+        child->previous_sibling_ = last_child_;
+        last_child_ = child;
+    }
+
+    if(child->previous_sibling_)
+    {
+        child->previous_sibling_->next_sibling_ = child;
+    }
+    else
+    {
+        first_child_ = child;
+    }
+
+    ++child_count_;
+
+    if(child_index_)
+    {
+        child_index_->insert(child);
+    }
+    else if(child_count_ >= child_index_threshold)
+    {
+        child_index_ = std::make_unique<node_child_index>(child_count_);
+        for(node* indexed_child = first_child_; indexed_child; indexed_child = indexed_child->next_sibling_)
+        {
+            child_index_->insert(indexed_child);
+        }
+    }
+}
+
+void node::unlink_child(node* child) noexcept
+{
+    assert(child->parent_ == this);
+
+    // Unlink the child from its siblings
+    if(child->previous_sibling_)
+    {
+        child->previous_sibling_->next_sibling_ = child->next_sibling_;
+    }
+    else
+    {
+        first_child_ = child->next_sibling_;
+    }
+
+    if(child->next_sibling_)
+    {
+        child->next_sibling_->previous_sibling_ = child->previous_sibling_;
+    }
+    else
+    {
+        last_child_ = child->previous_sibling_;
+    }
+
+    --child_count_;
+
+    if(child_index_)
+    {
+        if(child_count_ < child_index_release_threshold)
         {
-            current_parent->detach_child(child);
+            child_index_.reset();
         }
-        // If it is, stop right here, nothing needs to be done
         else
         {
-            return;
+            child_index_->erase(child);
         }
     }
 
-    // At this point, child is ready to be attached to this
-    child->parent_ = this;
-    children_.push_back(child);
+    // Make sure the children doesn't reference this node
+    child->parent_ = nullptr;
+    child->next_sibling_ = nullptr;
+    child->previous_sibling_ = nullptr;
+}
+
+void node::parent_changed() noexcept
+{
+    on_parent_changed();
+
+    if(is_a<node2d>())
+    {
+        return;
+    }
+
+    // The node2d below this node, until the next node2d of each branch, merge their bounds in the closest node2d
+    // above this node
+    const transform_store::slot_type bounds_parent = node2d::bounds_slot(this);
+
+    node* current = first_child_;
+    while(current)
+    {
+        if(current->is_a<node2d>())
+        {
+            owner_->transforms_.set_bounds_parent(static_cast<node2d*>(current)->transform_slot_, bounds_parent);
+        }
+        else if(current->first_child_)
+        {
+            current = current->first_child_;
+            continue;
+        }
+
+        // Continue with the next sibling of the closest node having one, without leaving the subtree of this node
+        while(current != this && !current->next_sibling_)
+        {
+            current = current->parent_;
+        }
+
+        current = current != this ? current->next_sibling_ : nullptr;
+    }
+}
+
+void node::on_parent_changed() noexcept
+{
+
 }
 
 bool node::has_child(const node* child) const noexcept
 {
     assert(child);
 
-    return std::any_of(children_.begin(), children_.end(), [child](const node* child_strong_ptr)
-    {
-        return child_strong_ptr == child;
-    });
+    return child->parent_ == this;
 }
 
 node* node::find_child(const safe_name& name) noexcept
 {
-    auto it = std::find_if(children_.begin(), children_.end(), [&name](const node* child_strong_ptr)
-    {
-       return child_strong_ptr->name() == name;
-    });
-
-    if(it == children_.end())
+    if(child_index_)
     {
-        return nullptr;
+        return child_index_->find(name);
     }
-    else
+
+    for(node* child = first_child_; child; child = child->next_sibling_)
     {
-        return *it;
+        if(child->name() == name)
+        {
+            return child;
+        }
     }
+
+    return nullptr;
 }
 
 const node* node::find_child(const safe_name& name) const noexcept
 {
-    auto it = std::find_if(children_.begin(), children_.end(), [&name](const node* child_strong_ptr)
+    if(child_index_)
     {
-        return child_strong_ptr->name() == name;
-    });
+        return child_index_->find(name);
+    }
 
-    if(it == children_.end())
+    for(const node* child = first_child_; child; child = child->next_sibling_)
     {
-        return nullptr;
+        if(child->name() == name)
+        {
+            return child;
+        }
     }
-    else
+
+    return nullptr;
+}
+
+std::size_t node::child_count() const noexcept
+{
+    return child_count_;
+}
+
+node* node::find_child(std::string_view name) noexcept
+{
+    const uint64_t name_hash = hash(name);
+
+    if(child_index_)
+    {
+        return child_index_->find(name, name_hash);
+    }
+
+    for(node* child = first_child_; child; child = child->next_sibling_)
     {
-        return *it;
+        // Comparing the hashes first avoids reading the strings of the other children
+        if(child->name().hash() == name_hash && child->name().c_str() == name)
+        {
+            return child;
+        }
     }
+
+    return nullptr;
+}
+
+const node* node::find_child(std::string_view name) const noexcept
+{
+    return const_cast<node*>(this)->find_child(name);
 }
 
 bool node::in_hierarchy(const node* parent) const noexcept
@@ -179,12 +466,22 @@ bool node::root() const noexcept
 
 bool node::leaf() const noexcept
 {
-    return children_.empty();
+    return first_child_ == nullptr;
 }
 
-primary_node_types node::primary_node_type() const noexcept
+node_type_mask node::type_mask() const noexcept
 {
-    return primary_node_types::node;
+    return type_mask_;
+}
+
+node_tree* node::owner() noexcept
+{
+    return owner_;
+}
+
+const node_tree* node::owner() const noexcept
+{
+    return owner_;
 }
 
 node* node::parent() noexcept
@@ -199,122 +496,42 @@ const node* node::parent() const noexcept
 
 node* node::first_child() noexcept
 {
-    if(!children_.empty())
-    {
-        return children_.front();
-    }
-
-    return nullptr;
+    return first_child_;
 }
 
 const node* node::first_child() const noexcept
 {
-    if(!children_.empty())
-    {
-        return children_.front();
-    }
-
-    return nullptr;
+    return first_child_;
 }
 
 node* node::last_child() noexcept
 {
-    if(!children_.empty())
-    {
-        return children_.back();
-    }
-
-    return nullptr;
+    return last_child_;
 }
 
 const node* node::last_child() const noexcept
 {
-    if(!children_.empty())
-    {
-        return children_.back();
-    }
-
-    return nullptr;
+    return last_child_;
 }
 
 node* node::next_sibling() noexcept
 {
-    if(parent_)
-    {
-        auto it = std::find(parent_->children_.begin(), parent_->children_.end(), this);
-
-        if(it != parent_->children_.end())
-        {
-            const std::size_t index = std::distance(parent_->children_.begin(), it);
-
-            if(index < parent_->children_.size() - 1)
-            {
-                return parent_->children_[index + 1];
-            }
-        }
-    }
-
-    return nullptr;
+    return next_sibling_;
 }
 
 const node* node::next_sibling() const noexcept
 {
-    if(parent_)
-    {
-        auto it = std::find(parent_->children_.begin(), parent_->children_.end(), this);
-
-        if(it != parent_->children_.end())
-        {
-            const std::size_t index = std::distance(parent_->children_.begin(), it);
-
-            if(index < parent_->children_.size() - 1)
-            {
-                return parent_->children_[index + 1];
-            }
-        }
-    }
-
-    return nullptr;
+    return next_sibling_;
 }
 
 node* node::previous_sibling() noexcept
 {
-    if(parent_)
-    {
-        auto it = std::find(parent_->children_.begin(), parent_->children_.end(), this);
-
-        if(it != parent_->children_.end())
-        {
-            const std::size_t index = std::distance(parent_->children_.begin(), it);
-
-            if(index > 0)
-            {
-                return parent_->children_[index - 1];
-            }
-        }
-    }
-
-    return nullptr;
+    return previous_sibling_;
 }
 
 const node* node::previous_sibling() const noexcept
 {
-    if(parent_)
-    {
-        auto it = std::find(parent_->children_.begin(), parent_->children_.end(), this);
-
-        if(it != parent_->children_.end())
-        {
-            const std::size_t index = std::distance(parent_->children_.begin(), it);
-
-            if(index > 0)
-            {
-                return parent_->children_[index - 1];
-            }
-        }
-    }
-
-    return nullptr;
+    return previous_sibling_;
 }
 
 }
\ No newline at end of file
@@ -1,60 +1,165 @@
 #include "node2d.hpp"
+#include "node_tree.hpp"
 
 namespace ng
 {
 
-transform2d node2d::parent_transform() const noexcept
+const node2d* node2d::parent_node2d() const noexcept
 {
     if(const node* parent_node = parent();
-       parent_node && parent_node->primary_node_type() == primary_node_types::node2d)
+       parent_node && parent_node->is_a<node2d>())
     {
-        const node2d* parent_node2d = static_cast<const node2d*>(parent_node);
+        return static_cast<const node2d*>(parent_node);
+    }
+
+    return nullptr;
+}
 
-        return parent_node2d->world_transform();
+transform_store::slot_type node2d::bounds_slot(const node* n) noexcept
+{
+    // Nodes without transform are skipped, their node2d children are bounded by the node2d above them
+    for(; n; n = n->parent())
+    {
+        if(n->is_a<node2d>())
+        {
+            return static_cast<const node2d*>(n)->transform_slot_;
+        }
     }
 
-    return transform2d{};
+    return transform_store::invalid_slot;
+}
+
+transform_store& node2d::transforms() noexcept
+{
+    return owner()->transforms_;
 }
 
-node2d::node2d(safe_name name, node* parent) noexcept
-: node{std::move(name), parent}
-, local_()
-, world_()
+const transform_store& node2d::transforms() const noexcept
 {
+    return owner()->transforms_;
+}
 
+spatial_index& node2d::spatial() noexcept
+{
+    return owner()->spatial_;
 }
 
-node2d::node2d(safe_name name, transform2d transform, node* parent) noexcept
-: node2d(std::move(name), parent)
+const spatial_index& node2d::spatial() const noexcept
+{
+    return owner()->spatial_;
+}
+
+void node2d::on_parent_changed() noexcept
+{
+    const node2d* parent_node2d = this->parent_node2d();
+
+    transforms().set_parent(transform_slot_,
+                            parent_node2d ? parent_node2d->transform_slot_ : transform_store::invalid_slot,
+                            bounds_slot(parent()));
+}
+
+node2d::node2d(node_tree& owner, safe_name name, node* parent)
+: node{owner, std::move(name), parent}
+, transform_slot_{transform_store::invalid_slot}
+, spatial_entry_{spatial_index::invalid_entry}
+{
+    // Set before any child can look for its parent node2d
+    add_node_type<node2d>();
+
+    const node2d* parent_node2d = this->parent_node2d();
+
+    transform_slot_ = transforms().add(this,
+                                       parent_node2d ? parent_node2d->transform_slot_ : transform_store::invalid_slot,
+                                       bounds_slot(parent));
+}
+
+node2d::node2d(node_tree& owner, safe_name name, transform2d transform, node* parent)
+: node2d(owner, std::move(name), parent)
 {
     set_local_transform(transform);
 }
 
-const transform2d& node2d::world_transform() const noexcept
+node2d::~node2d()
 {
-    return world_;
+    if(spatial_entry_ != spatial_index::invalid_entry)
+    {
+        spatial().remove(spatial_entry_);
+    }
+
+    transforms().release(transform_slot_);
 }
 
-const transform2d& node2d::local_transform() const noexcept
+transform2d node2d::world_transform() const noexcept
 {
-    return local_;
+    return transform2d{world_affine().matrix()};
+}
+
+const affine2d& node2d::world_affine() const noexcept
+{
+    return transforms().world(transform_slot_);
+}
+
+transform2d node2d::local_transform() const noexcept
+{
+    return transforms().local_transform(transform_slot_);
 }
 
 void node2d::set_world_transform(const transform2d& world_transform) noexcept
 {
-    world_ = world_transform;
-    local_ = transform2d{glm::inverse(parent_transform().matrix()) * world_.matrix()};
+    transforms().set_world_transform(transform_slot_, world_transform);
 }
 
 void node2d::set_local_transform(const transform2d& transform) noexcept
 {
-    local_ = transform;
-    world_ = parent_transform() * local_;
+    transforms().set_local_transform(transform_slot_, transform);
+}
+
+transform_store::slot_type node2d::transform_slot() const noexcept
+{
+    return transform_slot_;
+}
+
+void node2d::set_local_bounds(const aabb2d& bounds)
+{
+    transforms().set_local_bounds(transform_slot_, bounds);
+
+    if(bounds.empty())
+    {
+        if(spatial_entry_ != spatial_index::invalid_entry)
+        {
+            spatial().remove(spatial_entry_);
+        }
+
+        return;
+    }
+
+    // Computing the world transform gives its version
+    const aabb2d world_bounds = bounds.transform(world_affine());
+    const uint32_t world_version = transforms().world_versions()[transform_slot_];
+
+    if(spatial_entry_ == spatial_index::invalid_entry)
+    {
+        spatial().insert(this, world_bounds, world_version);
+    }
+    else
+    {
+        spatial().update(spatial_entry_, world_bounds, world_version);
+    }
+}
+
+const aabb2d& node2d::local_bounds() const noexcept
+{
+    return transforms().local_bounds(transform_slot_);
+}
+
+aabb2d node2d::world_bounds() const noexcept
+{
+    return local_bounds().transform(world_affine());
 }
 
-primary_node_types node2d::primary_node_type() const noexcept
+const aabb2d& node2d::subtree_bounds() const noexcept
 {
-    return primary_node_types::node2d;
+    return transforms().subtree_bounds()[transform_slot_];
 }
 
 }
\ No newline at end of file
@@ -0,0 +1,152 @@
+#include "node_child_index.hpp"
+#include "node.hpp"
+
+#include <cassert>
+
+namespace ng
+{
+
+namespace
+{
+
+std::size_t next_power_of_two(std::size_t value) noexcept
+{
+    std::size_t power = 1;
+    while(power < value)
+    {
+        power <<= 1;
+    }
+
+    return power;
+}
+
+}
+
+node_child_index::node_child_index(std::size_t expected_size)
+: slots_(next_power_of_two(expected_size * 2), nullptr)
+, size_{0}
+{
+
+}
+
+std::size_t node_child_index::slot_of(uint64_t child_name_hash) const noexcept
+{
+    return static_cast<std::size_t>(child_name_hash) & (slots_.size() - 1);
+}
+
+void node_child_index::insert_without_growing(node* child) noexcept
+{
+    const std::size_t mask = slots_.size() - 1;
+
+    std::size_t slot = slot_of(child->name().hash());
+    while(slots_[slot])
+    {
+        assert(slots_[slot]->name() != child->name());
+
+        slot = (slot + 1) & mask;
+    }
+
+    slots_[slot] = child;
+    ++size_;
+}
+
+void node_child_index::grow()
+{
+    std::vector<node*> previous_slots(slots_.size() * 2, nullptr);
+    previous_slots.swap(slots_);
+    size_ = 0;
+
+    for(node* child : previous_slots)
+    {
+        if(child)
+        {
+            insert_without_growing(child);
+        }
+    }
+}
+
+void node_child_index::insert(node* child)
+{
+    assert(child);
+
+    // Keep the table at most half full so probe sequences stay short
+    if((size_ + 1) * 2 > slots_.size())
+    {
+        grow();
+    }
+
+    insert_without_growing(child);
+}
+
+void node_child_index::erase(const node* child) noexcept
+{
+    assert(child);
+
+    const std::size_t mask = slots_.size() - 1;
+
+    std::size_t slot = slot_of(child->name().hash());
+    while(slots_[slot] != child)
+    {
+        if(!slots_[slot])
+        {
+            return;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    // Shift back the following entries of the probe sequence instead of leaving a tombstone
+    std::size_t empty_slot = slot;
+    for(std::size_t next_slot = (slot + 1) & mask; slots_[next_slot]; next_slot = (next_slot + 1) & mask)
+    {
+        const std::size_t ideal_slot = slot_of(slots_[next_slot]->name().hash());
+
+        // The entry can only move back if its ideal slot is not between the empty slot and its current slot
+        if(((next_slot - ideal_slot) & mask) >= ((next_slot - empty_slot) & mask))
+        {
+            slots_[empty_slot] = slots_[next_slot];
+            empty_slot = next_slot;
+        }
+    }
+
+    slots_[empty_slot] = nullptr;
+    --size_;
+}
+
+node* node_child_index::find(const name& child_name) const noexcept
+{
+    const std::size_t mask = slots_.size() - 1;
+
+    for(std::size_t slot = slot_of(child_name.hash()); slots_[slot]; slot = (slot + 1) & mask)
+    {
+        if(slots_[slot]->name() == child_name)
+        {
+            return slots_[slot];
+        }
+    }
+
+    return nullptr;
+}
+
+node* node_child_index::find(std::string_view child_name, uint64_t child_name_hash) const noexcept
+{
+    const std::size_t mask = slots_.size() - 1;
+
+    for(std::size_t slot = slot_of(child_name_hash); slots_[slot]; slot = (slot + 1) & mask)
+    {
+        const name& slot_name = slots_[slot]->name();
+        if(slot_name.hash() == child_name_hash && slot_name.c_str() == child_name)
+        {
+            return slots_[slot];
+        }
+    }
+
+    return nullptr;
+}
+
+std::size_t node_child_index::size() const noexcept
+{
+    return size_;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#ifndef NGINE_GAMEPLAY_NODE_CHILD_INDEX_HPP
+#define NGINE_GAMEPLAY_NODE_CHILD_INDEX_HPP
+
+#include <ng/core/name.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace ng
+{
+
+class node;
+
+/**
+ * Finds the children of a node by their name
+ * An open addressing hash table with linear probing, keyed by the hash of the children names
+ */
+class node_child_index
+{
+    // nullptr for empty slots, the number of slots is always a power of two
+    std::vector<node*> slots_;
+    std::size_t size_;
+
+    [[nodiscard]] std::size_t slot_of(uint64_t child_name_hash) const noexcept;
+
+    void insert_without_growing(node* child) noexcept;
+    void grow();
+
+public:
+    /**
+     * Construct an empty index
+     * @param expected_size The number of children the index can hold before growing
+     */
+    explicit node_child_index(std::size_t expected_size);
+
+    /**
+     * Add a child to the index
+     * @param child The child to add, no other child can have the same name
+     */
+    void insert(node* child);
+
+    /**
+     * Remove a child from the index
+     * @param child The child to remove
+     */
+    void erase(const node* child) noexcept;
+
+    /**
+     * Find a child by its name
+     * @param child_name The name of the child
+     * @return The child or nullptr if no child has this name
+     */
+    [[nodiscard]] node* find(const name& child_name) const noexcept;
+
+    /**
+     * Find a child by the string of its name
+     * @param child_name The string of the name of the child
+     * @param child_name_hash The hash of the string, computed with ng::hash
+     * @return The child or nullptr if no child has this name
+     */
+    [[nodiscard]] node* find(std::string_view child_name, uint64_t child_name_hash) const noexcept;
+
+    /**
+     * Returns the number of children in the index
+     * @return The number of children in the index
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+};
+
+}
+
+#endif
@@ -0,0 +1,54 @@
+#include "node_command_buffer.hpp"
+
+#include <cassert>
+
+namespace ng
+{
+
+node_command_buffer::node_handle node_command_buffer::create(construct_function construct, safe_name name,
+                                                             bool has_transform, const transform2d& transform)
+{
+    assert(created_nodes_.size() < node_handle::existing_node);
+
+    created_nodes_.push_back(created_node{construct, std::move(name), has_transform, transform});
+
+    return node_handle{static_cast<uint32_t>(created_nodes_.size() - 1)};
+}
+
+void node_command_buffer::attach(node_handle parent, node_handle child)
+{
+    assert(parent.node_ || parent.created());
+    assert(child.node_ || child.created());
+    assert(!parent.created() || parent.created_index_ < created_nodes_.size());
+    assert(!child.created() || child.created_index_ < created_nodes_.size());
+
+    commands_.push_back(move_command{parent, child});
+}
+
+void node_command_buffer::detach(node_handle child)
+{
+    assert(child.node_ || child.created());
+    assert(!child.created() || child.created_index_ < created_nodes_.size());
+
+    commands_.push_back(move_command{node_handle{static_cast<node*>(nullptr)}, child});
+}
+
+void node_command_buffer::destroy(node_handle n)
+{
+    // Unreachable nodes are freed by the collections of the tree
+    detach(n);
+}
+
+void node_command_buffer::clear() noexcept
+{
+    created_nodes_.clear();
+    commands_.clear();
+    applied_nodes_.clear();
+}
+
+bool node_command_buffer::empty() const noexcept
+{
+    return created_nodes_.empty() && commands_.empty();
+}
+
+}
\ No newline at end of file
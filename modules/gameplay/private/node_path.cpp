@@ -1,12 +1,22 @@
 #include "node_path.hpp"
-#include <sstream>
+#include <ng/core/hash.hpp>
 #include <cassert>
 
 namespace ng
 {
 
+namespace
+{
+
+constexpr std::string_view current_node{"."};
+constexpr std::string_view parent_node{".."};
+
+}
+
 node_path::node_path() noexcept
-: names_()
+: text_()
+, elements_()
+, text_hash_{hash_offset_basis}
 , absolute_{false}
 , trailing_delimiter_{false}
 {
@@ -19,41 +29,64 @@ node_path::node_path(std::string_view str)
 
 }
 
-node_path node_path::normalize() const
+std::string_view node_path::element(std::size_t index) const noexcept
 {
-    node_path normalized_path = *this;
-
-    // 1. Remove empty names
-    {
-        auto it = std::remove(normalized_path.names_.begin(), normalized_path.names_.end(), safe_name{});
-        normalized_path.names_.erase(it, normalized_path.names_.end());
-    }
+    const element_range& range = elements_[index];
 
+    return std::string_view{text_.data() + range.offset, range.length};
+}
 
-    // 2. Resolve dots
+void node_path::push_back(std::string_view element)
+{
+    if(!elements_.empty())
     {
-        auto it = std::remove(normalized_path.names_.begin(), normalized_path.names_.end(), safe_name{"."});
-        normalized_path.names_.erase(it, normalized_path.names_.end());
+        text_.push_back(delimiter_char);
+        text_hash_ = ng::hash(text_hash_, std::string_view{&delimiter_char, 1});
     }
 
-    // /hello/../world
+    elements_.push_back(element_range{static_cast<uint32_t>(text_.size()), static_cast<uint32_t>(element.size())});
+    text_.append(element.data(), element.size());
+    text_hash_ = ng::hash(text_hash_, element);
+}
 
-    static const safe_name parent_node{".."};
+node_path node_path::normalize() const
+{
+    // Elements kept after resolving the dots, a dot-dot removes the previous element
+    small_vector<std::size_t, 8> kept_elements;
 
-    // 3. Resolve dot-dot
-    for(int64_t i = normalized_path.names_.size() - 2; i >= 0; --i)
+    for(std::size_t i = 0; i < elements_.size(); ++i)
     {
-        const std::size_t size = normalized_path.names_.size();
+        const std::string_view current_element = element(i);
 
-        if(normalized_path.names_[i + 1] == parent_node && normalized_path.names_[i] != parent_node)
+        // Multiple delimiters are combined and dots are removed
+        if(current_element.empty() || current_element == current_node)
         {
-            std::swap(normalized_path.names_[i + 1], normalized_path.names_[size - 1]);
-            std::swap(normalized_path.names_[i], normalized_path.names_[size - 2]);
+            continue;
+        }
 
-            normalized_path.names_.pop_back();
-            normalized_path.names_.pop_back();
-            --i;
+        if(current_element == parent_node && !kept_elements.empty() && element(kept_elements.back()) != parent_node)
+        {
+            kept_elements.pop_back();
         }
+        else
+        {
+            kept_elements.push_back(i);
+        }
+    }
+
+    node_path normalized_path;
+    normalized_path.absolute_ = absolute_;
+    normalized_path.trailing_delimiter_ = trailing_delimiter_;
+
+    if(absolute_)
+    {
+        normalized_path.text_.push_back(delimiter_char);
+        normalized_path.text_hash_ = ng::hash(std::string_view{&delimiter_char, 1});
+    }
+
+    for(std::size_t index : kept_elements)
+    {
+        normalized_path.push_back(element(index));
     }
 
     return normalized_path;
@@ -72,9 +105,9 @@ node_path node_path::append(const node_path& path) const
     else
     {
         node_path new_path = *this;
-        for(const safe_name& name : path.names_)
+        for(std::size_t i = 0; i < path.elements_.size(); ++i)
         {
-            new_path.names_.push_back(name);
+            new_path.push_back(path.element(i));
         }
         new_path.trailing_delimiter_ = path.trailing_delimiter_;
 
@@ -94,7 +127,11 @@ node_path node_path::concat(const node_path& path) const
     }
     else
     {
-        return node_path(string() + path.string());
+        small_vector<char, 128> buffer;
+        write(buffer);
+        path.write(buffer);
+
+        return parse(std::string_view{buffer.data(), buffer.size()});
     }
 }
 
@@ -116,53 +153,55 @@ bool node_path::absolute() const noexcept
 
 bool node_path::empty() const noexcept
 {
-    return names_.empty() && !absolute_;
+    return elements_.empty() && !absolute_;
+}
+
+std::size_t node_path::size() const noexcept
+{
+    return elements_.size();
 }
 
 void node_path::clear()
 {
-    names_.clear();
+    text_.clear();
+    elements_.clear();
+    text_hash_ = hash_offset_basis;
     absolute_ = false;
     trailing_delimiter_ = false;
 }
 
 std::string node_path::string() const
 {
-    std::ostringstream stream;
+    std::string string;
+    string.reserve(text_.size() + 1);
+    write(string);
 
-    if(absolute_)
-    {
-        stream << delimiter_char;
-    }
-
-    for(const safe_name& name : names_)
-    {
-        stream << name.c_str() << delimiter_char;
-    }
-
-    const std::string string = stream.str();
+    return string;
+}
 
-    // Remove last trailing delimiter if there was none
-    if(!trailing_delimiter_ && !names_.empty())
+uint64_t node_path::hash() const noexcept
+{
+    if(trailing_delimiter_ && !elements_.empty())
     {
-        return string.substr(0, string.size() - 1);
+        return ng::hash(text_hash_, std::string_view{&delimiter_char, 1});
     }
 
-    return string;
+    return text_hash_;
 }
 
 bool node_path::operator==(const node_path& other) const noexcept
 {
-    return absolute_ == other.absolute_
-        && std::equal(names_.begin(), names_.end(), other.names_.begin(), other.names_.end())
-        && trailing_delimiter_ == other.trailing_delimiter_;
+    // Elements can't contain delimiters, paths with the same text and number of elements have the same elements
+    return text_hash_ == other.text_hash_
+        && absolute_ == other.absolute_
+        && trailing_delimiter_ == other.trailing_delimiter_
+        && elements_.size() == other.elements_.size()
+        && std::string_view{text_.data(), text_.size()} == std::string_view{other.text_.data(), other.text_.size()};
 }
 
 bool node_path::operator!=(const node_path& other) const noexcept
 {
-    return absolute_ != other.absolute_
-        || !std::equal(names_.begin(), names_.end(), other.names_.begin(), other.names_.end())
-        || trailing_delimiter_ != other.trailing_delimiter_;
+    return !(*this == other);
 }
 
 node_path_iterator node_path::begin() const
@@ -172,7 +211,7 @@ node_path_iterator node_path::begin() const
 
 node_path_iterator node_path::end() const
 {
-    return node_path_iterator{*this, names_.size()};
+    return node_path_iterator{*this, elements_.size()};
 }
 
 node_path node_path::parse(std::string_view str)
@@ -183,35 +222,39 @@ node_path node_path::parse(std::string_view str)
     {
         std::size_t offset = 0;
 
-        if(str[0] == '/')
+        if(str[0] == delimiter_char)
         {
             new_path.absolute_ = true;
             offset = 1;
         }
 
-        std::string buffer;
-        // Iterate over each character in string
+        // Slice the elements between delimiters
+        std::size_t element_begin = offset;
         for(std::size_t i = offset; i < str.size(); ++i)
         {
             if(str[i] == delimiter_char)
             {
-                new_path.names_.emplace_back(buffer);
-                buffer.clear();
-            }
-            else
-            {
-                buffer.push_back(str[i]);
+                new_path.elements_.push_back(element_range{static_cast<uint32_t>(element_begin),
+                                                           static_cast<uint32_t>(i - element_begin)});
+                element_begin = i + 1;
             }
         }
 
-        if(!buffer.empty())
+        if(element_begin < str.size())
         {
-            new_path.names_.emplace_back(buffer);
+            new_path.elements_.push_back(element_range{static_cast<uint32_t>(element_begin),
+                                                       static_cast<uint32_t>(str.size() - element_begin)});
         }
-        else if(!new_path.names_.empty())
+        else if(!new_path.elements_.empty())
         {
             new_path.trailing_delimiter_ = true;
+
+            // The trailing delimiter is not part of the text
+            str.remove_suffix(1);
         }
+
+        new_path.text_.assign(str.data(), str.size());
+        new_path.text_hash_ = ng::hash(str);
     }
 
     return new_path;
@@ -236,7 +279,7 @@ node_path_iterator::node_path_iterator()
 node_path_iterator& node_path_iterator::operator++()
 {
     assert(owner_);
-    assert(index_ < owner_->names_.size());
+    assert(index_ < owner_->elements_.size());
 
     ++index_;
 
@@ -283,20 +326,12 @@ bool node_path_iterator::operator!=(const node_path_iterator& other) const noexc
         || index_ != other.index_;
 }
 
-const safe_name& node_path_iterator::operator*() const noexcept
-{
-    assert(owner_);
-    assert(index_ < owner_->names_.size());
-
-    return owner_->names_[index_];
-}
-
-node_path_iterator::pointer node_path_iterator::operator->() const noexcept
+std::string_view node_path_iterator::operator*() const noexcept
 {
     assert(owner_);
-    assert(index_ < owner_->names_.size());
+    assert(index_ < owner_->elements_.size());
 
-    return &owner_->names_[index_];
+    return owner_->element(index_);
 }
 
 node_path_iterator::node_path_iterator(const node_path& path, std::size_t index)
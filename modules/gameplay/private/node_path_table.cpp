@@ -0,0 +1,67 @@
+#include "node_path_table.hpp"
+#include <cassert>
+
+namespace ng
+{
+
+interned_node_path::interned_node_path(const node_path* path) noexcept
+: path_{path}
+{
+
+}
+
+interned_node_path::interned_node_path() noexcept
+: path_{nullptr}
+{
+
+}
+
+const node_path& interned_node_path::path() const noexcept
+{
+    assert(path_);
+
+    return *path_;
+}
+
+uint64_t interned_node_path::hash() const noexcept
+{
+    return path_ ? path_->hash() : 0;
+}
+
+bool interned_node_path::empty() const noexcept
+{
+    return path_ == nullptr;
+}
+
+bool interned_node_path::operator==(const interned_node_path& other) const noexcept
+{
+    return path_ == other.path_;
+}
+
+bool interned_node_path::operator!=(const interned_node_path& other) const noexcept
+{
+    return path_ != other.path_;
+}
+
+interned_node_path node_path_table::intern(const node_path& path)
+{
+    return interned_node_path{&*paths_.insert(path).first};
+}
+
+interned_node_path node_path_table::find(const node_path& path) const
+{
+    auto it = paths_.find(path);
+    if(it == paths_.end())
+    {
+        return interned_node_path{};
+    }
+
+    return interned_node_path{&*it};
+}
+
+std::size_t node_path_table::size() const noexcept
+{
+    return paths_.size();
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+#include "node_pool.hpp"
+#include "node.hpp"
+
+#include <atomic>
+
+namespace ng
+{
+
+void pooled_node_deleter::operator()(node* n) const noexcept
+{
+    n->~node();
+    pool->free(memory);
+}
+
+std::size_t next_node_pool_index() noexcept
+{
+    static std::atomic<std::size_t> next_index{0};
+
+    return next_index++;
+}
+
+}
\ No newline at end of file
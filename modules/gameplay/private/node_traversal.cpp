@@ -0,0 +1,211 @@
+#include "node_traversal.hpp"
+#include "node2d.hpp"
+
+#include <cassert>
+
+namespace ng
+{
+
+namespace
+{
+
+node* deepest_first_child(node* n) noexcept
+{
+    while(node* first_child = n->first_child())
+    {
+        n = first_child;
+    }
+
+    return n;
+}
+
+}
+
+post_order_iterator::post_order_iterator() noexcept
+: current_node_{nullptr}
+, subtree_root_{nullptr}
+{
+
+}
+
+post_order_iterator::post_order_iterator(node* subtree_root) noexcept
+: current_node_{subtree_root ? deepest_first_child(subtree_root) : nullptr}
+, subtree_root_{subtree_root}
+{
+
+}
+
+post_order_iterator::pointer post_order_iterator::operator->() const noexcept
+{
+    return current_node_;
+}
+
+post_order_iterator::reference post_order_iterator::operator*() const noexcept
+{
+    assert(current_node_);
+
+    return *current_node_;
+}
+
+post_order_iterator& post_order_iterator::operator++() noexcept
+{
+    assert(current_node_);
+
+    if(current_node_ == subtree_root_)
+    {
+        current_node_ = nullptr;
+    }
+    // The children of the next sibling are visited before it
+    else if(node* next_sibling = current_node_->next_sibling())
+    {
+        current_node_ = deepest_first_child(next_sibling);
+    }
+    // Every children were visited, now visit the parent
+    else
+    {
+        current_node_ = current_node_->parent();
+    }
+
+    return *this;
+}
+
+post_order_iterator post_order_iterator::operator++(int) noexcept
+{
+    post_order_iterator tmp = *this;
+
+    ++(*this);
+
+    return tmp;
+}
+
+bool post_order_iterator::operator==(const post_order_iterator& other) const noexcept
+{
+    return current_node_ == other.current_node_;
+}
+
+bool post_order_iterator::operator!=(const post_order_iterator& other) const noexcept
+{
+    return current_node_ != other.current_node_;
+}
+
+breadth_first_iterator::breadth_first_iterator() noexcept
+: queue_{nullptr}
+, current_index_{0}
+{
+
+}
+
+breadth_first_iterator::breadth_first_iterator(node* subtree_root, std::vector<node*>& queue)
+: queue_{&queue}
+, current_index_{0}
+{
+    queue.clear();
+
+    if(subtree_root)
+    {
+        queue.push_back(subtree_root);
+    }
+    else
+    {
+        queue_ = nullptr;
+    }
+}
+
+breadth_first_iterator::pointer breadth_first_iterator::operator->() const noexcept
+{
+    return (*queue_)[current_index_];
+}
+
+breadth_first_iterator::reference breadth_first_iterator::operator*() const noexcept
+{
+    assert(queue_);
+
+    return *(*queue_)[current_index_];
+}
+
+breadth_first_iterator& breadth_first_iterator::operator++()
+{
+    assert(queue_);
+
+    for(node* child = (*queue_)[current_index_]->first_child(); child; child = child->next_sibling())
+    {
+        queue_->push_back(child);
+    }
+
+    ++current_index_;
+
+    // Every queued node was visited
+    if(current_index_ == queue_->size())
+    {
+        queue_ = nullptr;
+        current_index_ = 0;
+    }
+
+    return *this;
+}
+
+bool breadth_first_iterator::operator==(const breadth_first_iterator& other) const noexcept
+{
+    return queue_ == other.queue_ && current_index_ == other.current_index_;
+}
+
+bool breadth_first_iterator::operator!=(const breadth_first_iterator& other) const noexcept
+{
+    return !(*this == other);
+}
+
+node_range<pre_order_iterator> pre_order(node* subtree_root) noexcept
+{
+    return node_range<pre_order_iterator>{node_tree::begin(subtree_root), pre_order_iterator{}};
+}
+
+node_range<post_order_iterator> post_order(node* subtree_root) noexcept
+{
+    return node_range<post_order_iterator>{post_order_iterator{subtree_root}, post_order_iterator{}};
+}
+
+node_range<breadth_first_iterator> breadth_first(node* subtree_root, std::vector<node*>& queue)
+{
+    return node_range<breadth_first_iterator>{breadth_first_iterator{subtree_root, queue}, breadth_first_iterator{}};
+}
+
+void cull(node* subtree_root, const aabb2d& region, std::vector<node*>& pending, std::vector<node2d*>& found)
+{
+    assert(subtree_root);
+
+    const transform_store& transforms = subtree_root->owner()->transforms();
+    const std::vector<aabb2d>& world_bounds = transforms.world_bounds();
+    const std::vector<aabb2d>& subtree_bounds = transforms.subtree_bounds();
+
+    pending.clear();
+    pending.push_back(subtree_root);
+
+    while(!pending.empty())
+    {
+        node* current = pending.back();
+        pending.pop_back();
+
+        if(current->is_a<node2d>())
+        {
+            const transform_store::slot_type slot = static_cast<node2d*>(current)->transform_slot();
+
+            // Nodes without bounds are never visible, only their children can be
+            if(!world_bounds[slot].empty() && world_bounds[slot].intersects(region))
+            {
+                found.push_back(static_cast<node2d*>(current));
+            }
+
+            if(subtree_bounds[slot].empty() || !subtree_bounds[slot].intersects(region))
+            {
+                continue;
+            }
+        }
+
+        for(node* child = current->first_child(); child; child = child->next_sibling())
+        {
+            pending.push_back(child);
+        }
+    }
+}
+
+}
\ No newline at end of file
@@ -1,20 +1,90 @@
 #include "node_tree.hpp"
 #include "node.hpp"
+#include "node2d.hpp"
 #include "node_path.hpp"
+#include "prefab.hpp"
+#include "node_type_registry.hpp"
+#include "scene_file.hpp"
+#include "scene_loader.hpp"
+#include "node_command_buffer.hpp"
+#include "node_tree_snapshot.hpp"
 #include <cassert>
 #include <algorithm>
+#include <functional>
+#include <limits>
 
 namespace ng
 {
 
+namespace
+{
+
+/**
+ * Find the node after current in depth first pre-order
+ * @param current The current node
+ * @param subtree_root The node where the iteration started
+ * @return The next node or nullptr after the last descendant of subtree_root
+ */
+node* next_in_pre_order(node* current, const node* subtree_root) noexcept
+{
+    if(node* first_child = current->first_child())
+    {
+        return first_child;
+    }
+
+    // Go back up until a parent has a sibling left to visit
+    while(current != subtree_root)
+    {
+        if(node* next_sibling = current->next_sibling())
+        {
+            return next_sibling;
+        }
+
+        current = current->parent();
+    }
+
+    return nullptr;
+}
+
+/**
+ * Combine the hash of a resolved path key
+ * @param start The node where the path starts
+ * @param path The path to resolve
+ * @param names_start true when the first element of the path is the name of the start node
+ * @return The hash of the key
+ */
+std::size_t hash_resolved_path(const node* start, const node_path& path, bool names_start) noexcept
+{
+    std::size_t hash = std::hash<const node*>{}(start);
+    const auto combine = [&hash](std::size_t value)
+    {
+        hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    };
+
+    combine(names_start);
+    combine(static_cast<std::size_t>(path.hash()));
+
+    return hash;
+}
+
+// Scripts could generate an unbounded number of paths
+constexpr std::size_t max_resolved_paths = 4096;
+
+// A cancelled load stops after the batch being created
+constexpr std::size_t load_batch_size = 4096;
+
+}
+
 node_tree_iterator::node_tree_iterator() noexcept
 : current_node_{nullptr}
+, subtree_root_{nullptr}
 {
 
 }
 
-node_tree_iterator::node_tree_iterator(node* current_node)
-: current_node_{current_node}
+node_tree_iterator::node_tree_iterator(node* subtree_root)
+: current_node_{subtree_root}
+, subtree_root_{subtree_root}
 {
 
 }
@@ -35,42 +105,7 @@ node_tree_iterator& node_tree_iterator::operator++()
 {
     assert(current_node_);
 
-    // Check if current node has a sibling, if it is the case, iterate over the sibling
-    auto next_sibling = current_node_->next_sibling();
-    if(next_sibling != nullptr)
-    {
-        current_node_ = next_sibling;
-    }
-    // We have iterated on every sibling nodes
-    // Now we need to move into the children
-    else if(!current_node_->root())
-    {
-        node* parent_node = current_node_->parent();
-        node* first_sibling_with_children = parent_node->first_child();
-
-        // Reset current node, so we can handle the case where no sibling has children
-        current_node_ = nullptr;
-
-        while(first_sibling_with_children)
-        {
-            if(first_sibling_with_children->leaf())
-            {
-                first_sibling_with_children = first_sibling_with_children->next_sibling();
-            }
-            else
-            {
-                current_node_ = first_sibling_with_children->first_child();
-
-                // Stop iteration here
-                first_sibling_with_children = nullptr;
-            }
-        }
-    }
-    // Otherwise, we reach the end
-    else
-    {
-        current_node_ = current_node_->first_child();
-    }
+    current_node_ = next_in_pre_order(current_node_, subtree_root_);
 
     return *this;
 }
@@ -96,12 +131,14 @@ bool node_tree_iterator::operator!=(const node_tree_iterator& other) const noexc
 
 const_node_tree_iterator::const_node_tree_iterator() noexcept
 : current_node_{nullptr}
+, subtree_root_{nullptr}
 {
 
 }
 
-const_node_tree_iterator::const_node_tree_iterator(node* current_node)
-: current_node_{current_node}
+const_node_tree_iterator::const_node_tree_iterator(node* subtree_root)
+: current_node_{subtree_root}
+, subtree_root_{subtree_root}
 {
 
 }
@@ -122,63 +159,349 @@ const_node_tree_iterator& const_node_tree_iterator::operator++()
 {
     assert(current_node_);
 
-    // Check if current node has a sibling, if it is the case, iterate over the sibling
-    auto next_sibling = current_node_->next_sibling();
-    if(next_sibling != nullptr)
+    current_node_ = next_in_pre_order(current_node_, subtree_root_);
+
+    return *this;
+}
+
+const_node_tree_iterator const_node_tree_iterator::operator++(int)
+{
+    const_node_tree_iterator tmp = *this;
+
+    ++(*this);
+
+    return tmp;
+}
+
+bool const_node_tree_iterator::operator==(const const_node_tree_iterator& other) const noexcept
+{
+    return current_node_ == other.current_node_;
+}
+
+bool const_node_tree_iterator::operator!=(const const_node_tree_iterator& other) const noexcept
+{
+    return current_node_ != other.current_node_;
+}
+
+node_tree::node_tree()
+: transforms_()
+, events_()
+, scheduler_()
+, spatial_()
+, components_()
+, decorators_()
+, pools_()
+, adopted_pools_()
+, nodes_()
+, root_{nullptr}
+, collection_state_{collection_states::idle}
+, mark_epoch_{0}
+, gray_nodes_()
+, sweep_index_{0}
+, structure_version_{0}
+, snapshots_()
+, resolved_paths_()
+, instance_nodes_()
+{
+
+}
+
+node_tree::~node_tree()
+{
+    // The recorded nodes are destroyed with the tree, the snapshots must not restore them
+    for(node_tree_snapshot* snapshot : snapshots_)
     {
-        current_node_ = next_sibling;
+        snapshot->tree_ = nullptr;
+        snapshot->clear();
     }
-        // We have iterated on every sibling nodes
-        // Now we need to move into the children
-    else if(!current_node_->root())
+}
+
+void node_tree::shade(node* n)
+{
+    if(n->mark_epoch_ != mark_epoch_)
     {
-        node* parent_node = current_node_->parent();
-        node* first_sibling_with_children = parent_node->first_child();
+        n->mark_epoch_ = mark_epoch_;
+        gray_nodes_.push_back(n);
+    }
+}
 
-        // Reset current node, so we can handle the case where no sibling has children
-        current_node_ = nullptr;
+void node_tree::on_child_attached(const node* parent, node* child)
+{
+    // Without this barrier, a child moved under a parent that was already visited would never be marked
+    if(collection_state_ != collection_states::marking || parent->mark_epoch_ == mark_epoch_)
+    {
+        keep_while_collecting(child);
+    }
+}
 
-        while(first_sibling_with_children)
+void node_tree::keep_while_collecting(node* n)
+{
+    if(collection_state_ == collection_states::marking)
+    {
+        shade(n);
+    }
+    else if(collection_state_ == collection_states::sweeping)
+    {
+        // Marking is over, the whole subtree is marked at once or the sweep would free the nodes below
+        shade(n);
+        while(!gray_nodes_.empty())
         {
-            if(first_sibling_with_children->leaf())
+            node* gray = gray_nodes_.back();
+            gray_nodes_.pop_back();
+
+            for(node* child = gray->first_child_; child; child = child->next_sibling_)
             {
-                first_sibling_with_children = first_sibling_with_children->next_sibling();
+                shade(child);
             }
-            else
+        }
+    }
+}
+
+uint64_t node_tree::next_structure_version() noexcept
+{
+    return ++structure_version_;
+}
+
+node* node_tree::resolve(node* start, const node_path& path, bool names_start) const
+{
+    const std::size_t key = hash_resolved_path(start, path, names_start);
+
+    auto it = resolved_paths_.find(key);
+    if(it != resolved_paths_.end())
+    {
+        const resolved_path& resolved = it->second;
+        if(resolved.start == start && resolved.names_start == names_start && resolved.path == path)
+        {
+            // Each node of the route is only read after its previous node was found unchanged, so it still exists
+            bool route_changed = false;
+            for(const auto& [route_node, version] : resolved.route)
             {
-                current_node_ = first_sibling_with_children->first_child();
+                if(route_node->structure_version_ != version)
+                {
+                    route_changed = true;
+                    break;
+                }
+            }
 
-                // Stop iteration here
-                first_sibling_with_children = nullptr;
+            if(!route_changed)
+            {
+                return resolved.found;
             }
         }
     }
-        // Otherwise, we reach the end
     else
     {
-        current_node_ = current_node_->first_child();
+        if(resolved_paths_.size() >= max_resolved_paths)
+        {
+            resolved_paths_.clear();
+        }
+
+        it = resolved_paths_.emplace(key, resolved_path{}).first;
+    }
+
+    resolved_path& resolved = it->second;
+    resolved.start = start;
+    resolved.path = path;
+    resolved.names_start = names_start;
+    resolved.found = nullptr;
+    resolved.route.clear();
+
+    constexpr std::string_view parent_node{".."};
+
+    const node_path normalized_path = path.normalize();
+    auto name_it = normalized_path.begin();
+
+    // The start node is part of the route because its name or its parent could change
+    resolved.route.emplace_back(start, start->structure_version_);
+
+    if(names_start)
+    {
+        const char* start_name = start->name().c_str();
+        if(name_it == normalized_path.end() || !start_name || *name_it != start_name)
+        {
+            return nullptr;
+        }
+
+        ++name_it;
     }
 
-    return *this;
+    node* current = start;
+    for(; name_it != normalized_path.end(); ++name_it)
+    {
+        if(*name_it == parent_node)
+        {
+            current = current->parent_;
+        }
+        else
+        {
+            current = current->find_child(*name_it);
+        }
+
+        // The route is kept to know when the path could exist
+        if(!current)
+        {
+            return nullptr;
+        }
+
+        if(std::next(name_it) != normalized_path.end())
+        {
+            resolved.route.emplace_back(current, current->structure_version_);
+        }
+    }
+
+    resolved.found = current;
+
+    return current;
 }
 
-const_node_tree_iterator const_node_tree_iterator::operator++(int)
+void node_tree::begin_collection()
 {
-    const_node_tree_iterator tmp = *this;
+    ++mark_epoch_;
+    gray_nodes_.clear();
 
-    ++(*this);
+    if(root_)
+    {
+        // A root attached to another node keeps the whole hierarchy above it alive
+        node* top = root_;
+        while(top->parent_)
+        {
+            top = top->parent_;
+        }
 
-    return tmp;
+        shade(top);
+    }
+
+    collection_state_ = collection_states::marking;
 }
 
-bool const_node_tree_iterator::operator==(const const_node_tree_iterator& other) const noexcept
+bool node_tree::mark_until(frame_clock::time_point deadline)
 {
-    return current_node_ == other.current_node_;
+    // Checking the clock is slower than marking a few nodes
+    constexpr std::size_t nodes_between_clock_checks = 256;
+
+    std::size_t marked_count = 0;
+    do
+    {
+        while(!gray_nodes_.empty())
+        {
+            node* n = gray_nodes_.back();
+            gray_nodes_.pop_back();
+
+            for(node* child = n->first_child_; child; child = child->next_sibling_)
+            {
+                shade(child);
+            }
+
+            if(++marked_count % nodes_between_clock_checks == 0 && frame_clock::now() >= deadline
+               && !gray_nodes_.empty())
+            {
+                return false;
+            }
+        }
+
+        // Shaded last, a snapshot taken during the collection can record nodes detached before they were marked
+        shade_snapshots();
+    }
+    while(!gray_nodes_.empty());
+
+    return true;
 }
 
-bool const_node_tree_iterator::operator!=(const const_node_tree_iterator& other) const noexcept
+void node_tree::shade_snapshots()
 {
-    return current_node_ != other.current_node_;
+    for(const node_tree_snapshot* snapshot : snapshots_)
+    {
+        for(const node_tree_snapshot::node_record& record : snapshot->nodes_)
+        {
+            shade(record.n);
+        }
+
+        // Slots are matched by node, a freed node2d could be mistaken for a new one at the same address
+        for(node2d* n : snapshot->transform_nodes_)
+        {
+            if(n)
+            {
+                shade(n);
+            }
+        }
+    }
+}
+
+void node_tree::register_snapshot(node_tree_snapshot* snapshot) const
+{
+    assert(std::find(snapshots_.begin(), snapshots_.end(), snapshot) == snapshots_.end());
+
+    snapshots_.push_back(snapshot);
+}
+
+void node_tree::forget_snapshot(const node_tree_snapshot* snapshot) const noexcept
+{
+    const auto found = std::find(snapshots_.begin(), snapshots_.end(), snapshot);
+    assert(found != snapshots_.end());
+
+    // The order of the snapshots doesn't matter
+    *found = snapshots_.back();
+    snapshots_.pop_back();
+}
+
+bool node_tree::sweep_until(frame_clock::time_point deadline)
+{
+    constexpr std::size_t nodes_between_clock_checks = 256;
+
+    std::size_t swept_count = 0;
+    for(; sweep_index_ > 0; --sweep_index_)
+    {
+        // Nodes after the sweep index are already swept or were created during the collection, so they are marked
+        owned_node& swept_node = nodes_[sweep_index_ - 1];
+        if(swept_node->mark_epoch_ != mark_epoch_)
+        {
+            // Nodes created during the collection could have been attached to an unreachable node. Unreachable
+            // children can be swept after this node, they must not point to it anymore
+            for(node* child = swept_node->first_child_; child;)
+            {
+                node* next_child = child->next_sibling_;
+
+                if(child->mark_epoch_ == mark_epoch_)
+                {
+                    swept_node->detach_child(child);
+                }
+                else
+                {
+                    child->parent_ = nullptr;
+                    child->next_sibling_ = nullptr;
+                    child->previous_sibling_ = nullptr;
+                }
+
+                child = next_child;
+            }
+
+            // The parent of an unreachable node is unreachable too and can be swept after it, nodes attached to a
+            // reachable parent while sweeping were marked
+            if(node* parent = swept_node->parent_)
+            {
+                parent->unlink_child(swept_node.get());
+            }
+
+            std::swap(swept_node, nodes_.back());
+            nodes_.pop_back();
+        }
+
+        if(++swept_count % nodes_between_clock_checks == 0 && frame_clock::now() >= deadline)
+        {
+            --sweep_index_;
+            return sweep_index_ == 0;
+        }
+    }
+
+    // Pools of merged trees are dropped once all their nodes were freed
+    const auto empty_pool = [](const std::unique_ptr<node_pool>& pool)
+    {
+        return pool->size() == 0;
+    };
+
+    adopted_pools_.erase(std::remove_if(adopted_pools_.begin(), adopted_pools_.end(), empty_pool), adopted_pools_.end());
+
+    return true;
 }
 
 void node_tree::set_root(node* root) noexcept
@@ -187,6 +510,8 @@ void node_tree::set_root(node* root) noexcept
     assert(root->owner_ == this);
 
     root_ = root;
+
+    keep_while_collecting(root_);
 }
 
 const node* node_tree::root() const noexcept
@@ -206,55 +531,880 @@ bool node_tree::contains(const node* n) const noexcept
 
 bool node_tree::reachable(const node* n) const noexcept
 {
-    return std::any_of(begin(), end(),
-                       [n](const node& reachable_node) { return &reachable_node == n; });
+    for(const node* parent = n; parent; parent = parent->parent_)
+    {
+        if(parent == root_)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+node* node_tree::find(const node_path& path) const
+{
+    if(!root_)
+    {
+        return nullptr;
+    }
+
+    // When using a relative path, the first name is the name of the root
+    return resolve(root_, path, !path.absolute());
 }
 
-node* node_tree::find(const node_path& path) const noexcept
+node* node_tree::find(const node_path& path, node* from) const
 {
-    node* current = nullptr;
+    assert(from);
 
     // When using an absolute path, search from the root
     if(path.absolute())
     {
-        current = root_;
+        return find(path);
     }
 
-    // We iterate over each parts of the name
-    for(const safe_name& name : path)
+    return resolve(from, path, false);
+}
+
+void node_tree::free_unreachable_nodes()
+{
+    begin_collection();
+    mark_until(frame_clock::time_point::max());
+
+    sweep_index_ = nodes_.size();
+    sweep_until(frame_clock::time_point::max());
+
+    collection_state_ = collection_states::idle;
+}
+
+bool node_tree::free_unreachable_nodes(frame_duration budget)
+{
+    const frame_clock::time_point deadline = frame_clock::now() + std::chrono::duration_cast<frame_clock::duration>(budget);
+
+    if(collection_state_ == collection_states::idle)
     {
-        if(current == nullptr && root_->name() == name)
-        {
-            current = root_;
-            continue;
-        }
+        begin_collection();
+    }
 
-        // We found a child with the required name, start searching its children for the rest of the path
-        if(node* found_child = current->find_child(name))
-        {
-            current = found_child;
-        }
-        // No children were found for this path, return nullptr
-        else
+    if(collection_state_ == collection_states::marking)
+    {
+        if(!mark_until(deadline))
         {
-            return nullptr;
+            return false;
         }
+
+        sweep_index_ = nodes_.size();
+        collection_state_ = collection_states::sweeping;
     }
 
-    return current;
+    if(!sweep_until(deadline))
+    {
+        return false;
+    }
+
+    collection_state_ = collection_states::idle;
+
+    return true;
 }
 
-void node_tree::free_unreachable_nodes()
+bool node_tree::collecting() const noexcept
+{
+    return collection_state_ != collection_states::idle;
+}
+
+void node_tree::reserve_nodes(std::size_t count)
+{
+    // Spawning many subtrees reserves often, the storage grows geometrically to avoid reallocating every time
+    if(nodes_.size() + count > nodes_.capacity())
+    {
+        nodes_.reserve(std::max(nodes_.size() + count, nodes_.capacity() * 2));
+    }
+}
+
+template<typename Construct>
+void node_tree::create_linked_nodes(std::size_t begin, std::size_t end, const uint32_t* parents, Construct&& construct)
 {
-    for(std::size_t i = nodes_.size(); i > 0; --i)
+    assert(end <= instance_nodes_.size());
+
+    // Parents are created before their children and the names of siblings are known to be different
+    for(std::size_t i = begin; i < end; ++i)
     {
-        // If the node is not reachable
-        if(!reachable(nodes_[i].get()))
+        node* n = construct(i);
+        if(i > 0)
         {
-            std::swap(nodes_[i], nodes_.back());
-            nodes_.pop_back();
+            instance_nodes_[parents[i]]->link_child(n);
+            n->parent_changed();
         }
+
+        instance_nodes_[i] = n;
+    }
+}
+
+node* node_tree::instantiate(const prefab& source, node* parent)
+{
+    assert(!source.empty());
+
+    return instantiate(source, source.names_.front(), parent);
+}
+
+node* node_tree::instantiate(const prefab& source, safe_name root_name, node* parent)
+{
+    assert(!source.empty());
+    assert(!parent || parent->owner_ == this);
+
+    reserve_nodes(source.size());
+
+    for(const prefab::node_type_count& type : source.node_types_)
+    {
+        type.reserve(*this, type.count);
     }
+
+    transforms_.reserve(source.node2d_indices_.size());
+
+    instance_nodes_.resize(source.size());
+    create_linked_nodes(0, source.size(), source.parents_.data(), [this, &source, &root_name](std::size_t i)
+    {
+        return source.constructors_[i](*this, i == 0 ? root_name : source.names_[i]);
+    });
+
+    for(std::size_t i = 0; i < source.node2d_indices_.size(); ++i)
+    {
+        auto n = static_cast<node2d*>(instance_nodes_[source.node2d_indices_[i]]);
+
+        transforms_.set_local_transform(n->transform_slot(), source.local_transforms_[i], source.local_affines_[i]);
+        if(!source.local_bounds_[i].empty())
+        {
+            n->set_local_bounds(source.local_bounds_[i]);
+        }
+    }
+
+    node* root = instance_nodes_[0];
+    if(parent)
+    {
+        parent->attach_child(root);
+    }
+
+    return root;
+}
+
+node* node_tree::load(const scene_view& scene, const node_type_registry& types, node* parent,
+                      scene_load_progress* progress)
+{
+    assert(!parent || parent->owner_ == this);
+
+    const std::size_t count = scene.node_count();
+    const uint32_t* node_types = scene.node_types();
+    const uint32_t* node_names = scene.node_names();
+
+    // Types and names are resolved once, the nodes refer to them by index
+    std::vector<const node_type_registry::node_type*> scene_types(scene.type_count());
+    for(uint32_t type = 0; type < scene.type_count(); ++type)
+    {
+        scene_types[type] = types.find(name{scene.string(scene.type_names()[type])});
+        if(!scene_types[type])
+        {
+            throw scene_file_error{"unknown node type"};
+        }
+    }
+
+    std::vector<std::size_t> type_counts(scene.type_count(), 0);
+    std::size_t node2d_count = 0;
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        ++type_counts[node_types[i]];
+        if(scene_types[node_types[i]]->is_node2d)
+        {
+            ++node2d_count;
+        }
+    }
+
+    // Each node2d reads the next transform, the scene must have one for each of them
+    if(node2d_count != scene.node2d_count())
+    {
+        throw scene_file_error{"invalid node2d count"};
+    }
+
+    std::vector<name> names;
+    names.reserve(scene.string_count());
+    for(uint32_t i = 0; i < scene.string_count(); ++i)
+    {
+        names.emplace_back(scene.string(i));
+    }
+
+    reserve_nodes(count);
+
+    for(uint32_t type = 0; type < scene.type_count(); ++type)
+    {
+        scene_types[type]->reserve(*this, type_counts[type]);
+    }
+
+    transforms_.reserve(node2d_count);
+
+    if(progress)
+    {
+        progress->start(count);
+    }
+
+    instance_nodes_.resize(count);
+    for(std::size_t begin = 0; begin < count; begin += load_batch_size)
+    {
+        if(progress && progress->cancelled())
+        {
+            return nullptr;
+        }
+
+        const std::size_t end = std::min(count, begin + load_batch_size);
+        create_linked_nodes(begin, end, scene.node_parents(), [&](std::size_t i)
+        {
+            return scene_types[node_types[i]]->construct(*this, names[node_names[i]]);
+        });
+
+        if(progress)
+        {
+            progress->set_created_nodes(end);
+        }
+    }
+
+    std::size_t node2d_index = 0;
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        if(!scene_types[node_types[i]]->is_node2d)
+        {
+            continue;
+        }
+
+        auto n = static_cast<node2d*>(instance_nodes_[i]);
+        const scene_transform& transform = scene.transforms()[node2d_index];
+        const scene_bounds& bounds = scene.bounds()[node2d_index];
+        ++node2d_index;
+
+        transforms_.set_local_transform(n->transform_slot(), transform2d{glm::vec2{transform.translation_x, transform.translation_y},
+                                                                         transform.rotation,
+                                                                         glm::vec2{transform.scale_x, transform.scale_y}});
+
+        const aabb2d local_bounds{glm::vec2{bounds.min_x, bounds.min_y}, glm::vec2{bounds.max_x, bounds.max_y}};
+        if(!local_bounds.empty())
+        {
+            n->set_local_bounds(local_bounds);
+        }
+    }
+
+    node* root = instance_nodes_[0];
+    if(parent)
+    {
+        parent->attach_child(root);
+    }
+
+    return root;
+}
+
+node* node_tree::merge(node_tree& other, node* parent)
+{
+    assert(&other != this);
+    assert(!other.collecting());
+    assert(!parent || parent->owner_ == this);
+
+    // node2d and their spatial entries are given their new slot and entry
+    transforms_.append(other.transforms_);
+    spatial_.append(other.spatial_);
+
+    // Routes resolved in this tree never went through the moved nodes, a single new version is enough
+    const uint64_t version = next_structure_version();
+
+    for(const owned_node& moved : other.nodes_)
+    {
+        node* n = moved.get();
+        assert(!n->event_listener_ && !n->tick_registered_);
+        assert(n->component_archetype_ == component_store::no_archetype);
+
+        n->owner_ = this;
+        n->structure_version_ = version;
+
+        // Moved while collecting, the nodes survive the collection like created nodes
+        n->mark_epoch_ = mark_epoch_;
+    }
+
+    // Keys are node addresses, they don't change when the nodes move to this tree
+    decorators_.merge(other.decorators_);
+    assert(other.decorators_.empty());
+
+    // The order of the nodes only matters to a sweep in progress
+    if(!collecting() && nodes_.size() < other.nodes_.size())
+    {
+        nodes_.swap(other.nodes_);
+    }
+
+    reserve_nodes(other.nodes_.size());
+    nodes_.insert(nodes_.end(), std::make_move_iterator(other.nodes_.begin()), std::make_move_iterator(other.nodes_.end()));
+    other.nodes_.clear();
+
+    // The moved nodes give back their memory to the pools of the other tree
+    for(std::unique_ptr<node_pool>& pool : other.pools_)
+    {
+        if(pool)
+        {
+            adopted_pools_.push_back(std::move(pool));
+        }
+    }
+
+    other.pools_.clear();
+
+    // Nodes merged in the other tree before came with their own pools
+    for(std::unique_ptr<node_pool>& pool : other.adopted_pools_)
+    {
+        adopted_pools_.push_back(std::move(pool));
+    }
+
+    other.adopted_pools_.clear();
+    other.resolved_paths_.clear();
+
+    node* root = std::exchange(other.root_, nullptr);
+    if(root && parent)
+    {
+        parent->attach_child(root);
+    }
+
+    return root;
+}
+
+void node_tree::apply(node_command_buffer& buffer)
+{
+    apply(&buffer, 1);
+}
+
+void node_tree::apply(std::vector<node_command_buffer>& buffers)
+{
+    apply(buffers.data(), buffers.size());
+}
+
+void node_tree::apply(node_command_buffer* buffers, std::size_t count)
+{
+    using node_handle = node_command_buffer::node_handle;
+
+    std::size_t created_count = 0;
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        created_count += buffers[i].created_nodes_.size();
+    }
+
+    reserve_nodes(created_count);
+
+    // Created nodes come first, any command can use them
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        node_command_buffer& buffer = buffers[i];
+
+        buffer.applied_nodes_.clear();
+        buffer.applied_nodes_.reserve(buffer.created_nodes_.size());
+
+        for(const node_command_buffer::created_node& created : buffer.created_nodes_)
+        {
+            node* n = created.construct(*this, created.name);
+            if(created.has_transform)
+            {
+                static_cast<node2d*>(n)->set_local_transform(created.local_transform);
+            }
+
+            buffer.applied_nodes_.push_back(n);
+        }
+    }
+
+    // Commands are kept in the order of the buffers, then in the order they were recorded
+    structure_moves_.clear();
+
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        node_command_buffer& buffer = buffers[i];
+
+        const auto resolve = [&buffer](const node_handle& handle) noexcept
+        {
+            return handle.created() ? buffer.applied_nodes_[handle.created_index_] : handle.node_;
+        };
+
+        for(const node_command_buffer::move_command& command : buffer.commands_)
+        {
+            node* child = resolve(command.child);
+            assert(child && child->owner_ == this);
+
+            structure_moves_.push_back(structure_move{child, resolve(command.parent), structure_moves_.size(), 0});
+        }
+
+        buffer.clear();
+    }
+
+    // Only the last command of each node is kept, sorting is cheaper than hashing every node
+    const auto by_child = [](const structure_move& lhs, const structure_move& rhs) noexcept
+    {
+        return lhs.child != rhs.child ? std::less<node*>{}(lhs.child, rhs.child) : lhs.order < rhs.order;
+    };
+
+    moves_by_child_.assign(structure_moves_.begin(), structure_moves_.end());
+    std::sort(moves_by_child_.begin(), moves_by_child_.end(), by_child);
+
+    std::size_t kept_count = 0;
+    for(std::size_t i = 0; i < moves_by_child_.size(); ++i)
+    {
+        if(i + 1 == moves_by_child_.size() || moves_by_child_[i + 1].child != moves_by_child_[i].child)
+        {
+            moves_by_child_[kept_count++] = moves_by_child_[i];
+        }
+        else
+        {
+            structure_moves_[moves_by_child_[i].order].child = nullptr;
+        }
+    }
+
+    moves_by_child_.resize(kept_count);
+
+    // Detached nodes free their names before any node is attached
+    for(const structure_move& move : structure_moves_)
+    {
+        if(move.child && !move.parent && move.child->parent_)
+        {
+            move.child->parent_->detach_child(move.child);
+        }
+    }
+
+    // Parents are numbered in the order they first appear, the moves don't depend on where the nodes are allocated
+    structure_groups_.clear();
+    parent_groups_.clear();
+
+    const node* previous_parent = nullptr;
+    std::size_t previous_group = 0;
+    for(structure_move& move : structure_moves_)
+    {
+        if(!move.child || !move.parent)
+        {
+            continue;
+        }
+
+        // Commands of a buffer usually move several nodes to the same parent
+        if(move.parent != previous_parent)
+        {
+            const auto [group, inserted] = parent_groups_.try_emplace(move.parent, structure_groups_.size());
+            if(inserted)
+            {
+                structure_groups_.push_back(structure_group{0, 0});
+            }
+
+            previous_parent = move.parent;
+            previous_group = group->second;
+        }
+
+        move.group = previous_group;
+        ++structure_groups_[move.group].end;
+    }
+
+    // Stable counting sort of the moves by parent
+    std::size_t grouped_count = 0;
+    for(structure_group& group : structure_groups_)
+    {
+        group.begin = grouped_count;
+        grouped_count += std::exchange(group.end, grouped_count);
+    }
+
+    grouped_moves_.resize(grouped_count);
+    for(const structure_move& move : structure_moves_)
+    {
+        if(move.child && move.parent)
+        {
+            grouped_moves_[structure_groups_[move.group].end++] = move;
+        }
+    }
+
+    const auto find_move = [this](const node* child) noexcept -> const structure_move*
+    {
+        const auto move = std::lower_bound(moves_by_child_.begin(), moves_by_child_.end(), child,
+                                           [](const structure_move& lhs, const node* rhs) noexcept
+                                           {
+                                               return std::less<const node*>{}(lhs.child, rhs);
+                                           });
+
+        return move != moves_by_child_.end() && move->child == child ? &*move : nullptr;
+    };
+
+    // The children of a parent are attached together so the parent changes only once
+    for(const structure_group& group : structure_groups_)
+    {
+        node* parent = grouped_moves_[group.begin].parent;
+
+        bool parent_changed = false;
+        for(std::size_t i = group.begin; i < group.end; ++i)
+        {
+            node* child = grouped_moves_[i].child;
+            if(child->parent_ == parent)
+            {
+                continue;
+            }
+
+            // A sibling leaving the parent later in the batch gives its name to the child
+            if(node* sibling = parent->find_child(child->name()))
+            {
+                const structure_move* sibling_move = find_move(sibling);
+                if(!sibling_move || sibling_move->parent == parent)
+                {
+                    throw invalid_node_name{child->name()};
+                }
+
+                parent->detach_child(sibling);
+            }
+
+            // Nodes keep their parent until they are attached to the new one, like attach_child
+            if(node* current_parent = child->parent_)
+            {
+                current_parent->detach_child(child);
+            }
+
+            if(!parent_changed)
+            {
+                parent->on_structure_changed();
+                parent_changed = true;
+            }
+
+            on_child_attached(parent, child);
+            parent->link_child(child);
+
+            child->on_structure_changed();
+            child->parent_changed();
+        }
+    }
+}
+
+void node_tree::snapshot(node_tree_snapshot& snapshot) const
+{
+    using node_record = node_tree_snapshot::node_record;
+
+    // Local transforms change every frame, they are always copied
+    snapshot.transform_nodes_ = transforms_.nodes();
+    snapshot.local_translations_ = transforms_.local_translations();
+    snapshot.local_rotations_ = transforms_.local_rotations();
+    snapshot.local_scales_ = transforms_.local_scales();
+
+    // Unmarked nodes are freed by the ongoing sweep, they are not recorded
+    if(collection_state_ == collection_states::sweeping)
+    {
+        for(node2d*& n : snapshot.transform_nodes_)
+        {
+            if(n && n->mark_epoch_ != mark_epoch_)
+            {
+                n = nullptr;
+            }
+        }
+    }
+
+    if(snapshot.tree_ == this && snapshot.root_ == root_ && snapshot.structure_version_ == structure_version_)
+    {
+        return;
+    }
+
+    if(snapshot.tree_ != this)
+    {
+        if(snapshot.tree_)
+        {
+            snapshot.tree_->forget_snapshot(&snapshot);
+        }
+
+        register_snapshot(&snapshot);
+    }
+
+    snapshot.tree_ = this;
+    snapshot.root_ = root_;
+    snapshot.structure_version_ = structure_version_;
+
+    // Records are overwritten in place, a name is only assigned when it changed since the last snapshot
+    std::vector<node_record>& records = snapshot.nodes_;
+    std::size_t count = 0;
+
+    const auto record = [&records, &count](node* n, uint32_t parent)
+    {
+        if(count == records.size())
+        {
+            records.push_back(node_record{n, n->name_, parent, 0, 0});
+        }
+        else
+        {
+            records[count].n = n;
+            records[count].parent = parent;
+            if(records[count].name != n->name_)
+            {
+                records[count].name = n->name_;
+            }
+        }
+
+        ++count;
+    };
+
+    if(root_)
+    {
+        record(root_, 0);
+    }
+
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        const node* parent = records[i].n;
+        assert(count + parent->child_count_ <= std::numeric_limits<uint32_t>::max());
+
+        records[i].first_child = static_cast<uint32_t>(count);
+        records[i].child_count = static_cast<uint32_t>(parent->child_count_);
+
+        for(node* child = parent->first_child_; child; child = child->next_sibling_)
+        {
+            record(child, static_cast<uint32_t>(i));
+        }
+    }
+
+    records.erase(records.begin() + static_cast<std::ptrdiff_t>(count), records.end());
+}
+
+void node_tree::restore(node_tree_snapshot& snapshot)
+{
+    using node_record = node_tree_snapshot::node_record;
+
+    assert(snapshot.tree_ == this);
+
+    if(snapshot.structure_version_ != structure_version_)
+    {
+        std::vector<node_record>& records = snapshot.nodes_;
+        std::vector<uint32_t>& changed_nodes = snapshot.changed_nodes_;
+        std::vector<uint8_t>& changed_records = snapshot.changed_records_;
+
+        // Moving or renaming a node changes its version and the version of its parents. An unchanged node is still a
+        // child of its recorded parent, under the same name and after the same unchanged siblings
+        const uint64_t version = snapshot.structure_version_;
+        const auto changed = [version](const node* n) noexcept
+        {
+            return n->structure_version_ > version;
+        };
+
+        // Found before restoring anything, restoring a node changes its version
+        changed_nodes.clear();
+        changed_records.resize(records.size());
+        for(std::size_t i = 0; i < records.size(); ++i)
+        {
+            changed_records[i] = changed(records[i].n);
+            if(changed_records[i])
+            {
+                changed_nodes.push_back(static_cast<uint32_t>(i));
+            }
+        }
+
+        // Changed nodes are detached, then linked again at their place among their unchanged siblings
+        for(uint32_t i : changed_nodes)
+        {
+            records[i].n->detach_from_parent();
+        }
+
+        // A changed node left with more children than its unchanged ones has children attached since the snapshot,
+        // they stay detached
+        for(uint32_t i : changed_nodes)
+        {
+            const node_record& r = records[i];
+
+            std::size_t unchanged_count = 0;
+            for(uint32_t child = r.first_child; child < r.first_child + r.child_count; ++child)
+            {
+                unchanged_count += changed_records[child] ? 0 : 1;
+            }
+
+            if(r.n->child_count_ == unchanged_count)
+            {
+                continue;
+            }
+
+            for(node* child = r.n->first_child_; child;)
+            {
+                node* next_sibling = child->next_sibling_;
+                if(changed(child))
+                {
+                    r.n->detach_child(child);
+                }
+
+                child = next_sibling;
+            }
+        }
+
+        // Detached nodes have no sibling with their recorded name
+        for(uint32_t i : changed_nodes)
+        {
+            node_record& r = records[i];
+            if(r.n->name_ != r.name)
+            {
+                r.n->rename(r.name);
+            }
+        }
+
+        // Linked from the last one, the next recorded sibling is either unchanged or already linked
+        for(auto it = changed_nodes.rbegin(); it != changed_nodes.rend(); ++it)
+        {
+            const uint32_t i = *it;
+            if(i == 0)
+            {
+                continue;
+            }
+
+            node* parent = records[records[i].parent].n;
+            node* child = records[i].n;
+
+            const node_record& parent_record = records[records[i].parent];
+            node* next_sibling = i + 1 < parent_record.first_child + parent_record.child_count ? records[i + 1].n : nullptr;
+
+            on_child_attached(parent, child);
+            parent->link_child(child, next_sibling);
+
+            parent->on_structure_changed();
+            child->on_structure_changed();
+            child->parent_changed();
+        }
+
+        // The structure is the recorded one again, later changes are found from here
+        snapshot.structure_version_ = structure_version_;
+    }
+
+    if(root_ != snapshot.root_)
+    {
+        root_ = snapshot.root_;
+
+        if(root_)
+        {
+            keep_while_collecting(root_);
+        }
+    }
+
+    const std::vector<node2d*>& transform_nodes = transforms_.nodes();
+    const std::vector<glm::vec2>& translations = transforms_.local_translations();
+    const std::vector<float>& rotations = transforms_.local_rotations();
+    const std::vector<glm::vec2>& scales = transforms_.local_scales();
+
+    // Setting a transform outdates the world transforms of the subtree, unchanged transforms are skipped
+    const auto restore_transform = [&](std::size_t slot, std::size_t recorded_slot) noexcept
+    {
+        if(translations[slot] != snapshot.local_translations_[recorded_slot]
+           || rotations[slot] != snapshot.local_rotations_[recorded_slot]
+           || scales[slot] != snapshot.local_scales_[recorded_slot])
+        {
+            transforms_.set_local_transform(static_cast<transform_store::slot_type>(slot),
+                                            transform2d{snapshot.local_translations_[recorded_slot],
+                                                        snapshot.local_rotations_[recorded_slot],
+                                                        snapshot.local_scales_[recorded_slot]});
+        }
+    };
+
+    // Slots only move when the structure changes, they usually still hold the recorded node
+    const std::size_t recorded_count = std::min(snapshot.transform_nodes_.size(), transform_nodes.size());
+
+    std::size_t slot = 0;
+    for(; slot < recorded_count && transform_nodes[slot] == snapshot.transform_nodes_[slot]; ++slot)
+    {
+        if(transform_nodes[slot])
+        {
+            restore_transform(slot, slot);
+        }
+    }
+
+    if(slot == transform_nodes.size())
+    {
+        return;
+    }
+
+    // Recorded nodes are kept alive by the snapshot, a node found at a recorded address is the recorded node
+    std::unordered_map<const node2d*, std::size_t>& recorded_slots = snapshot.recorded_slots_;
+    recorded_slots.clear();
+    for(std::size_t recorded_slot = slot; recorded_slot < snapshot.transform_nodes_.size(); ++recorded_slot)
+    {
+        if(const node2d* n = snapshot.transform_nodes_[recorded_slot])
+        {
+            recorded_slots.emplace(n, recorded_slot);
+        }
+    }
+
+    for(; slot < transform_nodes.size(); ++slot)
+    {
+        if(!transform_nodes[slot])
+        {
+            continue;
+        }
+
+        const auto found = recorded_slots.find(transform_nodes[slot]);
+        if(found != recorded_slots.end())
+        {
+            restore_transform(slot, found->second);
+        }
+    }
+}
+
+void node_tree::update_world_transforms()
+{
+    transforms_.update();
+    spatial_.refresh(transforms_);
+}
+
+void node_tree::update_world_transforms(thread_pool& pool)
+{
+    transforms_.update(pool);
+    spatial_.refresh(transforms_);
+}
+
+void node_tree::capture_world_transforms()
+{
+    update_world_transforms();
+
+    transforms_.capture();
+}
+
+const transform_store& node_tree::transforms() const noexcept
+{
+    return transforms_;
+}
+
+event_dispatcher& node_tree::events() noexcept
+{
+    return events_;
+}
+
+const event_dispatcher& node_tree::events() const noexcept
+{
+    return events_;
+}
+
+tick_scheduler& node_tree::scheduler() noexcept
+{
+    return scheduler_;
+}
+
+const tick_scheduler& node_tree::scheduler() const noexcept
+{
+    return scheduler_;
+}
+
+spatial_index& node_tree::spatial() noexcept
+{
+    return spatial_;
+}
+
+const spatial_index& node_tree::spatial() const noexcept
+{
+    return spatial_;
+}
+
+component_store& node_tree::components() noexcept
+{
+    return components_;
+}
+
+const component_store& node_tree::components() const noexcept
+{
+    return components_;
+}
+
+node_tree::iterator node_tree::begin(node* subtree_root) noexcept
+{
+    return node_tree::iterator{subtree_root};
+}
+
+node_tree::const_iterator node_tree::begin(const node* subtree_root) noexcept
+{
+    // The iterator only gives back const nodes
+    return node_tree::const_iterator{const_cast<node*>(subtree_root)};
 }
 
 node_tree::iterator node_tree::begin() noexcept
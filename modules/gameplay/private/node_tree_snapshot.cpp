@@ -0,0 +1,108 @@
+#include "node_tree_snapshot.hpp"
+#include "node_tree.hpp"
+
+#include <utility>
+
+namespace ng
+{
+
+node_tree_snapshot::node_tree_snapshot()
+: tree_{nullptr}
+, root_{nullptr}
+, structure_version_{0}
+, nodes_()
+, transform_nodes_()
+, local_translations_()
+, local_rotations_()
+, local_scales_()
+, changed_nodes_()
+, changed_records_()
+, recorded_slots_()
+{
+
+}
+
+node_tree_snapshot::node_tree_snapshot(node_tree_snapshot&& other)
+: tree_{nullptr}
+, root_{other.root_}
+, structure_version_{other.structure_version_}
+, nodes_(std::move(other.nodes_))
+, transform_nodes_(std::move(other.transform_nodes_))
+, local_translations_(std::move(other.local_translations_))
+, local_rotations_(std::move(other.local_rotations_))
+, local_scales_(std::move(other.local_scales_))
+, changed_nodes_(std::move(other.changed_nodes_))
+, changed_records_(std::move(other.changed_records_))
+, recorded_slots_(std::move(other.recorded_slots_))
+{
+    if(other.tree_)
+    {
+        other.tree_->register_snapshot(this);
+        tree_ = other.tree_;
+    }
+
+    other.clear();
+}
+
+node_tree_snapshot& node_tree_snapshot::operator=(node_tree_snapshot&& other)
+{
+    if(this != &other)
+    {
+        clear();
+
+        if(other.tree_)
+        {
+            other.tree_->register_snapshot(this);
+            tree_ = other.tree_;
+        }
+
+        root_ = other.root_;
+        structure_version_ = other.structure_version_;
+        nodes_ = std::move(other.nodes_);
+        transform_nodes_ = std::move(other.transform_nodes_);
+        local_translations_ = std::move(other.local_translations_);
+        local_rotations_ = std::move(other.local_rotations_);
+        local_scales_ = std::move(other.local_scales_);
+        changed_nodes_ = std::move(other.changed_nodes_);
+        changed_records_ = std::move(other.changed_records_);
+        recorded_slots_ = std::move(other.recorded_slots_);
+
+        other.clear();
+    }
+
+    return *this;
+}
+
+node_tree_snapshot::~node_tree_snapshot()
+{
+    clear();
+}
+
+std::size_t node_tree_snapshot::size() const noexcept
+{
+    return nodes_.size();
+}
+
+bool node_tree_snapshot::empty() const noexcept
+{
+    return nodes_.empty();
+}
+
+void node_tree_snapshot::clear() noexcept
+{
+    if(tree_)
+    {
+        tree_->forget_snapshot(this);
+    }
+
+    tree_ = nullptr;
+    root_ = nullptr;
+    structure_version_ = 0;
+    nodes_.clear();
+    transform_nodes_.clear();
+    local_translations_.clear();
+    local_rotations_.clear();
+    local_scales_.clear();
+}
+
+}
\ No newline at end of file
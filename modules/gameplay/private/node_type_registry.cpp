@@ -0,0 +1,60 @@
+#include "node_type_registry.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace ng
+{
+
+node_type_registry::node_type_registry()
+: types_()
+{
+    add<node>(name{"node"});
+    add<node2d>(name{"node2d"});
+}
+
+void node_type_registry::add(node_type type)
+{
+    const bool registered = std::any_of(types_.begin(), types_.end(), [&type](const node_type& other)
+    {
+        return other.type_name == type.type_name || other.type == type.type;
+    });
+
+    if(registered)
+    {
+        throw std::logic_error{"node type already registered"};
+    }
+
+    types_.push_back(std::move(type));
+}
+
+const node_type_registry::node_type* node_type_registry::find(const safe_name& type_name) const noexcept
+{
+    // Only a few types are registered, a linear search is faster than hashing
+    for(const node_type& type : types_)
+    {
+        if(type.type_name == type_name)
+        {
+            return &type;
+        }
+    }
+
+    return nullptr;
+}
+
+const node_type_registry::node_type* node_type_registry::find(const node& n) const noexcept
+{
+    const std::type_index node_type_index{typeid(n)};
+
+    for(const node_type& type : types_)
+    {
+        if(type.type == node_type_index)
+        {
+            return &type;
+        }
+    }
+
+    return nullptr;
+}
+
+}
\ No newline at end of file
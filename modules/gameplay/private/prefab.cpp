@@ -0,0 +1,80 @@
+#include "prefab.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace ng
+{
+
+prefab::index_type prefab::add(safe_name name, index_type parent, construct_function construct, std::size_t pool_index,
+                               reserve_function reserve)
+{
+    // Only the first node is the root of the prefab
+    assert((parent == no_parent) == constructors_.empty());
+    assert(parent == no_parent || parent < size());
+    assert(size() < no_parent);
+
+    // Checked once here instead of every time the prefab is instantiated
+    for(index_type sibling = 0; sibling < size(); ++sibling)
+    {
+        if(parents_[sibling] == parent && names_[sibling] == name)
+        {
+            throw invalid_node_name{name};
+        }
+    }
+
+    auto type_it = std::find_if(node_types_.begin(), node_types_.end(), [pool_index](const node_type_count& type)
+    {
+        return type.pool_index == pool_index;
+    });
+
+    if(type_it == node_types_.end())
+    {
+        node_types_.push_back(node_type_count{pool_index, reserve, 0});
+        type_it = std::prev(node_types_.end());
+    }
+
+    const index_type index = static_cast<index_type>(size());
+
+    constructors_.push_back(construct);
+    names_.push_back(std::move(name));
+    parents_.push_back(parent);
+    ++type_it->count;
+
+    return index;
+}
+
+void prefab::set_local_bounds(index_type index, const aabb2d& bounds)
+{
+    // Indices are added in increasing order
+    const auto it = std::lower_bound(node2d_indices_.begin(), node2d_indices_.end(), index);
+    assert(it != node2d_indices_.end() && *it == index);
+
+    local_bounds_[std::distance(node2d_indices_.begin(), it)] = bounds;
+}
+
+const safe_name& prefab::name(index_type index) const noexcept
+{
+    assert(index < size());
+
+    return names_[index];
+}
+
+prefab::index_type prefab::parent(index_type index) const noexcept
+{
+    assert(index < size());
+
+    return parents_[index];
+}
+
+std::size_t prefab::size() const noexcept
+{
+    return constructors_.size();
+}
+
+bool prefab::empty() const noexcept
+{
+    return constructors_.empty();
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,387 @@
+#include "scene_file.hpp"
+#include "node.hpp"
+#include "node2d.hpp"
+#include "node_tree.hpp"
+#include "node_type_registry.hpp"
+
+#include <ng/core/mapped_file.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ng
+{
+
+namespace
+{
+
+constexpr std::array<char, 4> scene_magic{'N', 'G', 'S', 'C'};
+constexpr uint32_t scene_version = 1;
+
+// Written with the byte order of the machine, reading it back in another order gives another value
+constexpr uint32_t scene_byte_order = 0x01020304;
+
+// Every array starts on a multiple of the largest alignment of its elements
+constexpr std::size_t section_alignment = 8;
+
+struct scene_header
+{
+    std::array<char, 4> magic;
+    uint32_t version;
+    uint32_t byte_order;
+
+    uint32_t node_count;
+    uint32_t node2d_count;
+    uint32_t type_count;
+    uint32_t string_count;
+    uint32_t strings_size;
+
+    // Offsets of the arrays from the beginning of the scene
+    uint64_t type_names_offset;
+    uint64_t node_types_offset;
+    uint64_t node_names_offset;
+    uint64_t node_parents_offset;
+    uint64_t transforms_offset;
+    uint64_t bounds_offset;
+    uint64_t string_offsets_offset;
+    uint64_t strings_offset;
+};
+
+/**
+ * Returns an array of a scene after checking that it fits in the scene
+ * @tparam T The type of the elements
+ * @param data The first byte of the scene
+ * @param size The size of the scene
+ * @param offset The offset of the array
+ * @param count The number of elements of the array
+ * @return The first element of the array
+ * @throw scene_file_error When the array doesn't fit in the scene or is not aligned
+ */
+template<typename T>
+const T* scene_array(const uint8_t* data, std::size_t size, uint64_t offset, std::size_t count)
+{
+    if(offset % alignof(T) != 0 || offset > size || count > (size - offset) / sizeof(T))
+    {
+        throw scene_file_error{"scene array out of bounds"};
+    }
+
+    return reinterpret_cast<const T*>(data + offset);
+}
+
+std::size_t align_section(std::size_t offset) noexcept
+{
+    return (offset + section_alignment - 1) / section_alignment * section_alignment;
+}
+
+/**
+ * Write an array at an offset of the output, the space since the previous array is padded with zeros
+ */
+template<typename T>
+void write_section(std::ostream& output, std::size_t& written, std::size_t offset, const std::vector<T>& elements)
+{
+    static constexpr std::array<char, section_alignment> padding{};
+
+    assert(offset >= written && offset - written < section_alignment);
+
+    output.write(padding.data(), static_cast<std::streamsize>(offset - written));
+    output.write(reinterpret_cast<const char*>(elements.data()), static_cast<std::streamsize>(elements.size() * sizeof(T)));
+
+    written = offset + elements.size() * sizeof(T);
+}
+
+}
+
+scene_view::scene_view(const void* data, std::size_t size)
+: node_count_{0}
+, node2d_count_{0}
+, type_count_{0}
+, string_count_{0}
+, type_names_{nullptr}
+, node_types_{nullptr}
+, node_names_{nullptr}
+, node_parents_{nullptr}
+, transforms_{nullptr}
+, bounds_{nullptr}
+, string_offsets_{nullptr}
+, strings_{nullptr}
+{
+    assert(reinterpret_cast<std::uintptr_t>(data) % section_alignment == 0);
+
+    if(!data || size < sizeof(scene_header))
+    {
+        throw scene_file_error{"scene too small"};
+    }
+
+    const auto bytes = static_cast<const uint8_t*>(data);
+    const auto& header = *reinterpret_cast<const scene_header*>(bytes);
+
+    if(header.magic != scene_magic)
+    {
+        throw scene_file_error{"not a scene"};
+    }
+
+    if(header.byte_order != scene_byte_order)
+    {
+        throw scene_file_error{"scene written with another byte order"};
+    }
+
+    if(header.version != scene_version)
+    {
+        throw scene_file_error{"unsupported scene version"};
+    }
+
+    if(header.node_count == 0 || header.node2d_count > header.node_count)
+    {
+        throw scene_file_error{"invalid node count"};
+    }
+
+    node_count_ = header.node_count;
+    node2d_count_ = header.node2d_count;
+    type_count_ = header.type_count;
+    string_count_ = header.string_count;
+
+    type_names_ = scene_array<uint32_t>(bytes, size, header.type_names_offset, type_count_);
+    node_types_ = scene_array<uint32_t>(bytes, size, header.node_types_offset, node_count_);
+    node_names_ = scene_array<uint32_t>(bytes, size, header.node_names_offset, node_count_);
+    node_parents_ = scene_array<uint32_t>(bytes, size, header.node_parents_offset, node_count_);
+    transforms_ = scene_array<scene_transform>(bytes, size, header.transforms_offset, node2d_count_);
+    bounds_ = scene_array<scene_bounds>(bytes, size, header.bounds_offset, node2d_count_);
+    string_offsets_ = scene_array<uint32_t>(bytes, size, header.string_offsets_offset, std::size_t{string_count_} + 1);
+    strings_ = scene_array<char>(bytes, size, header.strings_offset, header.strings_size);
+
+    // Indices are checked once so the nodes can be created without checking them
+    for(uint32_t i = 0; i < string_count_; ++i)
+    {
+        if(string_offsets_[i] > string_offsets_[i + 1])
+        {
+            throw scene_file_error{"invalid string table"};
+        }
+    }
+
+    if(string_offsets_[0] != 0 || string_offsets_[string_count_] > header.strings_size)
+    {
+        throw scene_file_error{"invalid string table"};
+    }
+
+    for(uint32_t type = 0; type < type_count_; ++type)
+    {
+        if(type_names_[type] >= string_count_)
+        {
+            throw scene_file_error{"invalid type name"};
+        }
+    }
+
+    if(node_parents_[0] != no_parent)
+    {
+        throw scene_file_error{"the first node must be the root"};
+    }
+
+    for(uint32_t i = 0; i < node_count_; ++i)
+    {
+        // Parents are stored before their children
+        if(node_types_[i] >= type_count_ || node_names_[i] >= string_count_ || (i > 0 && node_parents_[i] >= i))
+        {
+            throw scene_file_error{"invalid node"};
+        }
+    }
+
+    // Loading links the nodes without looking for their siblings, so sibling names are checked once here
+    std::vector<uint32_t> children(node_count_ - 1);
+    std::iota(children.begin(), children.end(), 1);
+    std::sort(children.begin(), children.end(), [this](uint32_t first, uint32_t second)
+    {
+        if(node_parents_[first] != node_parents_[second])
+        {
+            return node_parents_[first] < node_parents_[second];
+        }
+
+        return string(node_names_[first]) < string(node_names_[second]);
+    });
+
+    const auto same_sibling_name = [this](uint32_t first, uint32_t second)
+    {
+        return node_parents_[first] == node_parents_[second] && string(node_names_[first]) == string(node_names_[second]);
+    };
+
+    if(std::adjacent_find(children.begin(), children.end(), same_sibling_name) != children.end())
+    {
+        throw scene_file_error{"siblings with the same name"};
+    }
+}
+
+std::size_t scene_view::node_count() const noexcept
+{
+    return node_count_;
+}
+
+std::size_t scene_view::node2d_count() const noexcept
+{
+    return node2d_count_;
+}
+
+std::size_t scene_view::type_count() const noexcept
+{
+    return type_count_;
+}
+
+std::size_t scene_view::string_count() const noexcept
+{
+    return string_count_;
+}
+
+std::string_view scene_view::string(uint32_t index) const noexcept
+{
+    assert(index < string_count_);
+
+    return std::string_view{strings_ + string_offsets_[index], string_offsets_[index + 1] - string_offsets_[index]};
+}
+
+const uint32_t* scene_view::type_names() const noexcept
+{
+    return type_names_;
+}
+
+const uint32_t* scene_view::node_types() const noexcept
+{
+    return node_types_;
+}
+
+const uint32_t* scene_view::node_names() const noexcept
+{
+    return node_names_;
+}
+
+const uint32_t* scene_view::node_parents() const noexcept
+{
+    return node_parents_;
+}
+
+const scene_transform* scene_view::transforms() const noexcept
+{
+    return transforms_;
+}
+
+const scene_bounds* scene_view::bounds() const noexcept
+{
+    return bounds_;
+}
+
+void write_scene(const node* subtree_root, const node_type_registry& types, std::ostream& output)
+{
+    assert(subtree_root);
+
+    std::vector<uint32_t> type_names;
+    std::vector<uint32_t> node_types;
+    std::vector<uint32_t> node_names;
+    std::vector<uint32_t> node_parents;
+    std::vector<scene_transform> transforms;
+    std::vector<scene_bounds> bounds;
+    std::vector<uint32_t> string_offsets{0};
+    std::vector<char> strings;
+
+    std::unordered_map<name, uint32_t> string_indices;
+    std::unordered_map<const node_type_registry::node_type*, uint32_t> type_indices;
+    std::unordered_map<const node*, uint32_t> node_indices;
+
+    const auto string_index = [&](const name& string)
+    {
+        const auto [it, added] = string_indices.emplace(string, static_cast<uint32_t>(string_offsets.size() - 1));
+        if(added)
+        {
+            const std::string characters = string.string();
+            strings.insert(strings.end(), characters.begin(), characters.end());
+            string_offsets.push_back(static_cast<uint32_t>(strings.size()));
+        }
+
+        return it->second;
+    };
+
+    for(auto it = node_tree::begin(subtree_root); it != node_tree::const_iterator{}; ++it)
+    {
+        const node& n = *it;
+
+        const node_type_registry::node_type* type = types.find(n);
+        if(!type)
+        {
+            throw std::invalid_argument{"unregistered node type"};
+        }
+
+        const auto [type_it, type_added] = type_indices.emplace(type, static_cast<uint32_t>(type_names.size()));
+        if(type_added)
+        {
+            type_names.push_back(string_index(type->type_name));
+        }
+
+        node_indices.emplace(&n, static_cast<uint32_t>(node_types.size()));
+        node_types.push_back(type_it->second);
+        node_names.push_back(string_index(n.name()));
+        node_parents.push_back(&n == subtree_root ? scene_view::no_parent : node_indices.at(n.parent()));
+
+        if(type->is_node2d)
+        {
+            const auto& n2d = static_cast<const node2d&>(n);
+            const transform2d local_transform = n2d.local_transform();
+            const aabb2d& local_bounds = n2d.local_bounds();
+
+            transforms.push_back(scene_transform{local_transform.translation.x, local_transform.translation.y,
+                                                 local_transform.rotation,
+                                                 local_transform.scale.x, local_transform.scale.y});
+            bounds.push_back(scene_bounds{local_bounds.min.x, local_bounds.min.y, local_bounds.max.x, local_bounds.max.y});
+        }
+    }
+
+    scene_header header{};
+    header.magic = scene_magic;
+    header.version = scene_version;
+    header.byte_order = scene_byte_order;
+    header.node_count = static_cast<uint32_t>(node_types.size());
+    header.node2d_count = static_cast<uint32_t>(transforms.size());
+    header.type_count = static_cast<uint32_t>(type_names.size());
+    header.string_count = static_cast<uint32_t>(string_offsets.size() - 1);
+    header.strings_size = static_cast<uint32_t>(strings.size());
+
+    std::size_t offset = sizeof(scene_header);
+    const auto next_section = [&offset](std::size_t section_size)
+    {
+        const std::size_t section_offset = align_section(offset);
+        offset = section_offset + section_size;
+
+        return section_offset;
+    };
+
+    header.type_names_offset = next_section(type_names.size() * sizeof(uint32_t));
+    header.node_types_offset = next_section(node_types.size() * sizeof(uint32_t));
+    header.node_names_offset = next_section(node_names.size() * sizeof(uint32_t));
+    header.node_parents_offset = next_section(node_parents.size() * sizeof(uint32_t));
+    header.transforms_offset = next_section(transforms.size() * sizeof(scene_transform));
+    header.bounds_offset = next_section(bounds.size() * sizeof(scene_bounds));
+    header.string_offsets_offset = next_section(string_offsets.size() * sizeof(uint32_t));
+    header.strings_offset = next_section(strings.size());
+
+    output.write(reinterpret_cast<const char*>(&header), sizeof(scene_header));
+
+    std::size_t written = sizeof(scene_header);
+    write_section(output, written, header.type_names_offset, type_names);
+    write_section(output, written, header.node_types_offset, node_types);
+    write_section(output, written, header.node_names_offset, node_names);
+    write_section(output, written, header.node_parents_offset, node_parents);
+    write_section(output, written, header.transforms_offset, transforms);
+    write_section(output, written, header.bounds_offset, bounds);
+    write_section(output, written, header.string_offsets_offset, string_offsets);
+    write_section(output, written, header.strings_offset, strings);
+}
+
+node* load_scene(node_tree& tree, const std::filesystem::path& path, const node_type_registry& types, node* parent)
+{
+    const mapped_file file{path};
+
+    return tree.load(scene_view{file.data(), file.size()}, types, parent);
+}
+
+}
\ No newline at end of file
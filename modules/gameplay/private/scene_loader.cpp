@@ -0,0 +1,152 @@
+#include "scene_loader.hpp"
+#include "scene_file.hpp"
+
+#include <ng/core/mapped_file.hpp>
+
+#include <utility>
+
+namespace ng
+{
+
+scene_load_progress::scene_load_progress() noexcept
+: node_count_{0}
+, created_nodes_{0}
+, cancelled_{false}
+{
+
+}
+
+void scene_load_progress::start(std::size_t node_count) noexcept
+{
+    created_nodes_.store(0, std::memory_order_relaxed);
+    node_count_.store(node_count, std::memory_order_relaxed);
+}
+
+void scene_load_progress::set_created_nodes(std::size_t created_nodes) noexcept
+{
+    created_nodes_.store(created_nodes, std::memory_order_relaxed);
+}
+
+void scene_load_progress::cancel() noexcept
+{
+    cancelled_.store(true, std::memory_order_relaxed);
+}
+
+bool scene_load_progress::cancelled() const noexcept
+{
+    return cancelled_.load(std::memory_order_relaxed);
+}
+
+std::size_t scene_load_progress::node_count() const noexcept
+{
+    return node_count_.load(std::memory_order_relaxed);
+}
+
+std::size_t scene_load_progress::created_nodes() const noexcept
+{
+    return created_nodes_.load(std::memory_order_relaxed);
+}
+
+float scene_load_progress::ratio() const noexcept
+{
+    const std::size_t count = node_count();
+    if(count == 0)
+    {
+        return 0.f;
+    }
+
+    return static_cast<float>(created_nodes()) / static_cast<float>(count);
+}
+
+scene_loader::scene_loader(std::filesystem::path path, const node_type_registry& types)
+: staging_()
+, progress_()
+, root_{nullptr}
+, error_()
+, finished_{false}
+, worker_()
+{
+    // Started last, every member is constructed before the thread uses them
+    worker_ = std::thread{[this, path = std::move(path), &types]()
+    {
+        load(path, types);
+    }};
+}
+
+scene_loader::~scene_loader()
+{
+    cancel();
+
+    if(worker_.joinable())
+    {
+        worker_.join();
+    }
+}
+
+void scene_loader::load(const std::filesystem::path& path, const node_type_registry& types) noexcept
+{
+    try
+    {
+        const mapped_file file{path};
+
+        node* root = staging_.load(scene_view{file.data(), file.size()}, types, nullptr, &progress_);
+        if(root)
+        {
+            // The world transforms are computed here instead of on the thread committing the scene
+            staging_.set_root(root);
+            staging_.update_world_transforms();
+        }
+
+        root_ = root;
+    }
+    catch(...)
+    {
+        error_ = std::current_exception();
+    }
+
+    finished_.store(true, std::memory_order_release);
+}
+
+void scene_loader::cancel() noexcept
+{
+    progress_.cancel();
+}
+
+bool scene_loader::finished() const noexcept
+{
+    return finished_.load(std::memory_order_acquire);
+}
+
+void scene_loader::wait()
+{
+    if(worker_.joinable())
+    {
+        worker_.join();
+    }
+}
+
+const scene_load_progress& scene_loader::progress() const noexcept
+{
+    return progress_;
+}
+
+node* scene_loader::commit(node_tree& tree, node* parent)
+{
+    wait();
+
+    if(error_)
+    {
+        std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+
+    if(!root_)
+    {
+        return nullptr;
+    }
+
+    root_ = nullptr;
+
+    return tree.merge(staging_, parent);
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,424 @@
+#include "spatial_index.hpp"
+#include "node2d.hpp"
+#include "transform_store.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+namespace ng
+{
+
+namespace
+{
+
+// Cell coordinates are stored on 29 bits, the level on the 6 remaining bits of a key
+constexpr int64_t max_cell_coordinate = (int64_t{1} << 28) - 1;
+constexpr int64_t min_cell_coordinate = -(int64_t{1} << 28);
+constexpr uint64_t cell_coordinate_mask = (uint64_t{1} << 29) - 1;
+constexpr int level_shift = 58;
+
+int64_t cell_coordinate(float value, float cell_size) noexcept
+{
+    const double coordinate = std::floor(static_cast<double>(value) / static_cast<double>(cell_size));
+
+    return static_cast<int64_t>(std::clamp(coordinate,
+                                           static_cast<double>(min_cell_coordinate),
+                                           static_cast<double>(max_cell_coordinate)));
+}
+
+uint64_t cell_key(std::size_t level, int64_t x, int64_t y) noexcept
+{
+    return (static_cast<uint64_t>(level) << level_shift)
+         | ((static_cast<uint64_t>(x) & cell_coordinate_mask) << 29)
+         | (static_cast<uint64_t>(y) & cell_coordinate_mask);
+}
+
+std::size_t level_of_key(uint64_t key) noexcept
+{
+    return static_cast<std::size_t>(key >> level_shift);
+}
+
+}
+
+spatial_index::spatial_index(float cell_size)
+: entries_()
+, cells_()
+, level_sizes_{}
+, cell_size_{cell_size}
+{
+    assert(cell_size > 0.f);
+}
+
+std::size_t spatial_index::level_of(const aabb2d& bounds) const noexcept
+{
+    const glm::vec2 size = bounds.size();
+    const float largest_size = std::max(size.x, size.y);
+
+    // Nodes larger than the cells of the last level are stored on the last level anyway, they could be missed by
+    // queries far from their center
+    std::size_t level = 0;
+    for(float level_cell_size = cell_size_; largest_size > level_cell_size && level + 1 < level_count; ++level)
+    {
+        level_cell_size *= 2.f;
+    }
+
+    return level;
+}
+
+uint64_t spatial_index::cell_of(const aabb2d& bounds) const noexcept
+{
+    const std::size_t level = level_of(bounds);
+    const float level_cell_size = std::ldexp(cell_size_, static_cast<int>(level));
+    const glm::vec2 center = bounds.center();
+
+    return cell_key(level, cell_coordinate(center.x, level_cell_size), cell_coordinate(center.y, level_cell_size));
+}
+
+void spatial_index::link(entry_type index, uint64_t key, const aabb2d& world_bounds)
+{
+    cell& linked_cell = cells_[key];
+    linked_cell.push_back(cell_entry{world_bounds, entries_[index].indexed_node});
+
+    // Only leave the previous cell once nothing can throw
+    if(entries_[index].entry_cell)
+    {
+        unlink(index);
+    }
+
+    entry& linked = entries_[index];
+    linked.cell_key = key;
+    linked.entry_cell = &linked_cell;
+    linked.index_in_cell = linked_cell.size() - 1;
+
+    ++level_sizes_[level_of_key(key)];
+}
+
+void spatial_index::unlink(entry_type index) noexcept
+{
+    const entry& unlinked = entries_[index];
+    cell& unlinked_cell = *unlinked.entry_cell;
+
+    // The last entry of the cell takes the place of the unlinked entry
+    const cell_entry& moved = unlinked_cell.back();
+    entries_[moved.indexed_node->spatial_entry_].index_in_cell = unlinked.index_in_cell;
+    unlinked_cell[unlinked.index_in_cell] = moved;
+    unlinked_cell.pop_back();
+
+    --level_sizes_[level_of_key(unlinked.cell_key)];
+
+    if(unlinked_cell.empty())
+    {
+        cells_.erase(unlinked.cell_key);
+    }
+}
+
+template<typename Function>
+void spatial_index::visit(const aabb2d& region, Function&& function) const
+{
+    struct cell_range
+    {
+        std::size_t level;
+        int64_t min_x;
+        int64_t min_y;
+        int64_t max_x;
+        int64_t max_y;
+    };
+
+    if(region.empty())
+    {
+        return;
+    }
+
+    std::array<cell_range, level_count> ranges;
+    std::size_t range_count = 0;
+    uint64_t cell_count = 0;
+
+    for(std::size_t level = 0; level < level_count; ++level)
+    {
+        if(level_sizes_[level] == 0)
+        {
+            continue;
+        }
+
+        // Nodes of this level are at most as large as a cell, they can overlap the region from half a cell away
+        const float level_cell_size = std::ldexp(cell_size_, static_cast<int>(level));
+        const glm::vec2 margin{level_cell_size * 0.5f};
+
+        cell_range& range = ranges[range_count++];
+        range.level = level;
+        range.min_x = cell_coordinate(region.min.x - margin.x, level_cell_size);
+        range.min_y = cell_coordinate(region.min.y - margin.y, level_cell_size);
+        range.max_x = cell_coordinate(region.max.x + margin.x, level_cell_size);
+        range.max_y = cell_coordinate(region.max.y + margin.y, level_cell_size);
+
+        cell_count += static_cast<uint64_t>(range.max_x - range.min_x + 1)
+                    * static_cast<uint64_t>(range.max_y - range.min_y + 1);
+    }
+
+    // Looking up every cell of a large region is slower than checking every cell
+    if(cell_count > cells_.size())
+    {
+        for(const auto& [key, visited_cell] : cells_)
+        {
+            for(const cell_entry& visited : visited_cell)
+            {
+                function(visited);
+            }
+        }
+
+        return;
+    }
+
+    for(std::size_t i = 0; i < range_count; ++i)
+    {
+        const cell_range& range = ranges[i];
+        for(int64_t y = range.min_y; y <= range.max_y; ++y)
+        {
+            for(int64_t x = range.min_x; x <= range.max_x; ++x)
+            {
+                const auto cell_it = cells_.find(cell_key(range.level, x, y));
+                if(cell_it == cells_.end())
+                {
+                    continue;
+                }
+
+                for(const cell_entry& visited : cell_it->second)
+                {
+                    function(visited);
+                }
+            }
+        }
+    }
+}
+
+void spatial_index::insert(node2d* n, const aabb2d& world_bounds, uint32_t world_version)
+{
+    assert(n);
+    assert(n->spatial_entry_ == invalid_entry);
+    assert(entries_.size() < invalid_entry);
+
+    const entry_type index = static_cast<entry_type>(entries_.size());
+    entries_.push_back(entry{n, 0, nullptr, 0, world_version});
+
+    try
+    {
+        link(index, cell_of(world_bounds), world_bounds);
+    }
+    catch(...)
+    {
+        entries_.pop_back();
+        throw;
+    }
+
+    n->spatial_entry_ = index;
+}
+
+void spatial_index::update(entry_type index, const aabb2d& world_bounds, uint32_t world_version)
+{
+    assert(index < entries_.size());
+
+    entry& updated = entries_[index];
+    updated.world_version = world_version;
+
+    // Most moves stay in the same cell
+    const uint64_t key = cell_of(world_bounds);
+    if(key == updated.cell_key)
+    {
+        (*updated.entry_cell)[updated.index_in_cell].world_bounds = world_bounds;
+    }
+    else
+    {
+        link(index, key, world_bounds);
+    }
+}
+
+void spatial_index::remove(entry_type index) noexcept
+{
+    assert(index < entries_.size());
+
+    unlink(index);
+    entries_[index].indexed_node->spatial_entry_ = invalid_entry;
+
+    // The last entry takes the place of the removed entry
+    const entry_type last = static_cast<entry_type>(entries_.size() - 1);
+    if(index != last)
+    {
+        const entry& moved = entries_[last];
+
+        moved.indexed_node->spatial_entry_ = index;
+        entries_[index] = moved;
+    }
+
+    entries_.pop_back();
+}
+
+void spatial_index::append(spatial_index& other)
+{
+    assert(&other != this);
+    assert(cell_size_ == other.cell_size_);
+    assert(entries_.size() + other.entries_.size() < invalid_entry);
+
+    // Cells keep their address when the maps are swapped, so the entries of either index can come first
+    if(entries_.size() < other.entries_.size())
+    {
+        entries_.swap(other.entries_);
+        cells_.swap(other.cells_);
+        std::swap(level_sizes_, other.level_sizes_);
+    }
+
+    const entry_type offset = static_cast<entry_type>(entries_.size());
+
+    entries_.reserve(entries_.size() + other.entries_.size());
+    for(const entry& moved : other.entries_)
+    {
+        moved.indexed_node->spatial_entry_ += offset;
+        entries_.push_back(moved);
+    }
+
+    for(auto& [key, moved_cell] : other.cells_)
+    {
+        cell& merged_cell = cells_[key];
+        const std::size_t first_moved = merged_cell.size();
+
+        if(merged_cell.empty())
+        {
+            merged_cell.swap(moved_cell);
+        }
+        else
+        {
+            merged_cell.insert(merged_cell.end(), moved_cell.begin(), moved_cell.end());
+        }
+
+        for(std::size_t index_in_cell = first_moved; index_in_cell < merged_cell.size(); ++index_in_cell)
+        {
+            entry& merged = entries_[merged_cell[index_in_cell].indexed_node->spatial_entry_];
+            merged.entry_cell = &merged_cell;
+            merged.index_in_cell = index_in_cell;
+        }
+    }
+
+    for(std::size_t level = 0; level < level_count; ++level)
+    {
+        level_sizes_[level] += other.level_sizes_[level];
+    }
+
+    other.entries_.clear();
+    other.cells_.clear();
+    other.level_sizes_.fill(0);
+}
+
+void spatial_index::refresh(const transform_store& transforms)
+{
+    const std::vector<node2d*>& nodes = transforms.nodes();
+    const std::vector<aabb2d>& world_bounds = transforms.world_bounds();
+    const std::vector<uint32_t>& world_versions = transforms.world_versions();
+
+    // Nodes that didn't move are not visited, the cost only depends on the number of moved nodes
+    for(const transform_store::slot_type slot : transforms.changed_bounds())
+    {
+        assert(nodes[slot]);
+
+        const entry_type index = nodes[slot]->spatial_entry_;
+        if(index != invalid_entry && world_versions[slot] != entries_[index].world_version)
+        {
+            update(index, world_bounds[slot], world_versions[slot]);
+        }
+    }
+}
+
+void spatial_index::query(const aabb2d& region, std::vector<node2d*>& found) const
+{
+    visit(region, [&region, &found](const cell_entry& candidate)
+    {
+        if(candidate.world_bounds.intersects(region))
+        {
+            found.push_back(candidate.indexed_node);
+        }
+    });
+}
+
+void spatial_index::query(const glm::vec2& center, float radius, std::vector<node2d*>& found) const
+{
+    const float radius_squared = radius * radius;
+
+    const aabb2d region = aabb2d::from_center(center, glm::vec2{radius});
+
+    visit(region, [&center, radius_squared, &found](const cell_entry& candidate)
+    {
+        if(candidate.world_bounds.distance_squared(center) <= radius_squared)
+        {
+            found.push_back(candidate.indexed_node);
+        }
+    });
+}
+
+void spatial_index::nearest(const glm::vec2& point, std::size_t count, std::vector<node2d*>& found) const
+{
+    struct candidate
+    {
+        float distance_squared;
+        node2d* candidate_node;
+    };
+
+    count = std::min(count, entries_.size());
+    if(count == 0)
+    {
+        return;
+    }
+
+    // Nodes outside the radius are farther than every node inside, so the closest nodes are found once the radius
+    // contains enough nodes
+    std::vector<candidate> candidates;
+    for(float radius = cell_size_;; radius *= 2.f)
+    {
+        const float radius_squared = radius * radius;
+
+        candidates.clear();
+        const aabb2d region = aabb2d::from_center(point, glm::vec2{radius});
+
+        visit(region, [&point, radius_squared, &candidates](const cell_entry& visited)
+        {
+            const float distance_squared = visited.world_bounds.distance_squared(point);
+            if(distance_squared <= radius_squared)
+            {
+                candidates.push_back(candidate{distance_squared, visited.indexed_node});
+            }
+        });
+
+        if(candidates.size() >= count || std::isinf(radius))
+        {
+            break;
+        }
+    }
+
+    count = std::min(count, candidates.size());
+
+    std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(),
+                      [](const candidate& a, const candidate& b)
+                      {
+                          return a.distance_squared < b.distance_squared;
+                      });
+
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        found.push_back(candidates[i].candidate_node);
+    }
+}
+
+const aabb2d& spatial_index::world_bounds(entry_type index) const noexcept
+{
+    assert(index < entries_.size());
+
+    const entry& bounded = entries_[index];
+
+    return (*bounded.entry_cell)[bounded.index_in_cell].world_bounds;
+}
+
+std::size_t spatial_index::size() const noexcept
+{
+    return entries_.size();
+}
+
+}
\ No newline at end of file
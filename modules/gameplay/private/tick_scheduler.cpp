@@ -0,0 +1,349 @@
+#include "tick_scheduler.hpp"
+#include "node.hpp"
+
+#include <ng/core/thread_pool.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+namespace ng
+{
+
+namespace
+{
+
+/**
+ * Marks the scheduler as ticking while in scope
+ */
+struct tick_scope
+{
+    bool& ticking;
+
+    explicit tick_scope(bool& ticking) noexcept
+    : ticking{ticking}
+    {
+        ticking = true;
+    }
+
+    ~tick_scope()
+    {
+        ticking = false;
+    }
+};
+
+// Buckets are sorted by the type of their nodes
+constexpr auto bucket_type_less = [](const auto& bucket, std::size_t type) noexcept
+{
+    return bucket.type < type;
+};
+
+// Fewer nodes per range would spend more time waking up workers than ticking
+constexpr std::size_t nodes_per_range = 64;
+
+}
+
+tick_scheduler::tick_scheduler()
+: groups_()
+, order_()
+, order_outdated_{true}
+, registrations_()
+, ticking_{false}
+, holes_{false}
+, pending_registrations_()
+{
+    add_group(tick_group_settings{});
+    add_group(tick_group_settings{}, {pre_physics});
+    add_group(tick_group_settings{}, {physics});
+    add_group(tick_group_settings{}, {post_physics});
+}
+
+tick_group_id tick_scheduler::add_group(const tick_group_settings& settings, std::vector<tick_group_id> dependencies)
+{
+    const tick_group_id group_id = groups_.size();
+
+#ifndef NDEBUG
+    for(tick_group_id dependency : dependencies)
+    {
+        // Only existing groups can be dependencies so a new group can't create a cycle
+        assert(dependency < group_id);
+    }
+#endif
+
+    group new_group;
+    new_group.settings = settings;
+    new_group.dependencies = std::move(dependencies);
+    groups_.push_back(std::move(new_group));
+
+    order_outdated_ = true;
+
+    return group_id;
+}
+
+void tick_scheduler::add_dependency(tick_group_id group_id, tick_group_id dependency)
+{
+    assert(group_id < groups_.size());
+    assert(dependency < groups_.size());
+
+    std::vector<tick_group_id>& dependencies = groups_[group_id].dependencies;
+    if(std::find(dependencies.begin(), dependencies.end(), dependency) != dependencies.end())
+    {
+        return;
+    }
+
+    dependencies.push_back(dependency);
+
+    // Sorting right away reports the cycle to the caller instead of the next tick
+    try
+    {
+        sort_groups();
+    }
+    catch(...)
+    {
+        dependencies.pop_back();
+        order_outdated_ = true;
+        throw;
+    }
+}
+
+tick_group_settings& tick_scheduler::settings(tick_group_id group_id) noexcept
+{
+    assert(group_id < groups_.size());
+
+    return groups_[group_id].settings;
+}
+
+const tick_group_settings& tick_scheduler::settings(tick_group_id group_id) const noexcept
+{
+    assert(group_id < groups_.size());
+
+    return groups_[group_id].settings;
+}
+
+void tick_scheduler::sort_groups()
+{
+    // Groups are taken in the order they were created when nothing orders them
+    std::vector<std::size_t> remaining_dependencies(groups_.size());
+    std::vector<std::vector<tick_group_id>> dependents(groups_.size());
+    for(tick_group_id group_id = 0; group_id < groups_.size(); ++group_id)
+    {
+        remaining_dependencies[group_id] = groups_[group_id].dependencies.size();
+        for(tick_group_id dependency : groups_[group_id].dependencies)
+        {
+            dependents[dependency].push_back(group_id);
+        }
+    }
+
+    std::vector<tick_group_id> order;
+    order.reserve(groups_.size());
+
+    std::vector<bool> sorted(groups_.size(), false);
+    while(order.size() < groups_.size())
+    {
+        tick_group_id ready = groups_.size();
+        for(tick_group_id group_id = 0; group_id < groups_.size(); ++group_id)
+        {
+            if(!sorted[group_id] && remaining_dependencies[group_id] == 0)
+            {
+                ready = group_id;
+                break;
+            }
+        }
+
+        if(ready == groups_.size())
+        {
+            throw std::logic_error("tick groups depend on each other");
+        }
+
+        sorted[ready] = true;
+        order.push_back(ready);
+
+        for(tick_group_id dependent : dependents[ready])
+        {
+            --remaining_dependencies[dependent];
+        }
+    }
+
+    order_ = std::move(order);
+    order_outdated_ = false;
+}
+
+void tick_scheduler::add(node* registered_node, tick_group_id group_id, std::size_t type, tick_function tick)
+{
+    assert(registered_node);
+    assert(group_id < groups_.size());
+    assert(!contains(registered_node));
+
+    if(ticking_)
+    {
+        pending_registrations_.push_back(pending_registration{registered_node, group_id, type, tick});
+    }
+    else
+    {
+        insert(registered_node, group_id, type, tick);
+    }
+
+    registered_node->tick_registered_ = true;
+}
+
+void tick_scheduler::insert(node* registered_node, tick_group_id group_id, std::size_t type, tick_function tick)
+{
+    std::vector<type_bucket>& buckets = groups_[group_id].buckets;
+
+    auto bucket_it = std::lower_bound(buckets.begin(), buckets.end(), type, bucket_type_less);
+
+    if(bucket_it == buckets.end() || bucket_it->type != type)
+    {
+        bucket_it = buckets.insert(bucket_it, type_bucket{type, tick, {}});
+    }
+
+    registrations_.emplace(registered_node, registration{group_id, type, bucket_it->nodes.size()});
+    bucket_it->nodes.push_back(registered_node);
+}
+
+void tick_scheduler::remove(const node* registered_node) noexcept
+{
+    auto registration_it = registrations_.find(registered_node);
+    if(registration_it == registrations_.end())
+    {
+        // Nodes registered while ticking are only waiting to be inserted
+        auto pending_it = std::find_if(pending_registrations_.begin(), pending_registrations_.end(),
+                                       [registered_node](const pending_registration& pending)
+                                       {
+                                           return pending.registered_node == registered_node;
+                                       });
+
+        if(pending_it != pending_registrations_.end())
+        {
+            pending_it->registered_node->tick_registered_ = false;
+            pending_registrations_.erase(pending_it);
+        }
+
+        return;
+    }
+
+    const registration removed = registration_it->second;
+    registrations_.erase(registration_it);
+
+    std::vector<type_bucket>& buckets = groups_[removed.group].buckets;
+    auto bucket_it = std::lower_bound(buckets.begin(), buckets.end(), removed.type, bucket_type_less);
+
+    assert(bucket_it != buckets.end() && bucket_it->type == removed.type);
+
+    std::vector<node*>& nodes = bucket_it->nodes;
+    nodes[removed.index]->tick_registered_ = false;
+
+    if(ticking_)
+    {
+        // The nodes of the bucket could be ticking, they are moved once the tick is over
+        nodes[removed.index] = nullptr;
+        holes_ = true;
+    }
+    else
+    {
+        node* moved_node = nodes.back();
+        nodes[removed.index] = moved_node;
+        nodes.pop_back();
+
+        if(moved_node != registered_node)
+        {
+            registrations_.find(moved_node)->second.index = removed.index;
+        }
+    }
+}
+
+bool tick_scheduler::contains(const node* registered_node) const noexcept
+{
+    return registered_node->tick_registered_;
+}
+
+void tick_scheduler::remove_holes()
+{
+    for(group& g : groups_)
+    {
+        for(type_bucket& bucket : g.buckets)
+        {
+            std::size_t kept_count = 0;
+            for(node* n : bucket.nodes)
+            {
+                if(n)
+                {
+                    registrations_.find(n)->second.index = kept_count;
+                    bucket.nodes[kept_count++] = n;
+                }
+            }
+
+            bucket.nodes.resize(kept_count);
+        }
+    }
+
+    holes_ = false;
+}
+
+void tick_scheduler::tick(frame_duration dt, thread_pool* pool)
+{
+    if(order_outdated_)
+    {
+        sort_groups();
+    }
+
+    {
+        tick_scope scope{ticking_};
+
+        for(tick_group_id group_id : order_)
+        {
+            group& g = groups_[group_id];
+
+            g.elapsed += dt;
+            if(g.elapsed < g.settings.interval)
+            {
+                continue;
+            }
+
+            // A group ticking at an interval catches up with the time elapsed since it last ticked
+            const frame_duration group_dt = g.elapsed;
+            g.elapsed = frame_duration{0};
+
+            for(type_bucket& bucket : g.buckets)
+            {
+                if(pool && g.settings.thread_safe && bucket.nodes.size() > nodes_per_range)
+                {
+                    const auto tick_range = [&bucket, group_dt](std::size_t begin, std::size_t end)
+                    {
+                        bucket.tick(bucket.nodes.data() + begin, end - begin, group_dt);
+                    };
+
+                    pool->parallel_for(bucket.nodes.size(), nodes_per_range, tick_range);
+                }
+                else
+                {
+                    bucket.tick(bucket.nodes.data(), bucket.nodes.size(), group_dt);
+                }
+            }
+        }
+    }
+
+    if(holes_)
+    {
+        remove_holes();
+    }
+
+    for(const pending_registration& pending : pending_registrations_)
+    {
+        insert(pending.registered_node, pending.group, pending.type, pending.tick);
+    }
+
+    pending_registrations_.clear();
+}
+
+void tick_scheduler::tick(frame_duration dt)
+{
+    tick(dt, nullptr);
+}
+
+void tick_scheduler::tick(frame_duration dt, thread_pool& pool)
+{
+    tick(dt, &pool);
+}
+
+}
\ No newline at end of file
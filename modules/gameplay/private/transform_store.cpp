@@ -0,0 +1,702 @@
+#include "transform_store.hpp"
+#include "node2d.hpp"
+
+#include <ng/core/thread_pool.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <cassert>
+
+namespace ng
+{
+
+namespace
+{
+
+template<typename T>
+void apply_order(std::vector<T>& values, const std::vector<transform_store::slot_type>& order)
+{
+    // The capacity is kept, a store that is emptied and filled again every frame doesn't grow its arrays every time
+    std::vector<T> sorted_values;
+    sorted_values.reserve(values.capacity());
+
+    for(const transform_store::slot_type slot : order)
+    {
+        sorted_values.push_back(values[slot]);
+    }
+
+    values.swap(sorted_values);
+}
+
+}
+
+transform_store::transform_store() noexcept
+: nodes_()
+, parents_()
+, bounds_parents_()
+, local_translations_()
+, local_rotations_()
+, local_scales_()
+, local_affines_()
+, worlds_()
+, previous_worlds_()
+, world_versions_()
+, parent_versions_()
+, flags_()
+, local_bounds_()
+, world_bounds_()
+, subtree_bounds_()
+, changed_bounds_()
+, first_outdated_{0}
+, first_bounds_outdated_{0}
+, released_count_{0}
+, order_outdated_{false}
+, levels_outdated_{false}
+, level_offsets_{0, 0}
+{
+
+}
+
+void transform_store::mark_outdated(slot_type slot) noexcept
+{
+    flags_[slot] |= local_changed;
+    first_outdated_ = std::min(first_outdated_, slot);
+}
+
+void transform_store::mark_bounds_outdated(slot_type slot) noexcept
+{
+    flags_[slot] |= bounds_changed;
+    first_bounds_outdated_ = std::min(first_bounds_outdated_, slot);
+}
+
+transform_store::slot_type transform_store::add(node2d* n, slot_type parent, slot_type bounds_parent)
+{
+    assert(n);
+    assert(parent == invalid_slot || parent == bounds_parent);
+    assert(bounds_parent == invalid_slot || bounds_parent < size());
+    assert(size() < invalid_slot);
+
+    // A new slot is always stored after its ancestors
+    const slot_type slot = static_cast<slot_type>(size());
+
+    nodes_.push_back(n);
+    parents_.push_back(parent);
+    bounds_parents_.push_back(bounds_parent);
+    local_translations_.emplace_back(0.f, 0.f);
+    local_rotations_.push_back(0.f);
+    local_scales_.emplace_back(1.f, 1.f);
+    local_affines_.emplace_back();
+    worlds_.emplace_back();
+    previous_worlds_.emplace_back();
+    world_versions_.push_back(0);
+    parent_versions_.push_back(0);
+    flags_.push_back(local_changed | previous_missing);
+    local_bounds_.emplace_back();
+    world_bounds_.emplace_back();
+    subtree_bounds_.emplace_back();
+
+    levels_outdated_ = true;
+    first_outdated_ = std::min(first_outdated_, slot);
+
+    return slot;
+}
+
+void transform_store::reserve(std::size_t count)
+{
+    const std::size_t required = size() + count;
+    if(required <= nodes_.capacity())
+    {
+        return;
+    }
+
+    const std::size_t capacity = std::max(required, nodes_.capacity() * 2);
+
+    nodes_.reserve(capacity);
+    parents_.reserve(capacity);
+    bounds_parents_.reserve(capacity);
+    local_translations_.reserve(capacity);
+    local_rotations_.reserve(capacity);
+    local_scales_.reserve(capacity);
+    local_affines_.reserve(capacity);
+    worlds_.reserve(capacity);
+    previous_worlds_.reserve(capacity);
+    world_versions_.reserve(capacity);
+    parent_versions_.reserve(capacity);
+    flags_.reserve(capacity);
+    local_bounds_.reserve(capacity);
+    world_bounds_.reserve(capacity);
+    subtree_bounds_.reserve(capacity);
+}
+
+void transform_store::append(transform_store& other)
+{
+    assert(&other != this);
+    assert(size() + other.size() < invalid_slot);
+
+    // Slots are only ordered by their parents, so the slots of either store can come first
+    if(size() < other.size())
+    {
+        std::swap(*this, other);
+    }
+
+    const slot_type offset = static_cast<slot_type>(size());
+    const std::size_t count = other.size();
+
+    reserve(count);
+
+    nodes_.insert(nodes_.end(), other.nodes_.begin(), other.nodes_.end());
+    parents_.insert(parents_.end(), other.parents_.begin(), other.parents_.end());
+    bounds_parents_.insert(bounds_parents_.end(), other.bounds_parents_.begin(), other.bounds_parents_.end());
+    local_translations_.insert(local_translations_.end(), other.local_translations_.begin(), other.local_translations_.end());
+    local_rotations_.insert(local_rotations_.end(), other.local_rotations_.begin(), other.local_rotations_.end());
+    local_scales_.insert(local_scales_.end(), other.local_scales_.begin(), other.local_scales_.end());
+    local_affines_.insert(local_affines_.end(), other.local_affines_.begin(), other.local_affines_.end());
+    worlds_.insert(worlds_.end(), other.worlds_.begin(), other.worlds_.end());
+    previous_worlds_.insert(previous_worlds_.end(), other.previous_worlds_.begin(), other.previous_worlds_.end());
+    world_versions_.insert(world_versions_.end(), other.world_versions_.begin(), other.world_versions_.end());
+    parent_versions_.insert(parent_versions_.end(), other.parent_versions_.begin(), other.parent_versions_.end());
+    flags_.insert(flags_.end(), other.flags_.begin(), other.flags_.end());
+    local_bounds_.insert(local_bounds_.end(), other.local_bounds_.begin(), other.local_bounds_.end());
+    world_bounds_.insert(world_bounds_.end(), other.world_bounds_.begin(), other.world_bounds_.end());
+    subtree_bounds_.insert(subtree_bounds_.end(), other.subtree_bounds_.begin(), other.subtree_bounds_.end());
+
+    for(slot_type slot = offset; slot < size(); ++slot)
+    {
+        if(parents_[slot] != invalid_slot)
+        {
+            parents_[slot] += offset;
+        }
+
+        if(bounds_parents_[slot] != invalid_slot)
+        {
+            bounds_parents_[slot] += offset;
+        }
+
+        if(nodes_[slot])
+        {
+            nodes_[slot]->transform_slot_ = slot;
+        }
+
+        // The previous world transforms were captured by the other store
+        flags_[slot] |= previous_missing;
+    }
+
+    first_outdated_ = std::min(first_outdated_, static_cast<slot_type>(offset + other.first_outdated_));
+    first_bounds_outdated_ = std::min(first_bounds_outdated_, static_cast<slot_type>(offset + other.first_bounds_outdated_));
+    released_count_ += other.released_count_;
+    order_outdated_ = order_outdated_ || other.order_outdated_;
+    levels_outdated_ = true;
+
+    other.nodes_.clear();
+    other.parents_.clear();
+    other.bounds_parents_.clear();
+    other.local_translations_.clear();
+    other.local_rotations_.clear();
+    other.local_scales_.clear();
+    other.local_affines_.clear();
+    other.worlds_.clear();
+    other.previous_worlds_.clear();
+    other.world_versions_.clear();
+    other.parent_versions_.clear();
+    other.flags_.clear();
+    other.local_bounds_.clear();
+    other.world_bounds_.clear();
+    other.subtree_bounds_.clear();
+    other.changed_bounds_.clear();
+    other.first_outdated_ = 0;
+    other.first_bounds_outdated_ = 0;
+    other.released_count_ = 0;
+    other.order_outdated_ = false;
+    other.levels_outdated_ = false;
+    other.level_offsets_ = {0, 0};
+
+    // The changed slots of both stores are only known again after the next update
+    changed_bounds_.clear();
+}
+
+void transform_store::release(slot_type slot) noexcept
+{
+    assert(slot < size());
+    assert(nodes_[slot]);
+
+    // The arrays are compacted on the next update, so slots stay valid until then
+    nodes_[slot] = nullptr;
+    ++released_count_;
+}
+
+void transform_store::set_parent(slot_type slot, slot_type parent, slot_type bounds_parent) noexcept
+{
+    assert(slot < size());
+    assert(parent != slot);
+    assert(parent == invalid_slot || parent == bounds_parent);
+
+    set_bounds_parent(slot, bounds_parent);
+
+    // Moving under another node of the same node2d keeps the world transform
+    if(parents_[slot] == parent)
+    {
+        return;
+    }
+
+    parents_[slot] = parent;
+    mark_outdated(slot);
+}
+
+void transform_store::set_bounds_parent(slot_type slot, slot_type bounds_parent) noexcept
+{
+    assert(slot < size());
+    assert(bounds_parent != slot);
+
+    if(bounds_parents_[slot] == bounds_parent)
+    {
+        return;
+    }
+
+    // The previous ancestor loses the bounds of the subtree and the new one gains them
+    if(bounds_parents_[slot] != invalid_slot)
+    {
+        mark_bounds_outdated(bounds_parents_[slot]);
+    }
+
+    bounds_parents_[slot] = bounds_parent;
+    mark_bounds_outdated(slot);
+
+    // The depth of the whole subtree changed
+    levels_outdated_ = true;
+
+    // Children stored before their ancestors can't be computed in a single pass
+    if(bounds_parent != invalid_slot && bounds_parent > slot)
+    {
+        order_outdated_ = true;
+    }
+}
+
+transform2d transform_store::local_transform(slot_type slot) const noexcept
+{
+    assert(slot < size());
+
+    return transform2d{local_translations_[slot], local_rotations_[slot], local_scales_[slot]};
+}
+
+void transform_store::set_local_transform(slot_type slot, const transform2d& transform) noexcept
+{
+    set_local_transform(slot, transform, affine2d{transform});
+}
+
+void transform_store::set_local_transform(slot_type slot, const transform2d& transform, const affine2d& affine) noexcept
+{
+    assert(slot < size());
+
+    local_translations_[slot] = transform.translation;
+    local_rotations_[slot] = transform.rotation;
+    local_scales_[slot] = transform.scale;
+    local_affines_[slot] = affine;
+
+    mark_outdated(slot);
+}
+
+void transform_store::set_world_transform(slot_type slot, const transform2d& transform) noexcept
+{
+    assert(slot < size());
+
+    const affine2d world_affine{transform};
+    const slot_type parent = parents_[slot];
+
+    if(parent != invalid_slot)
+    {
+        const affine2d local_affine = world(parent).inverse() * world_affine;
+        const transform2d local{local_affine.matrix()};
+
+        local_translations_[slot] = local.translation;
+        local_rotations_[slot] = local.rotation;
+        local_scales_[slot] = local.scale;
+        local_affines_[slot] = local_affine;
+        parent_versions_[slot] = world_versions_[parent];
+    }
+    else
+    {
+        local_translations_[slot] = transform.translation;
+        local_rotations_[slot] = transform.rotation;
+        local_scales_[slot] = transform.scale;
+        local_affines_[slot] = world_affine;
+    }
+
+    // The world transform is already known, but children must still be updated
+    worlds_[slot] = world_affine;
+    ++world_versions_[slot];
+    flags_[slot] = (flags_[slot] & ~local_changed) | bounds_changed;
+    first_outdated_ = std::min(first_outdated_, slot);
+}
+
+const aabb2d& transform_store::local_bounds(slot_type slot) const noexcept
+{
+    assert(slot < size());
+
+    return local_bounds_[slot];
+}
+
+void transform_store::set_local_bounds(slot_type slot, const aabb2d& bounds) noexcept
+{
+    assert(slot < size());
+
+    local_bounds_[slot] = bounds;
+    mark_bounds_outdated(slot);
+}
+
+const affine2d& transform_store::world(slot_type slot) const noexcept
+{
+    assert(slot < size());
+
+    if(const slot_type parent = parents_[slot]; parent != invalid_slot)
+    {
+        // Make sure the parent is up to date before checking if it changed since our world transform was computed
+        const affine2d& parent_world = world(parent);
+
+        if((flags_[slot] & local_changed) || parent_versions_[slot] != world_versions_[parent])
+        {
+            worlds_[slot] = parent_world * local_affines_[slot];
+            parent_versions_[slot] = world_versions_[parent];
+            ++world_versions_[slot];
+            flags_[slot] = (flags_[slot] & ~local_changed) | bounds_changed;
+        }
+    }
+    else if(flags_[slot] & local_changed)
+    {
+        worlds_[slot] = local_affines_[slot];
+        ++world_versions_[slot];
+        flags_[slot] = (flags_[slot] & ~local_changed) | bounds_changed;
+    }
+
+    return worlds_[slot];
+}
+
+void transform_store::sort()
+{
+    constexpr uint32_t unknown_depth = std::numeric_limits<uint32_t>::max();
+
+    const std::size_t count = size();
+
+    // Find the depth of every slot, released ancestors are treated as roots. The parent of a slot is also its closest
+    // node2d ancestor, so sorting by these ancestors stores parents before their children too
+    std::vector<uint32_t> depths(count, unknown_depth);
+    std::vector<slot_type> unknown_parents;
+    uint32_t max_depth = 0;
+
+    for(slot_type slot = 0; slot < count; ++slot)
+    {
+        slot_type current = slot;
+        while(current != invalid_slot && nodes_[current] && depths[current] == unknown_depth)
+        {
+            unknown_parents.push_back(current);
+            current = bounds_parents_[current];
+        }
+
+        uint32_t depth = (current != invalid_slot && nodes_[current]) ? depths[current] + 1 : 0;
+        while(!unknown_parents.empty())
+        {
+            depths[unknown_parents.back()] = depth++;
+            unknown_parents.pop_back();
+        }
+
+        if(nodes_[slot])
+        {
+            max_depth = std::max(max_depth, depths[slot]);
+        }
+    }
+
+    // Counting sort by depth, the relative order of slots with the same depth is kept
+    std::vector<std::size_t> depth_offsets(static_cast<std::size_t>(max_depth) + 2, 0);
+    for(slot_type slot = 0; slot < count; ++slot)
+    {
+        if(nodes_[slot])
+        {
+            ++depth_offsets[depths[slot] + 1];
+        }
+    }
+
+    std::partial_sum(depth_offsets.begin(), depth_offsets.end(), depth_offsets.begin());
+    level_offsets_ = depth_offsets;
+
+    std::vector<slot_type> order(count - released_count_);
+    std::vector<slot_type> new_slots(count, invalid_slot);
+    for(slot_type slot = 0; slot < count; ++slot)
+    {
+        if(nodes_[slot])
+        {
+            const slot_type new_slot = static_cast<slot_type>(depth_offsets[depths[slot]]++);
+
+            order[new_slot] = slot;
+            new_slots[slot] = new_slot;
+        }
+    }
+
+    apply_order(nodes_, order);
+    apply_order(parents_, order);
+    apply_order(bounds_parents_, order);
+    apply_order(local_translations_, order);
+    apply_order(local_rotations_, order);
+    apply_order(local_scales_, order);
+    apply_order(local_affines_, order);
+    apply_order(worlds_, order);
+    apply_order(previous_worlds_, order);
+    apply_order(world_versions_, order);
+    apply_order(parent_versions_, order);
+    apply_order(flags_, order);
+    apply_order(local_bounds_, order);
+    apply_order(world_bounds_, order);
+    apply_order(subtree_bounds_, order);
+
+    for(slot_type slot = 0; slot < nodes_.size(); ++slot)
+    {
+        nodes_[slot]->transform_slot_ = slot;
+
+        // Released slots could have been part of any subtree
+        flags_[slot] |= bounds_changed;
+
+        if(const slot_type parent = parents_[slot]; parent != invalid_slot)
+        {
+            parents_[slot] = new_slots[parent];
+
+            // The parent was released, there is nothing left to inherit from
+            if(parents_[slot] == invalid_slot)
+            {
+                flags_[slot] |= local_changed;
+            }
+        }
+
+        if(const slot_type bounds_parent = bounds_parents_[slot]; bounds_parent != invalid_slot)
+        {
+            bounds_parents_[slot] = new_slots[bounds_parent];
+        }
+    }
+
+    released_count_ = 0;
+    order_outdated_ = false;
+    levels_outdated_ = false;
+    first_outdated_ = 0;
+    first_bounds_outdated_ = 0;
+}
+
+void transform_store::update_range(slot_type begin, slot_type end) const noexcept
+{
+    for(slot_type slot = begin; slot < end; ++slot)
+    {
+        const slot_type parent = parents_[slot];
+
+        if(parent == invalid_slot)
+        {
+            if(flags_[slot] & local_changed)
+            {
+                worlds_[slot] = local_affines_[slot];
+                ++world_versions_[slot];
+                flags_[slot] = (flags_[slot] & ~local_changed) | bounds_changed;
+            }
+        }
+        else if((flags_[slot] & local_changed) || parent_versions_[slot] != world_versions_[parent])
+        {
+            assert(parent < slot);
+
+            worlds_[slot] = worlds_[parent] * local_affines_[slot];
+            parent_versions_[slot] = world_versions_[parent];
+            ++world_versions_[slot];
+            flags_[slot] = (flags_[slot] & ~local_changed) | bounds_changed;
+        }
+    }
+}
+
+void transform_store::update_bounds(slot_type first_changed) noexcept
+{
+    const slot_type count = static_cast<slot_type>(size());
+
+    changed_bounds_.clear();
+
+    // Flag every ancestor of a changed slot, stopping at the ancestors already flagged by another slot
+    slot_type first_merged = count;
+    for(slot_type slot = first_changed; slot < count; ++slot)
+    {
+        if(!(flags_[slot] & bounds_changed))
+        {
+            continue;
+        }
+
+        world_bounds_[slot] = local_bounds_[slot].transform(worlds_[slot]);
+        flags_[slot] &= ~bounds_changed;
+        changed_bounds_.push_back(slot);
+
+        for(slot_type ancestor = slot; ancestor != invalid_slot && !(flags_[ancestor] & subtree_bounds_outdated);
+            ancestor = bounds_parents_[ancestor])
+        {
+            flags_[ancestor] |= subtree_bounds_outdated;
+            first_merged = std::min(first_merged, ancestor);
+        }
+    }
+
+    if(first_merged == count)
+    {
+        return;
+    }
+
+    for(slot_type slot = first_merged; slot < count; ++slot)
+    {
+        if(flags_[slot] & subtree_bounds_outdated)
+        {
+            subtree_bounds_[slot] = world_bounds_[slot];
+        }
+    }
+
+    // Slots are stored after their ancestors, so every subtree is complete before being merged in its ancestor
+    for(slot_type slot = count - 1; slot > first_merged; --slot)
+    {
+        const slot_type parent = bounds_parents_[slot];
+        if(parent != invalid_slot && (flags_[parent] & subtree_bounds_outdated))
+        {
+            subtree_bounds_[parent] = subtree_bounds_[parent].merge(subtree_bounds_[slot]);
+        }
+    }
+
+    for(slot_type slot = first_merged; slot < count; ++slot)
+    {
+        flags_[slot] &= ~subtree_bounds_outdated;
+    }
+}
+
+void transform_store::update()
+{
+    if(order_outdated_ || released_count_ > 0)
+    {
+        sort();
+    }
+
+    update_range(first_outdated_, static_cast<slot_type>(size()));
+    update_bounds(std::min(first_outdated_, first_bounds_outdated_));
+
+    first_outdated_ = static_cast<slot_type>(size());
+    first_bounds_outdated_ = static_cast<slot_type>(size());
+}
+
+void transform_store::update(thread_pool& pool)
+{
+    // Small enough to avoid false sharing between threads, large enough to hide the cost of scheduling
+    constexpr std::size_t slots_per_task = 4096;
+
+    if(order_outdated_ || levels_outdated_ || released_count_ > 0)
+    {
+        sort();
+    }
+
+    // A level only reads the world transforms of the previous level
+    for(std::size_t level = 0; level + 1 < level_offsets_.size(); ++level)
+    {
+        const std::size_t level_begin = std::max<std::size_t>(level_offsets_[level], first_outdated_);
+        const std::size_t level_end = level_offsets_[level + 1];
+
+        if(level_begin >= level_end)
+        {
+            continue;
+        }
+
+        pool.parallel_for(level_end - level_begin, slots_per_task, [this, level_begin](std::size_t begin, std::size_t end)
+        {
+            update_range(static_cast<slot_type>(level_begin + begin), static_cast<slot_type>(level_begin + end));
+        });
+    }
+
+    update_bounds(std::min(first_outdated_, first_bounds_outdated_));
+
+    first_outdated_ = static_cast<slot_type>(size());
+    first_bounds_outdated_ = static_cast<slot_type>(size());
+}
+
+void transform_store::capture()
+{
+    std::copy(worlds_.begin(), worlds_.end(), previous_worlds_.begin());
+
+    for(uint8_t& flags : flags_)
+    {
+        flags &= ~previous_missing;
+    }
+}
+
+void transform_store::interpolate(float alpha, std::vector<affine2d>& interpolated) const
+{
+    interpolated.resize(size());
+
+    ng::interpolate(previous_worlds_.data(), worlds_.data(), interpolated.data(), size(), alpha);
+
+    // Slots added since the last capture don't move in from their previous transform
+    for(std::size_t slot = 0; slot < size(); ++slot)
+    {
+        if(flags_[slot] & previous_missing)
+        {
+            interpolated[slot] = worlds_[slot];
+        }
+    }
+}
+
+const std::vector<node2d*>& transform_store::nodes() const noexcept
+{
+    return nodes_;
+}
+
+const std::vector<transform_store::slot_type>& transform_store::parents() const noexcept
+{
+    return parents_;
+}
+
+const std::vector<glm::vec2>& transform_store::local_translations() const noexcept
+{
+    return local_translations_;
+}
+
+const std::vector<float>& transform_store::local_rotations() const noexcept
+{
+    return local_rotations_;
+}
+
+const std::vector<glm::vec2>& transform_store::local_scales() const noexcept
+{
+    return local_scales_;
+}
+
+const std::vector<affine2d>& transform_store::worlds() const noexcept
+{
+    return worlds_;
+}
+
+const std::vector<aabb2d>& transform_store::world_bounds() const noexcept
+{
+    return world_bounds_;
+}
+
+const std::vector<aabb2d>& transform_store::subtree_bounds() const noexcept
+{
+    return subtree_bounds_;
+}
+
+const std::vector<affine2d>& transform_store::previous_worlds() const noexcept
+{
+    return previous_worlds_;
+}
+
+const std::vector<uint32_t>& transform_store::world_versions() const noexcept
+{
+    return world_versions_;
+}
+
+const std::vector<transform_store::slot_type>& transform_store::changed_bounds() const noexcept
+{
+    return changed_bounds_;
+}
+
+const std::vector<std::size_t>& transform_store::level_offsets() const noexcept
+{
+    return level_offsets_;
+}
+
+std::size_t transform_store::size() const noexcept
+{
+    return nodes_.size();
+}
+
+}
\ No newline at end of file
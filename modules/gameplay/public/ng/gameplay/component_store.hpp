@@ -0,0 +1,458 @@
+#ifndef NGINE_GAMEPLAY_COMPONENT_STORE_HPP
+#define NGINE_GAMEPLAY_COMPONENT_STORE_HPP
+
+#include "node.hpp"
+
+#include <ng/core/thread_pool.hpp>
+
+#include <array>
+#include <memory>
+#include <new>
+#include <vector>
+#include <unordered_map>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace ng
+{
+
+// One bit per type of component, given by component_index
+using component_mask = uint64_t;
+
+constexpr std::size_t max_component_types = std::numeric_limits<component_mask>::digits;
+
+/**
+ * Returns a new index every time it is called
+ * @return A new index
+ */
+[[nodiscard]] std::size_t next_component_index() noexcept;
+
+/**
+ * Returns the index of a type of component, the same for every store
+ * @tparam Component The type of component
+ * @return The index of the component type
+ */
+template<typename Component>
+[[nodiscard]] std::size_t component_index() noexcept
+{
+    static const std::size_t index = next_component_index();
+    assert(index < max_component_types);
+
+    return index;
+}
+
+/**
+ * Returns the mask of a set of component types
+ * @tparam Components The types of components
+ * @return A mask with the bit of each type set
+ */
+template<typename... Components>
+[[nodiscard]] component_mask component_mask_of() noexcept
+{
+    return (component_mask{0} | ... | (component_mask{1} << component_index<Components>()));
+}
+
+/**
+ * Moves and destroys a type of component stored in raw memory
+ */
+struct component_type
+{
+    std::size_t index;
+    std::size_t size;
+    std::size_t alignment;
+
+    // Move construct the component at destination then destroy the source
+    void (*relocate)(void* destination, void* source) noexcept;
+    void (*destroy)(void* component) noexcept;
+
+    template<typename Component>
+    [[nodiscard]] static const component_type& of() noexcept
+    {
+        static const component_type type{
+            component_index<Component>(),
+            sizeof(Component),
+            alignof(Component),
+            [](void* destination, void* source) noexcept
+            {
+                Component* moved = static_cast<Component*>(source);
+                new(destination) Component(std::move(*moved));
+                moved->~Component();
+            },
+            [](void* component) noexcept
+            {
+                static_cast<Component*>(component)->~Component();
+            }
+        };
+
+        return type;
+    }
+};
+
+/**
+ * Stores the components of the nodes having exactly the same component types
+ * Rows are packed in fixed size chunks, each chunk stores the nodes then one array per component type, so iterating a
+ * component of a chunk reads contiguous memory. Every chunk is full except the last one
+ */
+class component_archetype
+{
+    friend class component_store;
+
+public:
+    using row_type = uint32_t;
+
+    static constexpr std::size_t chunk_size = 16 * 1024;
+    static constexpr std::size_t chunk_alignment = 64;
+
+private:
+    static constexpr uint8_t no_column = std::numeric_limits<uint8_t>::max();
+
+    struct chunk_deleter
+    {
+        void operator()(std::byte* memory) const noexcept;
+    };
+
+    struct column
+    {
+        const component_type* type;
+
+        // Offset of the array of the component in every chunk
+        std::size_t offset;
+    };
+
+    component_mask mask_;
+
+    // Sorted by component index
+    std::vector<column> columns_;
+
+    // Column of each component index or no_column
+    std::array<uint8_t, max_component_types> column_indices_;
+
+    // Rows stored by a chunk
+    std::size_t chunk_capacity_;
+
+    // Chunks after the rows are kept to be reused
+    std::vector<std::unique_ptr<std::byte, chunk_deleter>> chunks_;
+
+    std::size_t size_;
+
+    component_archetype(component_mask mask, const std::vector<const component_type*>& types);
+
+    [[nodiscard]] node** nodes(std::size_t chunk) const noexcept;
+    [[nodiscard]] void* component(row_type row, std::size_t column) const noexcept;
+
+    /**
+     * Add a row at the end
+     * @param n The node of the row
+     * @return The new row, its components are not constructed
+     */
+    row_type push(node* n);
+
+    /**
+     * Move the last row in a row whose components were destroyed or moved
+     * @param row The emptied row
+     * @return The node moved in the row or nullptr when the row was the last one
+     */
+    node* pop(row_type row) noexcept;
+
+public:
+    ~component_archetype();
+
+    component_archetype(const component_archetype&) = delete;
+    component_archetype& operator=(const component_archetype&) = delete;
+
+    /**
+     * Returns the component types of the archetype
+     * @return The mask of the component types
+     */
+    [[nodiscard]] component_mask mask() const noexcept;
+
+    /**
+     * Returns the number of nodes stored
+     * @return The number of rows
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * Returns the number of chunks holding rows
+     * @return The number of chunks in use
+     */
+    [[nodiscard]] std::size_t chunk_count() const noexcept;
+
+    /**
+     * Returns the number of rows of a chunk
+     * @param chunk The index of the chunk
+     * @return The number of rows stored in the chunk
+     */
+    [[nodiscard]] std::size_t chunk_rows(std::size_t chunk) const noexcept;
+
+    /**
+     * Returns the nodes of a chunk
+     * @param chunk The index of the chunk
+     * @return The node of each row of the chunk
+     */
+    [[nodiscard]] node* const* chunk_nodes(std::size_t chunk) const noexcept;
+
+    /**
+     * Returns the array of a component in a chunk
+     * @tparam Component The type of component, it must be part of the archetype
+     * @param chunk The index of the chunk
+     * @return The component of each row of the chunk
+     */
+    template<typename Component>
+    [[nodiscard]] Component* chunk_components(std::size_t chunk) const noexcept
+    {
+        const uint8_t column_index = column_indices_[component_index<Component>()];
+        assert(column_index != no_column);
+
+        return reinterpret_cast<Component*>(chunks_[chunk].get() + columns_[column_index].offset);
+    }
+};
+
+/**
+ * Stores the components of the nodes of a tree, grouped by archetype
+ * A node can have one component of each type. Nodes having the same component types share an archetype, so per frame
+ * data of many nodes is iterated linearly from dense arrays instead of following pointers to each node.
+ * Adding or removing a component moves the components of the node to another archetype
+ * @note Components are moved in memory when nodes change archetype or leave an archetype, pointers to components
+ *       are only valid until the next component of the same archetype is added or removed
+ */
+class component_store
+{
+public:
+    using archetype_type = uint32_t;
+
+    static constexpr archetype_type no_archetype = std::numeric_limits<archetype_type>::max();
+
+private:
+    // Type of each component index, known once a component of the type was added
+    std::array<const component_type*, max_component_types> types_;
+
+    // Archetypes never move in memory, they are kept once created
+    std::vector<std::unique_ptr<component_archetype>> archetypes_;
+    std::unordered_map<component_mask, archetype_type> archetype_indices_;
+
+    // Chunks matching a parallel query
+    std::vector<std::pair<const component_archetype*, std::size_t>> query_chunks_;
+
+    [[nodiscard]] archetype_type archetype_of(component_mask mask);
+
+    /**
+     * Move the components of a node to the archetype of a mask
+     * @param n The node
+     * @param mask The component types of the node afterward
+     * @note Components that are not part of the mask are destroyed, new components are not constructed
+     */
+    void move(node* n, component_mask mask);
+
+    /**
+     * Give the storage of a new component to a node
+     * @param n The node
+     * @param type The type of the new component
+     * @return The memory of the component
+     */
+    [[nodiscard]] void* insert(node* n, const component_type& type);
+
+    [[nodiscard]] void* find(const node* n, std::size_t index) const noexcept;
+
+    template<typename... Components>
+    [[nodiscard]] bool matches(const component_archetype& archetype) const noexcept
+    {
+        const component_mask mask = component_mask_of<Components...>();
+
+        return archetype.size() > 0 && (archetype.mask() & mask) == mask;
+    }
+
+    template<typename... Components, typename Function>
+    static void run_chunk(const component_archetype& archetype, std::size_t chunk, Function& function)
+    {
+        node* const* nodes = archetype.chunk_nodes(chunk);
+        const std::size_t rows = archetype.chunk_rows(chunk);
+
+        const std::tuple<Components*...> components{archetype.chunk_components<Components>(chunk)...};
+        for(std::size_t row = 0; row < rows; ++row)
+        {
+            function(*nodes[row], std::get<Components*>(components)[row]...);
+        }
+    }
+
+public:
+    component_store();
+
+    component_store(const component_store&) = delete;
+    component_store& operator=(const component_store&) = delete;
+
+    /**
+     * Add a component to a node
+     * @tparam Component The type of the component
+     * @param n The node
+     * @param args The arguments given to the constructor of the component
+     * @return The component, replacing the component of the same type the node already had
+     */
+    template<typename Component, typename... Args>
+    Component& add(node* n, Args&&... args)
+    {
+        static_assert(std::is_nothrow_move_constructible_v<Component>, "Components are moved between archetypes");
+        static_assert(alignof(Component) <= component_archetype::chunk_alignment, "Expecting smaller alignment");
+        static_assert(sizeof(Component) < component_archetype::chunk_size, "Expecting smaller component");
+
+        // Built first so the node keeps its archetype when the constructor throws
+        Component component(std::forward<Args>(args)...);
+
+        if(Component* existing = find<Component>(n))
+        {
+            *existing = std::move(component);
+            return *existing;
+        }
+
+        return *new(insert(n, component_type::of<Component>())) Component(std::move(component));
+    }
+
+    /**
+     * Remove a component from a node
+     * @tparam Component The type of the component
+     * @param n The node, it can be missing the component
+     */
+    template<typename Component>
+    void remove(node* n)
+    {
+        if(find<Component>(n))
+        {
+            move(n, archetypes_[n->component_archetype_]->mask() & ~component_mask_of<Component>());
+        }
+    }
+
+    /**
+     * Remove every component of a node
+     * @param n The node
+     * @note Called when a node is destroyed
+     */
+    void remove_all(node* n) noexcept;
+
+    /**
+     * Find the component of a node
+     * @tparam Component The type of the component
+     * @param n The node
+     * @return The component or nullptr when the node doesn't have one
+     */
+    template<typename Component>
+    [[nodiscard]] Component* find(const node* n) noexcept
+    {
+        return static_cast<Component*>(find(n, component_index<Component>()));
+    }
+
+    template<typename Component>
+    [[nodiscard]] const Component* find(const node* n) const noexcept
+    {
+        return static_cast<const Component*>(find(n, component_index<Component>()));
+    }
+
+    /**
+     * Check if a node has components
+     * @tparam Components The types of the components
+     * @param n The node
+     * @return true when the node has a component of every type
+     */
+    template<typename... Components>
+    [[nodiscard]] bool has(const node* n) const noexcept
+    {
+        const component_mask mask = component_mask_of<Components...>();
+
+        return n->component_archetype_ != no_archetype && (archetypes_[n->component_archetype_]->mask() & mask) == mask;
+    }
+
+    /**
+     * Returns the number of nodes having components
+     * @tparam Components The types of the components
+     * @return The number of nodes having a component of every type
+     */
+    template<typename... Components>
+    [[nodiscard]] std::size_t count() const noexcept
+    {
+        std::size_t node_count = 0;
+        for(const std::unique_ptr<component_archetype>& archetype : archetypes_)
+        {
+            if(matches<Components...>(*archetype))
+            {
+                node_count += archetype->size();
+            }
+        }
+
+        return node_count;
+    }
+
+    /**
+     * Returns the archetypes created by this store
+     * @return The archetypes, including the ones without nodes
+     */
+    [[nodiscard]] const std::vector<std::unique_ptr<component_archetype>>& archetypes() const noexcept;
+
+    /**
+     * Call a function on every chunk of nodes having components
+     * @tparam Components The types of the components
+     * @param function Called with the archetype and the index of each matching chunk
+     * @note Components must not be added or removed during the iteration
+     */
+    template<typename... Components, typename Function>
+    void for_each_chunk(Function&& function)
+    {
+        for(const std::unique_ptr<component_archetype>& archetype : archetypes_)
+        {
+            if(matches<Components...>(*archetype))
+            {
+                for(std::size_t chunk = 0; chunk < archetype->chunk_count(); ++chunk)
+                {
+                    function(*archetype, chunk);
+                }
+            }
+        }
+    }
+
+    /**
+     * Call a function on every node having components
+     * @tparam Components The types of the components
+     * @param function Called with the node and a reference to each component
+     * @note Components must not be added or removed during the iteration
+     */
+    template<typename... Components, typename Function>
+    void for_each(Function&& function)
+    {
+        for_each_chunk<Components...>([&function](const component_archetype& archetype, std::size_t chunk)
+        {
+            run_chunk<Components...>(archetype, chunk, function);
+        });
+    }
+
+    /**
+     * Call a function on every node having components using multiple threads
+     * @tparam Components The types of the components
+     * @param pool The threads processing the chunks
+     * @param function Called with the node and a reference to each component, it must not throw
+     * @note Each chunk is processed by a single thread, the function must not change the tree or other nodes
+     */
+    template<typename... Components, typename Function>
+    void for_each(thread_pool& pool, Function&& function)
+    {
+        query_chunks_.clear();
+        for_each_chunk<Components...>([this](const component_archetype& archetype, std::size_t chunk)
+        {
+            query_chunks_.emplace_back(&archetype, chunk);
+        });
+
+        pool.parallel_for(query_chunks_.size(), 1, [this, &function](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t i = begin; i < end; ++i)
+            {
+                run_chunk<Components...>(*query_chunks_[i].first, query_chunks_[i].second, function);
+            }
+        });
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef NGINE_GAMEPLAY_EVENT_HPP
+#define NGINE_GAMEPLAY_EVENT_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ng
+{
+
+class node;
+class event_dispatcher;
+
+/**
+ * Base class of every event sent through a node tree
+ * Events dispatched to a target first go down from the top of the hierarchy to the target (capture), reach the
+ * target, then go back up to the top (bubble). Broadcast events are sent to every listener of a subtree
+ */
+class event
+{
+    friend event_dispatcher;
+
+public:
+    /**
+     * The phases an event goes through, listeners choose the phases they receive
+     */
+    enum phases : uint8_t
+    {
+        capture = 1 << 0,
+        at_target = 1 << 1,
+        bubble = 1 << 2,
+        broadcast = 1 << 3,
+
+        // Every phase of a dispatched event
+        dispatched = capture | at_target | bubble
+    };
+
+private:
+    node* target_;
+    node* current_node_;
+    phases phase_;
+    bool propagation_stopped_;
+    bool immediate_propagation_stopped_;
+
+public:
+    event() noexcept;
+    virtual ~event() = default;
+
+    /**
+     * Returns the node the event was dispatched to
+     * @return The target node or the root of the subtree when broadcasting
+     */
+    [[nodiscard]] node* target() const noexcept;
+
+    /**
+     * Returns the node currently receiving the event
+     * @return The node currently receiving the event
+     */
+    [[nodiscard]] node* current_node() const noexcept;
+
+    /**
+     * Returns the phase the event is in
+     * @return The phase of the event
+     */
+    [[nodiscard]] phases phase() const noexcept;
+
+    /**
+     * Stop sending the event to the next nodes, listeners of the current node still receive it
+     */
+    void stop_propagation() noexcept;
+
+    /**
+     * Stop sending the event, even to the next listeners of the current node
+     * @note Decorators listen before their node, they can use this to hide events from their node
+     */
+    void stop_immediate_propagation() noexcept;
+
+    /**
+     * Check if the event was stopped
+     * @return true when the event won't be sent to the next nodes
+     */
+    [[nodiscard]] bool propagation_stopped() const noexcept;
+};
+
+/**
+ * Returns a new index every time it is called
+ * @return A new index
+ */
+[[nodiscard]] std::size_t next_event_type_index() noexcept;
+
+/**
+ * Returns the index identifying a type of event
+ * @tparam EventType The type of event
+ * @return The index of the type of event
+ */
+template<typename EventType>
+[[nodiscard]] std::size_t event_type_index() noexcept
+{
+    static const std::size_t index = next_event_type_index();
+
+    return index;
+}
+
+}
+
+#endif
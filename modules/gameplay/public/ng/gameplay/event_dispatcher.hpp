@@ -0,0 +1,389 @@
+#ifndef NGINE_GAMEPLAY_EVENT_DISPATCHER_HPP
+#define NGINE_GAMEPLAY_EVENT_DISPATCHER_HPP
+
+#include "event.hpp"
+#include "node.hpp"
+
+#include <ng/core/memory_pool.hpp>
+
+#include <cassert>
+#include <memory>
+#include <new>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+namespace ng
+{
+
+/**
+ * Stores the queued events of a single type
+ */
+class event_pool
+{
+public:
+    virtual ~event_pool() = default;
+
+    /**
+     * Allocate the memory of an event
+     * @return The memory of an event
+     */
+    [[nodiscard]] virtual void* allocate() = 0;
+
+    /**
+     * Free the memory of an event that was never constructed
+     * @param memory The memory to free
+     */
+    virtual void free(void* memory) noexcept = 0;
+
+    /**
+     * Destroy an event and free its memory
+     * @param e The event to destroy
+     */
+    virtual void destroy(event* e) noexcept = 0;
+};
+
+template<typename EventType>
+class typed_event_pool final : public event_pool
+{
+    type_memory_pool<EventType> pool_;
+
+public:
+    [[nodiscard]] void* allocate() override
+    {
+        return pool_.allocate();
+    }
+
+    void free(void* memory) noexcept override
+    {
+        pool_.free(memory);
+    }
+
+    void destroy(event* e) noexcept override
+    {
+        EventType* typed_event = static_cast<EventType*>(e);
+        typed_event->~EventType();
+        pool_.free(typed_event);
+    }
+};
+
+/**
+ * Sends events to the nodes of a tree listening to them
+ * Listeners are stored per type of event and per node, dispatching only visits the nodes listening to the type of the
+ * event so the cost depends on the number of listeners instead of the number of nodes
+ */
+class event_dispatcher
+{
+public:
+    using listener_id = uint64_t;
+    using listener_function = std::function<void(event&)>;
+
+private:
+    struct listener
+    {
+        listener_id id;
+        listener_function function;
+        uint8_t phases;
+
+        // Set when the listener stopped listening while an event is sent, it is erased after the event was sent
+        bool removed;
+    };
+
+    struct node_listeners
+    {
+        // Listeners of decorators are stored first, they receive events before their node
+        std::vector<listener> listeners;
+        std::size_t decorator_count = 0;
+
+        // Index of the node in the listening nodes of the type
+        std::size_t node_index = 0;
+
+        // Set when the node was destroyed while an event is sent, it is erased after the event was sent
+        bool destroyed = false;
+    };
+
+    struct listening_node
+    {
+        // nullptr once the node stopped listening
+        node* listener_node;
+
+        // Elements of the map are never moved
+        node_listeners* listeners;
+    };
+
+    struct type_listeners
+    {
+        std::unordered_map<const node*, node_listeners> by_node;
+
+        // Every node listening to this type in the order they started listening, visited when broadcasting. Nodes
+        // that stopped listening leave a hole, the holes are removed together once they are half of the nodes
+        std::vector<listening_node> nodes;
+        std::size_t hole_count = 0;
+    };
+
+    struct listener_location
+    {
+        std::size_t type;
+        const node* listener_node;
+    };
+
+    struct pending_listener
+    {
+        std::size_t type;
+        node* listener_node;
+        listener new_listener;
+        bool decorator;
+    };
+
+    struct queued_event
+    {
+        event* queued;
+        event_pool* pool;
+        std::size_t type;
+        node* target;
+        bool broadcast;
+    };
+
+    // Indexed by event_type_index
+    std::vector<type_listeners> types_;
+    std::unordered_map<listener_id, listener_location> listener_locations_;
+    listener_id next_listener_id_;
+
+    // Listeners can't be changed while events are sent, the changes are applied once every dispatch is over
+    std::size_t dispatch_depth_;
+    std::vector<pending_listener> pending_listeners_;
+    std::vector<listener_id> pending_removals_;
+    bool pending_destroyed_nodes_;
+
+    // One pool per type of event, indexed by event_type_index
+    std::vector<std::unique_ptr<event_pool>> pools_;
+    std::vector<queued_event> queued_events_;
+
+    // Events being dispatched by dispatch_queued, events queued meanwhile wait for the next call
+    std::vector<queued_event> dispatched_events_;
+
+    listener_id add_listener(std::size_t type, node* listener_node, listener_function function, uint8_t phases,
+                             bool decorator);
+    void insert_listener(std::size_t type, node* listener_node, listener new_listener, bool decorator);
+    void erase_listener(listener_id id) noexcept;
+    void erase_listening_node(type_listeners& listeners,
+                              std::unordered_map<const node*, node_listeners>::iterator it) noexcept;
+    void erase_destroyed_nodes() noexcept;
+    void apply_pending_changes();
+
+    [[nodiscard]] listener* find_listener(listener_id id) noexcept;
+
+    void dispatch(event& e, std::size_t type, node* target);
+    void broadcast(event& e, std::size_t type, node* subtree_root);
+
+    /**
+     * Send an event to the listeners of a node
+     * @param e The event to send
+     * @param receiving_node The node receiving the event
+     * @param listeners The listeners of the node
+     * @param phase The phase of the event
+     */
+    static void deliver(event& e, node* receiving_node, const node_listeners& listeners, event::phases phase);
+
+    /**
+     * Returns the pool storing a type of events, creating it the first time
+     * @tparam EventType The type of events
+     * @return The pool storing the events of this type
+     */
+    template<typename EventType>
+    event_pool& pool_of()
+    {
+        const std::size_t index = event_type_index<EventType>();
+        if(index >= pools_.size())
+        {
+            pools_.resize(index + 1);
+        }
+
+        if(!pools_[index])
+        {
+            pools_[index] = std::make_unique<typed_event_pool<EventType>>();
+        }
+
+        return *pools_[index];
+    }
+
+    template<typename EventType, typename... Args>
+    EventType& emplace_queued(node* target, bool broadcast, Args&&... args)
+    {
+        static_assert(std::is_base_of_v<event, EventType>, "Expecting valid event type");
+
+        event_pool& pool = pool_of<EventType>();
+        void* memory = pool.allocate();
+
+        EventType* queued = nullptr;
+        try
+        {
+            queued = new(memory) EventType(std::forward<Args>(args)...);
+            queued_events_.push_back(queued_event{queued, &pool, event_type_index<EventType>(), target, broadcast});
+        }
+        catch(...)
+        {
+            if(queued)
+            {
+                queued->~EventType();
+            }
+
+            pool.free(memory);
+            throw;
+        }
+
+        return *queued;
+    }
+
+    /**
+     * Wrap a function receiving a type of event
+     */
+    template<typename EventType, typename Function>
+    static listener_function wrap(Function&& function)
+    {
+        static_assert(std::is_base_of_v<event, EventType>, "Expecting valid event type");
+
+        return [function = std::forward<Function>(function)](event& e)
+        {
+            function(static_cast<EventType&>(e));
+        };
+    }
+
+public:
+    event_dispatcher() noexcept;
+    ~event_dispatcher();
+
+    event_dispatcher(const event_dispatcher&) = delete;
+    event_dispatcher& operator=(const event_dispatcher&) = delete;
+
+    /**
+     * Listen to a type of event sent to a node
+     * @tparam EventType The type of event
+     * @param listener_node The node receiving the events
+     * @param function Called with every event received by the node
+     * @param phases The phases of the events to receive
+     * @return The identifier of the listener
+     * @note Listening while an event is sent only takes effect once the event was sent
+     */
+    template<typename EventType, typename Function>
+    listener_id listen(node* listener_node, Function&& function,
+                       uint8_t phases = event::dispatched | event::broadcast)
+    {
+        return add_listener(event_type_index<EventType>(), listener_node,
+                            wrap<EventType>(std::forward<Function>(function)), phases, false);
+    }
+
+    /**
+     * Listen to a type of event sent to the node of a decorator, before the listeners of the node
+     * @tparam EventType The type of event
+     * @param decorator The decorator, it must be added to a node
+     * @param function Called with every event received by the node
+     * @param phases The phases of the events to receive
+     * @return The identifier of the listener
+     * @note The decorator should stop listening before being removed from its node
+     */
+    template<typename EventType, typename Function>
+    listener_id listen(node_decorator& decorator, Function&& function,
+                       uint8_t phases = event::dispatched | event::broadcast)
+    {
+        assert(decorator.decorated_node());
+
+        return add_listener(event_type_index<EventType>(), decorator.decorated_node(),
+                            wrap<EventType>(std::forward<Function>(function)), phases, true);
+    }
+
+    /**
+     * Stop a listener from receiving events
+     * @param id The identifier of the listener
+     */
+    void unlisten(listener_id id);
+
+    /**
+     * Stop every listener of a node from receiving events
+     * @param listener_node The node
+     * @note Called when a node is destroyed. While an event is sent, the listeners of the node stop receiving it at
+     *       once and are erased after it was sent, so a listener can destroy nodes
+     */
+    void unlisten_all(const node* listener_node) noexcept;
+
+    /**
+     * Send an event to a node
+     * The listeners of the ancestors receive the event from the top while capturing, then the node receives it,
+     * then the ancestors receive it again from the node to the top while bubbling
+     * @tparam EventType The type of the event
+     * @param e The event to send
+     * @param target The node receiving the event
+     */
+    template<typename EventType>
+    void dispatch(EventType& e, node* target)
+    {
+        static_assert(std::is_base_of_v<event, EventType>, "Expecting valid event type");
+
+        dispatch(static_cast<event&>(e), event_type_index<EventType>(), target);
+    }
+
+    /**
+     * Send an event to every listener of a subtree
+     * @tparam EventType The type of the event
+     * @param e The event to send
+     * @param subtree_root The root of the subtree receiving the event
+     * @note Only nodes listening to the type of event are visited, in the order they started listening
+     */
+    template<typename EventType>
+    void broadcast(EventType& e, node* subtree_root)
+    {
+        static_assert(std::is_base_of_v<event, EventType>, "Expecting valid event type");
+
+        broadcast(static_cast<event&>(e), event_type_index<EventType>(), subtree_root);
+    }
+
+    /**
+     * Queue an event to send to a node with the next call to dispatch_queued
+     * @tparam EventType The type of the event
+     * @tparam Args The types of the arguments of the constructor of the event
+     * @param target The node receiving the event
+     * @param args The arguments of the constructor of the event
+     * @return The queued event
+     * @note Queued events are allocated from a pool per type of event
+     */
+    template<typename EventType, typename... Args>
+    EventType& queue(node* target, Args&&... args)
+    {
+        return emplace_queued<EventType>(target, false, std::forward<Args>(args)...);
+    }
+
+    /**
+     * Queue an event to broadcast to a subtree with the next call to dispatch_queued
+     * @tparam EventType The type of the event
+     * @tparam Args The types of the arguments of the constructor of the event
+     * @param subtree_root The root of the subtree receiving the event
+     * @param args The arguments of the constructor of the event
+     * @return The queued event
+     */
+    template<typename EventType, typename... Args>
+    EventType& queue_broadcast(node* subtree_root, Args&&... args)
+    {
+        return emplace_queued<EventType>(subtree_root, true, std::forward<Args>(args)...);
+    }
+
+    /**
+     * Send every queued event in the order they were queued
+     * @note Should be called once per tick, events queued by the listeners are sent by the next call. The targets of
+     *       the queued events must still exist
+     */
+    void dispatch_queued();
+
+    /**
+     * Returns the number of events waiting for dispatch_queued
+     * @return The number of queued events
+     */
+    [[nodiscard]] std::size_t queued_count() const noexcept;
+};
+
+}
+
+#endif
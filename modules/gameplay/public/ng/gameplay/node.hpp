@@ -2,20 +2,32 @@
 #define NGINE_GAMEPLAY_NODE_HPP
 
 #include <ng/core/name.hpp>
+#include <ng/core/time.hpp>
 
 #include <memory>
 #include <vector>
 #include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <limits>
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
 
 namespace ng
 {
 
 class node;
+class node2d;
 
 class node_decorator;
 using node_decorator_ptr = std::unique_ptr<node_decorator>;
 
 class node_tree;
+class node_child_index;
+class event_dispatcher;
+class tick_scheduler;
+class component_store;
 
 class invalid_node_name : public std::runtime_error
 {
@@ -40,11 +52,28 @@ public:
  * They will process events from the tree before it's owning node so it could mutate the event or block events
  * from traversing further
  */
-class node_decorator : std::enable_shared_from_this<node>
+class node_decorator
 {
-    node* node_;
+    friend node;
+
+    node* node_ = nullptr;
 public:
     virtual ~node_decorator() = default;
+
+    /**
+     * Returns the node this decorator was added to
+     * @return The decorated node or nullptr when the decorator was not added to a node
+     * @note Decorators receive the events of their node by listening with event_dispatcher::listen
+     */
+    [[nodiscard]] node* decorated_node() noexcept
+    {
+        return node_;
+    }
+
+    [[nodiscard]] const node* decorated_node() const noexcept
+    {
+        return node_;
+    }
 };
 
 /**
@@ -59,13 +88,50 @@ enum class primary_node_types : uint8_t
     node2d
 };
 
+// One bit per type of node checked with node::is_a, given by node_type_bit
+using node_type_mask = uint64_t;
+
+/**
+ * Returns a new index every time it is called, starting after the indices of node and node2d
+ * @return A new index
+ */
+[[nodiscard]] std::size_t next_node_type_index() noexcept;
+
+/**
+ * Returns the bit of a type of node, the same for every tree
+ * @tparam NodeType The type of node
+ * @return The bit of the type, node and node2d have constant bits so checking them doesn't load anything
+ */
+template<typename NodeType>
+[[nodiscard]] node_type_mask node_type_bit() noexcept
+{
+    if constexpr(std::is_same_v<NodeType, node>)
+    {
+        return node_type_mask{1} << 0;
+    }
+    else if constexpr(std::is_same_v<NodeType, node2d>)
+    {
+        return node_type_mask{1} << 1;
+    }
+    else
+    {
+        static const std::size_t index = next_node_type_index();
+        assert(index < std::numeric_limits<node_type_mask>::digits);
+
+        return node_type_mask{1} << index;
+    }
+}
+
 /**
  * Base class every nodes must implement
  * A scene becomes a tree of nodes with events traversing the tree
  */
-class node : std::enable_shared_from_this<node>
+class node
 {
     friend node_tree;
+    friend event_dispatcher;
+    friend tick_scheduler;
+    friend component_store;
 
     // The name of the node
     safe_name name_;
@@ -76,17 +142,104 @@ class node : std::enable_shared_from_this<node>
     // The node parent to this one
     node* parent_;
 
-    // List of child nodes
-    std::vector<node*> children_;
+    // Child nodes are linked together, in the order they were attached
+    node* first_child_;
+    node* last_child_;
+    node* next_sibling_;
+    node* previous_sibling_;
+    std::size_t child_count_;
+
+    // Finds children by name once this node has many children, nullptr otherwise
+    std::unique_ptr<node_child_index> child_index_;
+
+    // Changes when the name, the parent or the children of this node change, resolved paths through it are outdated
+    uint64_t structure_version_;
+
+    // Where the components of this node are stored in the component store of its tree, the archetype is
+    // component_store::no_archetype when the node has no component
+    uint32_t component_archetype_;
+    uint32_t component_row_;
 
-    // List of decorators attached to this node to update it's behaviour
-    std::vector<node_decorator_ptr> decorators_;
+    // Bits of the types of this node, each type checked with is_a adds its bit in its constructor
+    node_type_mask type_mask_;
+
+    // Collection of the owning tree that last found this node reachable
+    uint32_t mark_epoch_;
+
+    // Set while the node has decorators, they are stored by its tree so nodes without decorators don't pay for them
+    bool decorated_;
+
+    // Set once the node listened to an event, its listeners are removed when it is destroyed
+    bool event_listener_;
+
+    // Set while the node is registered to a tick group, it is removed from its group when destroyed
+    bool tick_registered_;
 
     void set_owner(node_tree* owner);
 
+    /**
+     * Link a detached child among the children of this node
+     * @param child The child to link, its name must not be used by another child
+     * @param next_sibling The child linked after the new child or nullptr to link it last
+     * @note Doesn't check the name, doesn't change the structure versions and doesn't notify the child
+     */
+    void link_child(node* child, node* next_sibling = nullptr);
+
+    /**
+     * Unlink a child from the children of this node
+     * @param child The child to unlink
+     * @note Doesn't change the structure versions and doesn't notify the child
+     */
+    void unlink_child(node* child) noexcept;
+
+    /**
+     * Notify this node that its parent changed
+     * @note The node2d placed below this node through nodes without transform are given their new node2d ancestor
+     */
+    void parent_changed() noexcept;
+
+    /**
+     * Give a new structure version to this node
+     */
+    void on_structure_changed() noexcept;
+
+protected:
+    /**
+     * Called after this node was attached to a new parent or detached from its parent
+     */
+    virtual void on_parent_changed() noexcept;
+
+    /**
+     * Add a type to the types of this node, so is_a finds it without a dynamic cast
+     * @tparam NodeType The type being constructed
+     * @note Called by the constructor of every type checked with is_a, the types deriving from it inherit its bit
+     */
+    template<typename NodeType>
+    void add_node_type() noexcept
+    {
+        static_assert(std::is_base_of_v<node, NodeType>, "Expecting valid node type");
+
+        type_mask_ |= node_type_bit<NodeType>();
+    }
+
 public:
-    explicit node(safe_name name, node* parent = nullptr) noexcept;
-    virtual ~node() = default;
+    /**
+     * Construct a node owned by a tree
+     * @param owner The tree owning this node, it must outlive this node
+     * @param name The name of this node
+     * @param parent The parent of this node
+     * @note Nodes are usually created with node_tree::make_node which gives the tree to the constructor
+     */
+    node(node_tree& owner, safe_name name, node* parent = nullptr);
+    virtual ~node();
+
+    /**
+     * Called every time the tick group of this node ticks
+     * @param dt The time elapsed since the group last ticked
+     * @note Nodes are registered to a tick group with tick_scheduler::add, overrides are called without going through
+     *       the virtual table so a registered node must be registered with its exact type
+     */
+    virtual void on_tick(frame_duration dt);
 
     /**
      * Returns the name of this node
@@ -94,6 +247,13 @@ public:
      */
     const safe_name& name() const noexcept;
 
+    /**
+     * Change the name of this node
+     * @param new_name The new name of this node
+     * @throw invalid_node_name When a sibling already has the new name
+     */
+    void rename(safe_name new_name);
+
     /**
      * Add a decorator to the node
      * @param decorator The decorator to add
@@ -110,9 +270,12 @@ public:
     template<typename DecoratorType, typename... Args>
     DecoratorType& emplace_decorator(Args&&... args)
     {
-        decorators_.push_back(std::make_unique<DecoratorType>(std::forward<Args>(args)...));
+        auto decorator = std::make_unique<DecoratorType>(std::forward<Args>(args)...);
+        DecoratorType& added = *decorator;
+
+        add_decorator(std::move(decorator));
 
-        return *static_cast<DecoratorType*>(decorators_.back().get());
+        return added;
     }
 
     /**
@@ -120,6 +283,12 @@ public:
      */
     void clear_decorators();
 
+    /**
+     * Returns the number of decorators added to this node
+     * @return The number of decorators
+     */
+    [[nodiscard]] std::size_t decorator_count() const noexcept;
+
     /**
      * Attach this node to a parent
      * @param parent The parent this node should have after calling this function
@@ -158,6 +327,21 @@ public:
     [[nodiscard]] node* find_child(const safe_name& name) noexcept;
     [[nodiscard]] const node* find_child(const safe_name& name) const noexcept;
 
+    /**
+     * Find a direct child node by the string of it's name
+     * @param name The string of the name of the child node
+     * @return the found node or nullptr if it was not found
+     * @note Doesn't create a name, used to find the elements of a node path
+     */
+    [[nodiscard]] node* find_child(std::string_view name) noexcept;
+    [[nodiscard]] const node* find_child(std::string_view name) const noexcept;
+
+    /**
+     * Returns the number of direct children of this node
+     * @return The number of direct children
+     */
+    [[nodiscard]] std::size_t child_count() const noexcept;
+
     /**
      * Check if this node is under the hierarchy of a parent node
      * @param parent The node to check if this node is under its hierarchy
@@ -180,9 +364,37 @@ public:
     /**
      * Returns the primary node type identifier
      * @return an identifier that indicate the primary type of a node
-     *
+     * @note Read from the type bits of the node, without going through the virtual table
+     */
+    [[nodiscard]] primary_node_types primary_node_type() const noexcept
+    {
+        return is_a<node2d>() ? primary_node_types::node2d : primary_node_types::node;
+    }
+
+    /**
+     * Check the type of this node
+     * @tparam NodeType The type to check, it must add its bit with add_node_type in its constructor
+     * @return true when this node is a NodeType or derives from it
+     * @note Used to upcast with a static_cast instead of a dynamic cast
+     */
+    template<typename NodeType>
+    [[nodiscard]] bool is_a() const noexcept
+    {
+        return (type_mask_ & node_type_bit<NodeType>()) != 0;
+    }
+
+    /**
+     * Returns the types of this node
+     * @return The bit of every type added with add_node_type
+     */
+    [[nodiscard]] node_type_mask type_mask() const noexcept;
+
+    /**
+     * Returns the tree owning this node
+     * @return The tree owning this node
      */
-    [[nodiscard]] virtual primary_node_types primary_node_type() const noexcept;
+    [[nodiscard]] node_tree* owner() noexcept;
+    [[nodiscard]] const node_tree* owner() const noexcept;
 
     /**
      * Returns the parent node
@@ -2,39 +2,81 @@
 #define NGINE_GAMEPLAY_NODE2D_HPP
 
 #include "node.hpp"
+#include "transform_store.hpp"
+#include "spatial_index.hpp"
 #include <ng/core/transform2d.hpp>
+#include <ng/core/affine2d.hpp>
+#include <ng/core/aabb2d.hpp>
 
 #include <glm/glm.hpp>
 #include <glm/gtx/matrix_decompose.hpp>
 
+#include <cstdint>
+
 namespace ng
 {
 
 /**
  * Base class for every node that has a 2D transform
+ * The transforms are stored in the transform store of the tree owning the node.
+ * The world transform is computed lazily: moving a node only flags it, its world transform and the world transforms
+ * of its children are computed the next time they are read or when the tree updates its world transforms
  */
 class node2d : public node
 {
-    transform2d local_;
-    transform2d world_;
+    friend class node;
+    friend class transform_store;
+    friend class spatial_index;
+
+    // Where the transforms of this node are stored in the transform store of its tree
+    transform_store::slot_type transform_slot_;
+
+    // Entry of this node in the spatial index of its tree, invalid_entry when the node has no bounds
+    spatial_index::entry_type spatial_entry_;
+
+    [[nodiscard]] const node2d* parent_node2d() const noexcept;
+
+    /**
+     * Returns the slot whose subtree bounds include the bounds of the node2d placed below a node
+     * @param n The node or nullptr
+     * @return The slot of the node if it is a node2d, else the slot of its closest node2d ancestor or invalid_slot
+     */
+    [[nodiscard]] static transform_store::slot_type bounds_slot(const node* n) noexcept;
 
-    [[nodiscard]] transform2d parent_transform() const noexcept;
+    [[nodiscard]] transform_store& transforms() noexcept;
+    [[nodiscard]] const transform_store& transforms() const noexcept;
+
+    [[nodiscard]] spatial_index& spatial() noexcept;
+    [[nodiscard]] const spatial_index& spatial() const noexcept;
+
+protected:
+    void on_parent_changed() noexcept override;
 
 public:
-    explicit node2d(safe_name name, node* parent = nullptr) noexcept;
-    node2d(safe_name name, transform2d transform,  node* parent = nullptr) noexcept;
+    node2d(node_tree& owner, safe_name name, node* parent = nullptr);
+    node2d(node_tree& owner, safe_name name, transform2d transform,  node* parent = nullptr);
+    ~node2d() override;
 
     /**
      * Returns the world transform of this node
      * @return the world transform of this node
+     * @note Decomposes the world affine transform, prefer world_affine() to transform points
+     */
+    [[nodiscard]] transform2d world_transform() const noexcept;
+
+    /**
+     * Returns the world transform of this node as an affine transform
+     * @return the world transform of this node
+     * @note Computes the world transform of this node and its parents if they are outdated,
+     *       therefore it is not safe to read world transforms of the same hierarchy from multiple threads
      */
-    [[nodiscard]] const transform2d& world_transform() const noexcept;
+    [[nodiscard]] const affine2d& world_affine() const noexcept;
 
     /**
      * Returns the local transform of this node
      * @return the local transform of this node
      */
-    [[nodiscard]] const transform2d& local_transform() const noexcept;
+    [[nodiscard]] transform2d local_transform() const noexcept;
 
     /**
      * Set the world transform this node should have
@@ -45,15 +87,43 @@ public:
     /**
      * Set the local transform this node should have
      * @param local_transform The local transform this node should have
+     * @note Children are not updated until their world transform is needed
      */
     void set_local_transform(const transform2d& transform) noexcept;
 
     /**
-     * Here we make sure all node2d have the primary node type node2d
-     * @return node2d
-     * @note This is used to upcast with a static_cast instead of a dynamic cast
+     * Returns where the transforms of this node are stored in the transform store of its tree
+     * @return The slot of this node
+     * @note The slot can change every time the tree updates its world transforms
+     */
+    [[nodiscard]] transform_store::slot_type transform_slot() const noexcept;
+
+    /**
+     * Set the bounds of this node in its local space, nodes with bounds are found by the spatial index of their tree
+     * @param bounds The local bounds of this node, empty bounds remove this node from the spatial index
+     */
+    void set_local_bounds(const aabb2d& bounds);
+
+    /**
+     * Returns the bounds of this node in its local space
+     * @return The local bounds of this node, empty when the node has no bounds
+     */
+    [[nodiscard]] const aabb2d& local_bounds() const noexcept;
+
+    /**
+     * Returns the bounds of this node in world space
+     * @return The world bounds of this node, empty when the node has no bounds
+     * @note Computed from the current world transform, the spatial index only sees it once the tree updates its world
+     *       transforms
+     */
+    [[nodiscard]] aabb2d world_bounds() const noexcept;
+
+    /**
+     * Returns the world bounds of this node merged with the world bounds of its node2d descendants
+     * @return The bounds of the subtree of this node
+     * @note Only up to date once the tree updated its world transforms, like the transforms of the transform store
      */
-    [[nodiscard]] primary_node_types primary_node_type() const noexcept override final;
+    [[nodiscard]] const aabb2d& subtree_bounds() const noexcept;
 };
 
 }
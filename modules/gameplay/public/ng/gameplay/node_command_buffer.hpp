@@ -0,0 +1,191 @@
+#ifndef NGINE_GAMEPLAY_NODE_COMMAND_BUFFER_HPP
+#define NGINE_GAMEPLAY_NODE_COMMAND_BUFFER_HPP
+
+#include "node.hpp"
+#include "node2d.hpp"
+#include "node_tree.hpp"
+
+#include <ng/core/name.hpp>
+#include <ng/core/transform2d.hpp>
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace ng
+{
+
+/**
+ * Records changes to the structure of a node_tree to apply them later with node_tree::apply
+ * Recording only writes to the buffer, so each thread of a parallel update can fill its own buffer while the tree is
+ * only read. The buffers are applied together on the thread owning the tree
+ */
+class node_command_buffer
+{
+public:
+    /**
+     * A node used by a command, either a node of the tree or a node created by a previous command of the same buffer
+     */
+    class node_handle
+    {
+        friend node_command_buffer;
+        friend node_tree;
+
+        static constexpr uint32_t existing_node = std::numeric_limits<uint32_t>::max();
+
+        node* node_;
+
+        // Index of the created node in its buffer or existing_node
+        uint32_t created_index_;
+
+        node_handle(uint32_t created_index) noexcept
+        : node_{nullptr}
+        , created_index_{created_index}
+        {
+
+        }
+
+    public:
+        node_handle(node* n) noexcept
+        : node_{n}
+        , created_index_{existing_node}
+        {
+
+        }
+
+        /**
+         * Check if the node is created by the buffer
+         * @return true when the node doesn't exist until the buffer is applied
+         */
+        [[nodiscard]] bool created() const noexcept
+        {
+            return created_index_ != existing_node;
+        }
+    };
+
+private:
+    friend node_tree;
+
+    using construct_function = node* (*)(node_tree& tree, const safe_name& name);
+
+    struct created_node
+    {
+        construct_function construct;
+        safe_name name;
+
+        // Only set for node2d
+        bool has_transform;
+        transform2d local_transform;
+    };
+
+    // Moves a child under a parent, a null parent detaches the child
+    struct move_command
+    {
+        node_handle parent;
+        node_handle child;
+    };
+
+    std::vector<created_node> created_nodes_;
+    std::vector<move_command> commands_;
+
+    // Nodes created while the buffer is applied, indexed like created_nodes_
+    std::vector<node*> applied_nodes_;
+
+    node_handle create(construct_function construct, safe_name name, bool has_transform, const transform2d& transform);
+
+public:
+    node_command_buffer() = default;
+
+    /**
+     * Record the creation of a node
+     * @tparam NodeType The type of the node, constructed with the tree and the name
+     * @param name The name of the node
+     * @return The created node, usable by the next commands of this buffer
+     */
+    template<typename NodeType>
+    node_handle create(safe_name name)
+    {
+        static_assert(std::is_base_of_v<node, NodeType>, "Expecting valid node type");
+
+        return create([](node_tree& tree, const safe_name& node_name) -> node*
+                      {
+                          return tree.make_node<NodeType>(node_name);
+                      },
+                      std::move(name), false, transform2d{});
+    }
+
+    /**
+     * Record the creation of a node attached to a parent
+     * @tparam NodeType The type of the node, constructed with the tree and the name
+     * @param name The name of the node
+     * @param parent The parent of the node
+     * @return The created node, usable by the next commands of this buffer
+     */
+    template<typename NodeType>
+    node_handle create(safe_name name, node_handle parent)
+    {
+        const node_handle created = create<NodeType>(std::move(name));
+        attach(parent, created);
+
+        return created;
+    }
+
+    /**
+     * Record the creation of a node2d attached to a parent
+     * @tparam NodeType The type of the node, constructed with the tree and the name
+     * @param name The name of the node
+     * @param transform The local transform of the node
+     * @param parent The parent of the node
+     * @return The created node, usable by the next commands of this buffer
+     */
+    template<typename NodeType>
+    node_handle create(safe_name name, const transform2d& transform, node_handle parent)
+    {
+        static_assert(std::is_base_of_v<node2d, NodeType>, "Expecting node2d type");
+
+        const node_handle created = create([](node_tree& tree, const safe_name& node_name) -> node*
+                                           {
+                                               return tree.make_node<NodeType>(node_name);
+                                           },
+                                           std::move(name), true, transform);
+        attach(parent, created);
+
+        return created;
+    }
+
+    /**
+     * Record attaching a child to a parent
+     * @param parent The new parent
+     * @param child The attached child, detached from its current parent
+     */
+    void attach(node_handle parent, node_handle child);
+
+    /**
+     * Record detaching a node from its parent
+     * @param child The detached node
+     */
+    void detach(node_handle child);
+
+    /**
+     * Record destroying a node
+     * @param n The destroyed node, it is detached and freed by the next collection of the tree
+     */
+    void destroy(node_handle n);
+
+    /**
+     * Forget every recorded command
+     */
+    void clear() noexcept;
+
+    /**
+     * Check if no command was recorded
+     * @return true when applying the buffer changes nothing
+     */
+    [[nodiscard]] bool empty() const noexcept;
+};
+
+}
+
+#endif
@@ -1,12 +1,12 @@
 #ifndef NGINE_GAMEPLAY_NODE_PATH_HPP
 #define NGINE_GAMEPLAY_NODE_PATH_HPP
 
-#include <ng/core/name.hpp>
+#include <ng/core/small_vector.hpp>
 
 #include <string_view>
 #include <string>
-#include <vector>
 #include <ostream>
+#include <cstdint>
 
 namespace ng
 {
@@ -15,6 +15,7 @@ class node_path;
 
 /**
  * Iterate over elements of a node path
+ * Elements are views inside the path, they are valid as long as the path is not modified
  */
 class node_path_iterator
 {
@@ -25,9 +26,9 @@ class node_path_iterator
 public:
     using iterator_category = std::bidirectional_iterator_tag;
     using difference_type   = std::ptrdiff_t;
-    using value_type        = safe_name;
-    using pointer           = const safe_name*;  // or also value_type*
-    using reference         = const safe_name&;  // or also value_type&
+    using value_type        = std::string_view;
+    using pointer           = void;
+    using reference         = std::string_view;
 
     node_path_iterator();
 
@@ -51,32 +52,70 @@ public:
     bool operator!=(const node_path_iterator& other) const noexcept;
 
     /**
-     * Returns a reference to the referenced element of the path
+     * Returns the referenced element of the path
      * @return the referenced element of the path
      */
     reference operator*() const noexcept;
 
-    /**
-     * Returns a pointer to the referenced element of the path
-     * @return The referenced element of the path
-     */
-    pointer  operator->() const noexcept;
-
 private:
     node_path_iterator(const node_path& path, std::size_t index);
 };
 
 /**
  * Holds a path to a node
+ * The text of the path is stored once, elements are ranges inside the text. Paths of a typical depth are stored
+ * inside the path without allocating
  */
 class node_path
 {
     friend node_path_iterator;
-    std::vector<safe_name> names_;
+
+    struct element_range
+    {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    // The elements separated by delimiters, starting with a delimiter when absolute, without the trailing delimiter
+    small_vector<char, 64> text_;
+    small_vector<element_range, 8> elements_;
+
+    // Hash of the text, extended when elements are added
+    uint64_t text_hash_;
+
     bool absolute_;
     bool trailing_delimiter_;
+
+    /**
+     * Returns an element of the path
+     * @param index The index of the element
+     * @return A view on the element inside the text of the path
+     */
+    [[nodiscard]] std::string_view element(std::size_t index) const noexcept;
+
+    /**
+     * Add an element at the end of the path
+     * @param element The element to add, it can't be a view inside this path
+     */
+    void push_back(std::string_view element);
+
+    /**
+     * Write the string representation of the path to a buffer
+     * @param buffer The buffer where the path is written
+     */
+    template<typename Buffer>
+    void write(Buffer& buffer) const
+    {
+        buffer.append(text_.data(), text_.size());
+
+        if(trailing_delimiter_ && !elements_.empty())
+        {
+            buffer.push_back(delimiter_char);
+        }
+    }
+
 public:
-    static const char delimiter_char = '/';
+    static constexpr char delimiter_char = '/';
 
     node_path() noexcept;
 
@@ -111,6 +150,12 @@ public:
      */
     [[nodiscard]] bool empty() const noexcept;
 
+    /**
+     * Returns the number of elements in the path
+     * @return The number of elements
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
     /**
      * Clear the path
      */
@@ -118,16 +163,29 @@ public:
 
     /**
      * Returns the string representation of the path
-     * @return
+     * @return The string representation of the path
      */
     [[nodiscard]] std::string string() const;
 
+    /**
+     * Returns the hash of the path
+     * @return The hash of the string representation of the path
+     * @note The hash is computed while the path is built, appending to a path extends the hash of the path
+     */
+    [[nodiscard]] uint64_t hash() const noexcept;
+
     bool operator==(const node_path& path) const noexcept;
     bool operator!=(const node_path& path) const noexcept;
 
     node_path_iterator begin() const;
     node_path_iterator end() const;
 
+    /**
+     * Parse a string to get a path
+     * @param str The string to parse
+     * @return The parsed path
+     * @note Elements are not converted to names, the string is copied once
+     */
     static node_path parse(std::string_view str);
 };
 
@@ -145,5 +203,18 @@ namespace literals
 
 }
 
+namespace std
+{
+
+template<>
+struct hash<ng::node_path>
+{
+    std::size_t operator()(const ng::node_path& path) const noexcept
+    {
+        return static_cast<std::size_t>(path.hash());
+    }
+};
+
+}
 
 #endif
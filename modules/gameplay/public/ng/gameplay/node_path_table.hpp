@@ -0,0 +1,110 @@
+#ifndef NGINE_GAMEPLAY_NODE_PATH_TABLE_HPP
+#define NGINE_GAMEPLAY_NODE_PATH_TABLE_HPP
+
+#include "node_path.hpp"
+
+#include <unordered_set>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+
+namespace ng
+{
+
+class node_path_table;
+
+/**
+ * A path stored once in a node path table
+ * Interned paths are equal when they point to the same stored path
+ */
+class interned_node_path
+{
+    friend node_path_table;
+
+    const node_path* path_;
+
+    explicit interned_node_path(const node_path* path) noexcept;
+
+public:
+    /**
+     * Construct an empty interned path, not stored in any table
+     */
+    interned_node_path() noexcept;
+
+    /**
+     * Returns the stored path
+     * @return The stored path
+     */
+    [[nodiscard]] const node_path& path() const noexcept;
+
+    /**
+     * Returns the hash of the stored path
+     * @return The hash of the stored path
+     */
+    [[nodiscard]] uint64_t hash() const noexcept;
+
+    /**
+     * Check if this interned path is empty
+     * @return true when this path was not interned
+     */
+    [[nodiscard]] bool empty() const noexcept;
+
+    bool operator==(const interned_node_path& other) const noexcept;
+    bool operator!=(const interned_node_path& other) const noexcept;
+};
+
+/**
+ * Stores each distinct path once
+ * Scenes referencing the same paths many times can keep interned paths instead of copies
+ * @note The table must outlive the interned paths it returned
+ */
+class node_path_table
+{
+    // Elements of an unordered set are never moved by a rehash
+    std::unordered_set<node_path> paths_;
+
+public:
+    node_path_table() = default;
+
+    // Interned paths point inside the table
+    node_path_table(const node_path_table&) = delete;
+    node_path_table& operator=(const node_path_table&) = delete;
+
+    /**
+     * Store a path in the table
+     * @param path The path to store
+     * @return The stored path, the same for every equal path
+     */
+    [[nodiscard]] interned_node_path intern(const node_path& path);
+
+    /**
+     * Find a path in the table without storing it
+     * @param path The path to find
+     * @return The stored path or an empty interned path if it was never stored
+     */
+    [[nodiscard]] interned_node_path find(const node_path& path) const;
+
+    /**
+     * Returns the number of distinct paths stored in the table
+     * @return The number of distinct paths
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+};
+
+}
+
+namespace std
+{
+
+template<>
+struct hash<ng::interned_node_path>
+{
+    std::size_t operator()(const ng::interned_node_path& path) const noexcept
+    {
+        return static_cast<std::size_t>(path.hash());
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef NGINE_GAMEPLAY_NODE_POOL_HPP
+#define NGINE_GAMEPLAY_NODE_POOL_HPP
+
+#include <ng/core/memory_pool.hpp>
+
+#include <cstddef>
+
+namespace ng
+{
+
+class node;
+
+/**
+ * Stores the nodes of a single type
+ */
+class node_pool
+{
+public:
+    virtual ~node_pool() = default;
+
+    /**
+     * Allocate the memory of a node
+     * @return The memory of a node
+     */
+    [[nodiscard]] virtual void* allocate() = 0;
+
+    /**
+     * Free the memory of a node
+     * @param memory The memory of a destroyed node
+     */
+    virtual void free(void* memory) noexcept = 0;
+
+    /**
+     * Make sure a number of nodes can be allocated without growing the pool
+     * @param count The number of nodes
+     */
+    virtual void reserve(std::size_t count) = 0;
+
+    /**
+     * Returns the number of allocated nodes
+     * @return The number of nodes whose memory was not freed
+     */
+    [[nodiscard]] virtual std::size_t size() const noexcept = 0;
+};
+
+template<typename NodeType>
+class typed_node_pool final : public node_pool
+{
+    type_memory_pool<NodeType> pool_;
+
+public:
+    [[nodiscard]] void* allocate() override
+    {
+        return pool_.allocate();
+    }
+
+    void free(void* memory) noexcept override
+    {
+        pool_.free(memory);
+    }
+
+    void reserve(std::size_t count) override
+    {
+        pool_.reserve(count);
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept override
+    {
+        return pool_.size();
+    }
+};
+
+/**
+ * Destroy a node and give back its memory to its pool
+ */
+struct pooled_node_deleter
+{
+    node_pool* pool;
+
+    // The memory allocated for the node, it can differ from the node address when the node type has multiple bases
+    void* memory;
+
+    void operator()(node* n) const noexcept;
+};
+
+/**
+ * Returns a new index every time it is called
+ * @return A new index
+ */
+[[nodiscard]] std::size_t next_node_pool_index() noexcept;
+
+/**
+ * Returns the index of the pool storing a type of nodes in a tree
+ * @tparam NodeType The type of nodes
+ * @return The index of the pool, the same for every tree
+ */
+template<typename NodeType>
+[[nodiscard]] std::size_t node_pool_index() noexcept
+{
+    static const std::size_t index = next_node_pool_index();
+
+    return index;
+}
+
+}
+
+#endif
@@ -0,0 +1,319 @@
+#ifndef NGINE_GAMEPLAY_NODE_TRAVERSAL_HPP
+#define NGINE_GAMEPLAY_NODE_TRAVERSAL_HPP
+
+#include "node.hpp"
+#include "node_tree.hpp"
+
+#include <ng/core/thread_pool.hpp>
+#include <ng/core/aabb2d.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+#include <cassert>
+
+namespace ng
+{
+
+class node2d;
+
+/**
+ * Iterate over a subtree in depth first pre-order, each parent is visited before its children
+ */
+using pre_order_iterator = node_tree_iterator;
+
+/**
+ * Iterate over a subtree in depth first post-order, each parent is visited after its children
+ * Moving to the next node only follows the links between nodes, without allocating
+ */
+class post_order_iterator
+{
+    node* current_node_;
+
+    // Node where the iteration started, it is the last visited node
+    node* subtree_root_;
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = node;
+    using pointer = node*;
+    using reference = node&;
+    using difference_type = std::ptrdiff_t;
+
+    post_order_iterator() noexcept;
+    explicit post_order_iterator(node* subtree_root) noexcept;
+
+    pointer operator->() const noexcept;
+    reference operator*() const noexcept;
+
+    post_order_iterator& operator++() noexcept;
+    post_order_iterator operator++(int) noexcept;
+
+    bool operator==(const post_order_iterator& other) const noexcept;
+    bool operator!=(const post_order_iterator& other) const noexcept;
+};
+
+/**
+ * Iterate over a subtree level by level
+ * The queue of nodes to visit is kept in a buffer given by the caller, so it can be reused between traversals
+ * @note Copies of the iterator share the same queue
+ */
+class breadth_first_iterator
+{
+    std::vector<node*>* queue_;
+
+    // Index of the current node inside the queue, nodes before it were already visited
+    std::size_t current_index_;
+
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = node;
+    using pointer = node*;
+    using reference = node&;
+    using difference_type = std::ptrdiff_t;
+
+    breadth_first_iterator() noexcept;
+
+    /**
+     * Start iterating over a subtree
+     * @param subtree_root The node where the iteration starts
+     * @param queue The buffer keeping the nodes to visit, it is cleared
+     */
+    breadth_first_iterator(node* subtree_root, std::vector<node*>& queue);
+
+    pointer operator->() const noexcept;
+    reference operator*() const noexcept;
+
+    breadth_first_iterator& operator++();
+
+    bool operator==(const breadth_first_iterator& other) const noexcept;
+    bool operator!=(const breadth_first_iterator& other) const noexcept;
+};
+
+/**
+ * Iterate over the nodes of a type in a subtree, in depth first pre-order
+ * Nodes of other types are skipped by testing their type bits, without going through the virtual table
+ * @tparam NodeType The type of the visited nodes, it must add its bit with node::add_node_type
+ */
+template<typename NodeType>
+class typed_pre_order_iterator
+{
+    static_assert(std::is_base_of_v<node, NodeType>, "Expecting valid node type");
+
+    pre_order_iterator position_;
+
+    // The node at the position, nullptr once every node was visited
+    NodeType* current_node_;
+
+    void skip_other_types() noexcept
+    {
+        for(; position_ != pre_order_iterator{}; ++position_)
+        {
+            if(position_->template is_a<NodeType>())
+            {
+                current_node_ = static_cast<NodeType*>(&*position_);
+                return;
+            }
+        }
+
+        current_node_ = nullptr;
+    }
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = NodeType;
+    using pointer = NodeType*;
+    using reference = NodeType&;
+    using difference_type = std::ptrdiff_t;
+
+    typed_pre_order_iterator() noexcept
+    : position_()
+    , current_node_{nullptr}
+    {
+
+    }
+
+    explicit typed_pre_order_iterator(node* subtree_root) noexcept
+    : position_{node_tree::begin(subtree_root)}
+    , current_node_{nullptr}
+    {
+        skip_other_types();
+    }
+
+    pointer operator->() const noexcept
+    {
+        return current_node_;
+    }
+
+    reference operator*() const noexcept
+    {
+        assert(current_node_);
+
+        return *current_node_;
+    }
+
+    typed_pre_order_iterator& operator++() noexcept
+    {
+        assert(current_node_);
+
+        ++position_;
+        skip_other_types();
+
+        return *this;
+    }
+
+    typed_pre_order_iterator operator++(int) noexcept
+    {
+        typed_pre_order_iterator tmp = *this;
+
+        ++(*this);
+
+        return tmp;
+    }
+
+    bool operator==(const typed_pre_order_iterator& other) const noexcept
+    {
+        return current_node_ == other.current_node_;
+    }
+
+    bool operator!=(const typed_pre_order_iterator& other) const noexcept
+    {
+        return current_node_ != other.current_node_;
+    }
+};
+
+/**
+ * A pair of iterators usable in a range based for loop
+ */
+template<typename Iterator>
+class node_range
+{
+    Iterator begin_;
+    Iterator end_;
+
+public:
+    node_range(Iterator begin, Iterator end)
+    : begin_{std::move(begin)}
+    , end_{std::move(end)}
+    {
+
+    }
+
+    [[nodiscard]] Iterator begin() const noexcept
+    {
+        return begin_;
+    }
+
+    [[nodiscard]] Iterator end() const noexcept
+    {
+        return end_;
+    }
+};
+
+/**
+ * Returns the nodes of a subtree in depth first pre-order
+ * @param subtree_root The node where the iteration starts
+ * @return The nodes of the subtree
+ */
+[[nodiscard]] node_range<pre_order_iterator> pre_order(node* subtree_root) noexcept;
+
+/**
+ * Returns the nodes of a type in a subtree, in depth first pre-order
+ * @tparam NodeType The type of the returned nodes, it must add its bit with node::add_node_type
+ * @param subtree_root The node where the iteration starts
+ * @return The nodes of the subtree that are a NodeType or derive from it
+ */
+template<typename NodeType>
+[[nodiscard]] node_range<typed_pre_order_iterator<NodeType>> pre_order_of(node* subtree_root) noexcept
+{
+    return node_range<typed_pre_order_iterator<NodeType>>{typed_pre_order_iterator<NodeType>{subtree_root},
+                                                          typed_pre_order_iterator<NodeType>{}};
+}
+
+/**
+ * Returns the nodes of a subtree in depth first post-order
+ * @param subtree_root The node where the iteration starts
+ * @return The nodes of the subtree
+ */
+[[nodiscard]] node_range<post_order_iterator> post_order(node* subtree_root) noexcept;
+
+/**
+ * Returns the nodes of a subtree level by level
+ * @param subtree_root The node where the iteration starts
+ * @param queue The buffer keeping the nodes to visit, reuse it to avoid allocating every traversal
+ * @return The nodes of the subtree
+ */
+[[nodiscard]] node_range<breadth_first_iterator> breadth_first(node* subtree_root, std::vector<node*>& queue);
+
+/**
+ * Find the node2d of a subtree whose world bounds intersect a region
+ * The children of a node2d whose subtree bounds miss the region are skipped with all their descendants, so culling
+ * a large level only visits the branches near the region
+ * @param subtree_root The node where the search starts
+ * @param region The region, in world space
+ * @param pending A buffer for the nodes left to visit, reuse it to avoid allocating every search
+ * @param found Receives the node2d intersecting the region
+ * @note Uses the bounds computed by the last update of the world transforms of the tree
+ */
+void cull(node* subtree_root, const aabb2d& region, std::vector<node*>& pending, std::vector<node2d*>& found);
+
+/**
+ * Call a function on every node of a subtree from multiple threads
+ * The top of the subtree is visited level by level on the calling thread until there are enough subtrees below
+ * to keep the pool busy, the remaining subtrees are then visited in pre-order by the threads of the pool
+ * @param pool The threads visiting the nodes
+ * @param subtree_root The node where the traversal starts
+ * @param work_items A buffer for the subtrees to split across the pool, reuse it to avoid allocating every traversal
+ * @param function Called once with every node, it must be safe to call from multiple threads on different nodes
+ * @note A node is always visited after its parent
+ */
+template<typename Function>
+void parallel_for_each(thread_pool& pool, node* subtree_root, std::vector<node*>& work_items, Function&& function)
+{
+    // More subtrees than threads so the threads that get small subtrees can pick other ones
+    const std::size_t target_item_count = (pool.worker_count() + 1) * 8;
+
+    work_items.clear();
+    work_items.push_back(subtree_root);
+
+    // Nodes before level_begin were visited while splitting the subtree
+    std::size_t level_begin = 0;
+    while(work_items.size() - level_begin < target_item_count)
+    {
+        const std::size_t level_end = work_items.size();
+
+        for(std::size_t i = level_begin; i < level_end; ++i)
+        {
+            function(*work_items[i]);
+
+            for(node* child = work_items[i]->first_child(); child; child = child->next_sibling())
+            {
+                work_items.push_back(child);
+            }
+        }
+
+        level_begin = level_end;
+
+        // The whole subtree was visited
+        if(level_begin == work_items.size())
+        {
+            return;
+        }
+    }
+
+    pool.parallel_for(work_items.size() - level_begin, 1, [&work_items, &function, level_begin](std::size_t begin, std::size_t end)
+    {
+        for(std::size_t i = level_begin + begin; i < level_begin + end; ++i)
+        {
+            for(node& n : pre_order(work_items[i]))
+            {
+                function(n);
+            }
+        }
+    });
+}
+
+}
+
+#endif
@@ -1,18 +1,41 @@
 #ifndef NGINE_GAMEPLAY_NODE_TREE_HPP
 #define NGINE_GAMEPLAY_NODE_TREE_HPP
 
+#include "transform_store.hpp"
+#include "node_pool.hpp"
+#include "node_path.hpp"
+#include "event_dispatcher.hpp"
+#include "tick_scheduler.hpp"
+#include "spatial_index.hpp"
+#include "component_store.hpp"
+
+#include <ng/core/time.hpp>
+
 #include <memory>
+#include <new>
 #include <vector>
+#include <unordered_map>
+#include <utility>
 #include <iterator>
+#include <cstdint>
+#include <type_traits>
 
 namespace ng
 {
 
-class node_path;
 class node;
+class node2d;
+class prefab;
+class scene_view;
+class node_type_registry;
+class scene_load_progress;
+class node_command_buffer;
+class node_tree_snapshot;
+class thread_pool;
 
 /**
- * Iterate over nodes inside the tree
+ * Iterate over nodes inside the tree in depth first pre-order, each parent is visited before its children
+ * Moving to the next node only follows the links between nodes, without allocating
  */
 class node_tree_iterator
 {
@@ -20,9 +43,13 @@ class node_tree_iterator
 
     node* current_node_;
 
-    node_tree_iterator(node* current_node);
+    // Node where the iteration started, the iteration stops after visiting its last descendant
+    node* subtree_root_;
+
+    node_tree_iterator(node* subtree_root);
 public:
     using iterator_category = std::forward_iterator_tag;
+    using value_type = node;
     using pointer = node*;
     using reference = node&;
     using difference_type = std::ptrdiff_t;
@@ -69,7 +96,8 @@ public:
 };
 
 /**
- * Iterate over nodes inside the tree
+ * Iterate over nodes inside the tree in depth first pre-order, each parent is visited before its children
+ * Moving to the next node only follows the links between nodes, without allocating
  */
 class const_node_tree_iterator
 {
@@ -77,9 +105,13 @@ class const_node_tree_iterator
 
     node* current_node_;
 
-    const_node_tree_iterator(node* current_node);
+    // Node where the iteration started, the iteration stops after visiting its last descendant
+    node* subtree_root_;
+
+    const_node_tree_iterator(node* subtree_root);
 public:
     using iterator_category = std::forward_iterator_tag;
+    using value_type = node;
     using pointer = const node*;
     using reference = const node&;
     using difference_type = std::ptrdiff_t;
@@ -130,14 +162,248 @@ public:
  */
 class node_tree
 {
-    std::vector<std::unique_ptr<node>> nodes_;
+    using owned_node = std::unique_ptr<node, pooled_node_deleter>;
+
+    // Declared before the nodes so it is destroyed after them, node2d release their slot when destroyed
+    transform_store transforms_;
+
+    // Destroyed after the nodes, nodes stop listening to events when destroyed
+    event_dispatcher events_;
+
+    // Destroyed after the nodes, nodes stop ticking when destroyed
+    tick_scheduler scheduler_;
+
+    // Destroyed after the nodes, node2d leave the index when destroyed
+    spatial_index spatial_;
+
+    // Destroyed after the nodes, nodes remove their components when destroyed
+    component_store components_;
+
+    // Decorators of the nodes having some, destroyed after the nodes, nodes remove their decorators when destroyed
+    std::unordered_map<const node*, std::vector<node_decorator_ptr>> decorators_;
+
+    // One pool per type of node, indexed by node_pool_index, destroyed after the nodes
+    std::vector<std::unique_ptr<node_pool>> pools_;
+
+    // Pools of the trees merged in this tree, they keep the memory of the merged nodes and are never allocated from.
+    // A pool is dropped by the first collection that finds it empty
+    std::vector<std::unique_ptr<node_pool>> adopted_pools_;
+
+    std::vector<owned_node> nodes_;
 
     node* root_;
 
+    enum class collection_states : uint8_t
+    {
+        idle,
+        marking,
+        sweeping
+    };
+
+    collection_states collection_state_;
+
+    // Incremented by every collection, nodes reachable during the collection are marked with it
+    uint32_t mark_epoch_;
+
+    // Marked nodes whose children are not marked yet
+    std::vector<node*> gray_nodes_;
+
+    // Nodes after this index were already swept
+    std::size_t sweep_index_;
+
+    // Incremented every time a node is attached, detached or renamed, nodes keep the value of their last change
+    uint64_t structure_version_;
+
+    // Snapshots taken from this tree and not cleared since, the nodes they recorded are kept alive to be restored
+    mutable std::vector<node_tree_snapshot*> snapshots_;
+
+    /**
+     * A path resolved by find, kept until a node on its route changes
+     */
+    struct resolved_path
+    {
+        const node* start = nullptr;
+        node_path path;
+        bool names_start = false;
+        node* found = nullptr;
+
+        // Nodes walked through to resolve the path with their structure version at the time, the found node is not
+        // part of the route because its parent changes when it moves
+        std::vector<std::pair<const node*, uint64_t>> route;
+    };
+
+    // Indexed by the hash of the start node and the path, an entry is replaced when another path has the same hash
+    mutable std::unordered_map<std::size_t, resolved_path> resolved_paths_;
+
+    // Nodes of the instance being created, indexed like the nodes of its prefab
+    std::vector<node*> instance_nodes_;
+
+    /**
+     * A parent given to a node by the applied command buffers
+     */
+    struct structure_move
+    {
+        // nullptr when a later command moves the same node
+        node* child;
+
+        // nullptr when the child is detached
+        node* parent;
+
+        // Position of the command among the commands of all the buffers
+        std::size_t order;
+
+        // Index of the group of the parent
+        std::size_t group;
+    };
+
+    /**
+     * The moves to the same parent, applied together
+     */
+    struct structure_group
+    {
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    // Moves of the command buffers being applied, in the order of the commands, sorted by child and grouped by parent
+    std::vector<structure_move> structure_moves_;
+    std::vector<structure_move> moves_by_child_;
+    std::vector<structure_move> grouped_moves_;
+
+    // Groups in the order their parent first appears and the group of each parent
+    std::vector<structure_group> structure_groups_;
+    std::unordered_map<const node*, std::size_t> parent_groups_;
+
+    friend class node;
+    friend class node2d;
+    friend class node_tree_snapshot;
+
+    /**
+     * Mark a node as reachable, its children will be marked later
+     * @param n The node to mark
+     */
+    void shade(node* n);
+
+    /**
+     * Called before a child is attached to a node, makes sure the child is not freed by an ongoing collection
+     * @param parent The new parent
+     * @param child The attached child
+     */
+    void on_child_attached(const node* parent, node* child);
+
+    /**
+     * Makes sure a node that became reachable and its subtree are not freed by an ongoing collection
+     * @param n The node, attached to a reachable node or made the root
+     */
+    void keep_while_collecting(node* n);
+
+    void begin_collection();
+
+    /**
+     * Mark the nodes recorded by the live snapshots as reachable
+     */
+    void shade_snapshots();
+
+    /**
+     * Keep the nodes recorded by a snapshot alive until it is cleared or destroyed
+     * @param snapshot A snapshot taken from this tree
+     */
+    void register_snapshot(node_tree_snapshot* snapshot) const;
+
+    /**
+     * Stop keeping the nodes recorded by a snapshot alive
+     * @param snapshot A registered snapshot
+     */
+    void forget_snapshot(const node_tree_snapshot* snapshot) const noexcept;
+
+    /**
+     * Returns a version that was never given to a node of this tree
+     * @return The new structure version
+     */
+    [[nodiscard]] uint64_t next_structure_version() noexcept;
+
+    /**
+     * Find a node from a starting node, using the resolved paths when the route didn't change
+     * @param start The node where the path starts
+     * @param path The path to resolve
+     * @param names_start true when the first element of the path is the name of the start node
+     * @return The found node or nullptr
+     */
+    [[nodiscard]] node* resolve(node* start, const node_path& path, bool names_start) const;
+
+    /**
+     * Returns the pool storing a type of nodes, creating it the first time
+     * @tparam NodeType The type of nodes
+     * @return The pool storing the nodes of this type
+     */
+    template<typename NodeType>
+    node_pool& pool_of()
+    {
+        const std::size_t index = node_pool_index<NodeType>();
+        if(index >= pools_.size())
+        {
+            pools_.resize(index + 1);
+        }
+
+        if(!pools_[index])
+        {
+            pools_[index] = std::make_unique<typed_node_pool<NodeType>>();
+        }
+
+        return *pools_[index];
+    }
+
+    /**
+     * Make sure a number of nodes can be owned without growing the list of nodes
+     * @param count The number of nodes that will be created
+     */
+    void reserve_nodes(std::size_t count);
+
+    /**
+     * Create a range of the nodes of a subtree stored in flat arrays and link them to their parent
+     * @param begin The index of the first created node, the node at index 0 is the root of the subtree
+     * @param end The index after the last created node
+     * @param parents The index of the parent of each node, parents are stored before their children
+     * @param construct Called with the index of each node, returns the created node
+     * @note The created nodes are stored in instance_nodes_, which must already hold end nodes
+     */
+    template<typename Construct>
+    void create_linked_nodes(std::size_t begin, std::size_t end, const uint32_t* parents, Construct&& construct);
+
+    /**
+     * Apply command buffers in order
+     * @param buffers The first buffer
+     * @param count The number of buffers
+     */
+    void apply(node_command_buffer* buffers, std::size_t count);
+
+    /**
+     * Mark reachable nodes until the deadline is reached
+     * @return true when every reachable node is marked
+     */
+    bool mark_until(frame_clock::time_point deadline);
+
+    /**
+     * Free unmarked nodes until the deadline is reached
+     * @return true when every node was swept
+     */
+    bool sweep_until(frame_clock::time_point deadline);
+
 public:
     using iterator = node_tree_iterator;
     using const_iterator = const_node_tree_iterator;
 
+    node_tree();
+
+    /**
+     * Destroy the nodes of the tree, the snapshots taken from it are cleared
+     */
+    ~node_tree();
+
+    // Nodes keep a pointer to their tree
+    node_tree(const node_tree&) = delete;
+    node_tree& operator=(const node_tree&) = delete;
+
     /**
      * Set the root node for this tree
      * @param root The new root node for this tree
@@ -167,21 +433,50 @@ public:
      * Check if a node is reachable
      * @param n the node to check
      * @return true when reachable or false otherwise
+     * @note Walks up the parents of the node, it doesn't visit the tree
      */
     [[nodiscard]] bool reachable(const node* n) const noexcept;
 
     /**
      * Find a node by it's path
-     * @param path The path to get the node from
-     * @return the found node
+     * @param path The path to get the node from, relative paths starts with the name of the root
+     * @return the found node or nullptr
+     * @note Resolved paths are remembered until a node on their route is attached, detached or renamed so finding
+     *       the same path again is a single hash lookup. Not safe to call from multiple threads
      */
-    [[nodiscard]] node* find(const node_path& path) const noexcept;
+    [[nodiscard]] node* find(const node_path& path) const;
+
+    /**
+     * Find a node by it's path relative to another node
+     * @param path The path to get the node from, absolute paths starts from the root
+     * @param from The node where relative paths start
+     * @return the found node or nullptr
+     * @note Uses the same resolved paths as find(path)
+     */
+    [[nodiscard]] node* find(const node_path& path, node* from) const;
 
     /**
      * Free all nodes owned by this tree that doesn't exist in the tree
+     * @note Marks every node reachable from the root then frees the other nodes in a single pass,
+     *       an incremental collection in progress is restarted
      */
     void free_unreachable_nodes();
 
+    /**
+     * Free nodes owned by this tree that doesn't exist in the tree, stopping once the budget is spent
+     * The collection is resumed by the next call, a new collection is started after the previous one finished
+     * @param budget How long the collection can run
+     * @return true when a collection finished during this call
+     * @note Nodes attached or created while collecting are kept until the next collection
+     */
+    bool free_unreachable_nodes(frame_duration budget);
+
+    /**
+     * Check if an incremental collection is in progress
+     * @return true when a collection was started but not finished
+     */
+    [[nodiscard]] bool collecting() const noexcept;
+
     /**
      * Create a new node owned by this tree
      * @tparam NodeType The type of the node to construct
@@ -194,17 +489,194 @@ public:
     {
         static_assert(std::is_base_of_v<node, NodeType>, "Expecting valid node type");
 
-        std::unique_ptr<NodeType> new_node = std::make_unique<NodeType>(std::forward<Args>(args)...);
-        // Here we set the owner of the node to be this tree
-        new_node->owner_ = this;
-
-        NodeType* node_ptr = new_node.get();
-
+        node_pool& pool = pool_of<NodeType>();
+        void* memory = pool.allocate();
+
+        NodeType* node_ptr = nullptr;
+        try
+        {
+            // Here we set the owner of the node to be this tree
+            node_ptr = new(memory) NodeType(*this, std::forward<Args>(args)...);
+        }
+        catch(...)
+        {
+            pool.free(memory);
+            throw;
+        }
+
+        owned_node new_node{node_ptr, pooled_node_deleter{&pool, memory}};
         nodes_.push_back(std::move(new_node));
 
         return node_ptr;
     }
 
+    /**
+     * Make sure a number of nodes of a type can be created without allocating
+     * @tparam NodeType The type of the nodes that will be created
+     * @param count The number of nodes that will be created
+     */
+    template<typename NodeType>
+    void reserve(std::size_t count)
+    {
+        static_assert(std::is_base_of_v<node, NodeType>, "Expecting valid node type");
+
+        pool_of<NodeType>().reserve(count);
+        nodes_.reserve(nodes_.size() + count);
+    }
+
+    /**
+     * Create a copy of the nodes of a prefab
+     * @param source The prefab to copy
+     * @param parent The node the copy is attached to or nullptr to keep it detached
+     * @return The root of the copy
+     * @throw invalid_node_name When the parent already has a child with the name of the root of the prefab
+     * @note Storage for the whole copy is reserved up front and the nodes are linked by index without looking for
+     *       duplicate names. When an exception is thrown, the nodes already created are unreachable and freed by the
+     *       next collection
+     */
+    node* instantiate(const prefab& source, node* parent = nullptr);
+
+    /**
+     * Create a copy of the nodes of a prefab with another name for its root
+     * @param source The prefab to copy
+     * @param root_name The name of the root of the copy
+     * @param parent The node the copy is attached to or nullptr to keep it detached
+     * @return The root of the copy
+     * @throw invalid_node_name When the parent already has a child with the name of the root
+     */
+    node* instantiate(const prefab& source, safe_name root_name, node* parent = nullptr);
+
+    /**
+     * Create the nodes of a binary scene
+     * @param scene The scene, usually mapped from a file by load_scene
+     * @param types The types of the nodes of the scene
+     * @param parent The node the scene is attached to or nullptr to keep it detached
+     * @param progress Receives the number of created nodes and stops the load once cancelled, can be nullptr
+     * @return The root of the loaded scene or nullptr when the load was cancelled
+     * @throw scene_file_error When a type of the scene is not registered
+     * @throw invalid_node_name When the parent already has a child with the name of the root of the scene
+     * @note Like instantiate, storage for the whole scene is reserved up front and the nodes are linked by index.
+     *       Each name of the string table is created once
+     */
+    node* load(const scene_view& scene, const node_type_registry& types, node* parent = nullptr,
+               scene_load_progress* progress = nullptr);
+
+    /**
+     * Move every node of another tree in this tree
+     * @param other The tree giving its nodes, it is empty afterward and its root is attached to the parent
+     * @param parent The node the root of the other tree is attached to or nullptr to keep it detached
+     * @return The previous root of the other tree
+     * @throw invalid_node_name When the parent already has a child with the name of the root
+     * @note The nodes, their memory, their transforms and their spatial entries are moved in a single pass without
+     *       creating anything, so a tree built on another thread can be added to a live tree cheaply. The nodes of
+     *       the other tree must not listen to events, tick or have components, they start after being merged
+     */
+    node* merge(node_tree& other, node* parent = nullptr);
+
+    /**
+     * Apply the commands recorded in a buffer
+     * @param buffer The buffer, it is empty afterward
+     * @throw invalid_node_name When a parent already has a child with the name of an attached node
+     * @note Same as applying a vector holding the buffer
+     */
+    void apply(node_command_buffer& buffer);
+
+    /**
+     * Apply the commands recorded in buffers, usually one buffer per thread of a parallel update
+     * @param buffers The buffers, they are empty afterward
+     * @throw invalid_node_name When a parent already has a child with the name of an attached node
+     * @note The result only depends on the order of the buffers and of their commands:
+     *       - nodes are created buffer by buffer, in the order they were recorded
+     *       - only the last attach, detach or destroy of each node is applied
+     *       - a node can take the name of a node detached or moved away by any command
+     *       - the children of a parent are attached together, in the order of their last command
+     *       When an exception is thrown, the nodes attached before stay attached
+     */
+    void apply(std::vector<node_command_buffer>& buffers);
+
+    /**
+     * Record the structure, the names and the local transforms of the nodes reachable from the root
+     * @param snapshot Where the state is recorded, its memory is reused from one snapshot to the next
+     * @note The structure is only recorded again when it changed since it was last recorded in the same snapshot,
+     *       otherwise only the local transforms are copied
+     */
+    void snapshot(node_tree_snapshot& snapshot) const;
+
+    /**
+     * Give back the structure, the names and the local transforms recorded in a snapshot
+     * @param snapshot A snapshot taken from this tree
+     * @note Only the nodes whose structure changed since the snapshot are moved or renamed and only the changed local
+     *       transforms are set, nothing is created or destroyed: nodes attached since the snapshot are detached and
+     *       freed by the next collection. The recorded nodes are never collected while the snapshot is alive and not
+     *       cleared, even when they were detached since
+     */
+    void restore(node_tree_snapshot& snapshot);
+
+    /**
+     * Compute the world transform of every node2d that is outdated
+     * @note Done in a single pass over the transform store, starting from the first node moved since the last update.
+     *       The spatial index is refreshed with the new world bounds
+     */
+    void update_world_transforms();
+
+    /**
+     * Compute the world transform of every node2d that is outdated using multiple threads
+     * @param pool The threads computing the world transforms
+     * @note Each depth level of the transform store is split across the pool, the results are the same as
+     *       the single threaded update
+     */
+    void update_world_transforms(thread_pool& pool);
+
+    /**
+     * Store the world transform of every node2d as the transforms of the previous tick
+     * @note Should be called once at the start of every tick, before any node moves
+     */
+    void capture_world_transforms();
+
+    /**
+     * Returns the transforms of every node2d of this tree
+     * @return The transforms of every node2d
+     * @note The renderer interpolates between the captured tick and the current world transforms
+     */
+    [[nodiscard]] const transform_store& transforms() const noexcept;
+
+    /**
+     * Returns the events sent to the nodes of this tree
+     * @return The events of this tree
+     */
+    [[nodiscard]] event_dispatcher& events() noexcept;
+    [[nodiscard]] const event_dispatcher& events() const noexcept;
+
+    /**
+     * Returns the tick groups of the nodes of this tree
+     * @return The scheduler ticking the nodes of this tree
+     */
+    [[nodiscard]] tick_scheduler& scheduler() noexcept;
+    [[nodiscard]] const tick_scheduler& scheduler() const noexcept;
+
+    /**
+     * Returns the index finding the node2d of this tree by their bounds
+     * @return The spatial index of this tree
+     * @note The index is refreshed every time the world transforms are updated
+     */
+    [[nodiscard]] spatial_index& spatial() noexcept;
+    [[nodiscard]] const spatial_index& spatial() const noexcept;
+
+    /**
+     * Returns the components of the nodes of this tree
+     * @return The component store of this tree
+     */
+    [[nodiscard]] component_store& components() noexcept;
+    [[nodiscard]] const component_store& components() const noexcept;
+
+    /**
+     * Returns an iterator to a node, iterating over the node and its descendants
+     * @param subtree_root The node where the iteration starts
+     * @return An iterator to the node
+     */
+    [[nodiscard]] static iterator begin(node* subtree_root) noexcept;
+    [[nodiscard]] static const_iterator begin(const node* subtree_root) noexcept;
+
     /**
      * Returns an iterator to the root node
      * @return An iterator to the root node
@@ -0,0 +1,102 @@
+#ifndef NGINE_GAMEPLAY_NODE_TREE_SNAPSHOT_HPP
+#define NGINE_GAMEPLAY_NODE_TREE_SNAPSHOT_HPP
+
+#include <ng/core/name.hpp>
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+
+namespace ng
+{
+
+class node;
+class node2d;
+class node_tree;
+
+/**
+ * The state of a node_tree at one point of time: the structure, the names and the local transforms of its nodes
+ * Taken with node_tree::snapshot and given back with node_tree::restore, a few snapshots can be kept to roll back
+ * frames or to scrub a replay. Nodes are referenced and not copied, restoring moves and renames the same nodes, so
+ * the recorded nodes are not collected until the snapshot is cleared or destroyed
+ */
+class node_tree_snapshot
+{
+    friend node_tree;
+
+    struct node_record
+    {
+        node* n;
+        safe_name name;
+
+        // Record of the parent, 0 for the root
+        uint32_t parent;
+
+        // The children of a node are recorded next to each other, in their order
+        uint32_t first_child;
+        uint32_t child_count;
+    };
+
+    // Tree the snapshot was taken from, it keeps the recorded nodes alive
+    const node_tree* tree_;
+
+    node* root_;
+
+    // Structure version of the tree when the structure was recorded, nodes with a later version changed since
+    uint64_t structure_version_;
+
+    // Nodes reachable from the root, breadth first, the root being the first one
+    std::vector<node_record> nodes_;
+
+    // Node owning each slot of the transform store, nullptr for a released slot or a node being freed
+    std::vector<node2d*> transform_nodes_;
+
+    // Local transform of each slot, copied in the layout of the transform store
+    std::vector<glm::vec2> local_translations_;
+    std::vector<float> local_rotations_;
+    std::vector<glm::vec2> local_scales_;
+
+    // Records of the nodes changed since the snapshot, found before restoring any of them, and whether each record
+    // changed
+    std::vector<uint32_t> changed_nodes_;
+    std::vector<uint8_t> changed_records_;
+
+    // Recorded slot of each node2d, only filled when the transform store moved its slots since the snapshot
+    std::unordered_map<const node2d*, std::size_t> recorded_slots_;
+
+public:
+    node_tree_snapshot();
+
+    // The tree keeps the address of its snapshots
+    node_tree_snapshot(const node_tree_snapshot&) = delete;
+    node_tree_snapshot& operator=(const node_tree_snapshot&) = delete;
+
+    node_tree_snapshot(node_tree_snapshot&& other);
+    node_tree_snapshot& operator=(node_tree_snapshot&& other);
+
+    ~node_tree_snapshot();
+
+    /**
+     * Returns the number of recorded nodes
+     * @return The number of nodes reachable from the root when the snapshot was taken
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * Check if nothing is recorded
+     * @return true when the snapshot was never taken or the tree had no root
+     */
+    [[nodiscard]] bool empty() const noexcept;
+
+    /**
+     * Forget the recorded state, the recorded nodes can be collected again
+     * @note The memory is kept for the next snapshot
+     */
+    void clear() noexcept;
+};
+
+}
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef NGINE_GAMEPLAY_NODE_TYPE_REGISTRY_HPP
+#define NGINE_GAMEPLAY_NODE_TYPE_REGISTRY_HPP
+
+#include "node.hpp"
+#include "node2d.hpp"
+#include "node_tree.hpp"
+
+#include <ng/core/name.hpp>
+
+#include <typeindex>
+#include <typeinfo>
+#include <type_traits>
+#include <vector>
+#include <cstddef>
+
+namespace ng
+{
+
+/**
+ * The types of nodes that can be created from their name, used to store nodes in files
+ */
+class node_type_registry
+{
+public:
+    using construct_function = node* (*)(node_tree& tree, const safe_name& name);
+    using reserve_function = void (*)(node_tree& tree, std::size_t count);
+
+    /**
+     * A registered type of node
+     */
+    struct node_type
+    {
+        safe_name type_name;
+        std::type_index type;
+
+        // Creates a node of this type with the tree and its name
+        construct_function construct;
+
+        // Reserves the pool storing the nodes of this type
+        reserve_function reserve;
+
+        // Set when the type derives from node2d
+        bool is_node2d;
+    };
+
+private:
+    std::vector<node_type> types_;
+
+    void add(node_type type);
+
+public:
+    /**
+     * Construct a registry knowing node and node2d
+     */
+    node_type_registry();
+
+    /**
+     * Register a type of node
+     * @tparam NodeType The type of node, constructed with the tree and the name of the node
+     * @param type_name The name of the type, stored in files instead of the type
+     * @throw std::logic_error When the name or the type is already registered
+     */
+    template<typename NodeType>
+    void add(safe_name type_name)
+    {
+        static_assert(std::is_base_of_v<node, NodeType>, "Expecting valid node type");
+
+        add(node_type{
+            std::move(type_name),
+            std::type_index{typeid(NodeType)},
+            [](node_tree& tree, const safe_name& name) -> node*
+            {
+                return tree.make_node<NodeType>(name);
+            },
+            [](node_tree& tree, std::size_t count)
+            {
+                tree.reserve<NodeType>(count);
+            },
+            std::is_base_of_v<node2d, NodeType>
+        });
+    }
+
+    /**
+     * Find a type by its name
+     * @param type_name The name of the type
+     * @return The type or nullptr when it is not registered
+     */
+    [[nodiscard]] const node_type* find(const safe_name& type_name) const noexcept;
+
+    /**
+     * Find the type of a node
+     * @param n The node
+     * @return The exact type of the node or nullptr when it is not registered
+     */
+    [[nodiscard]] const node_type* find(const node& n) const noexcept;
+};
+
+}
+
+#endif
@@ -0,0 +1,171 @@
+#ifndef NGINE_GAMEPLAY_PREFAB_HPP
+#define NGINE_GAMEPLAY_PREFAB_HPP
+
+#include "node.hpp"
+#include "node2d.hpp"
+#include "node_tree.hpp"
+
+#include <ng/core/name.hpp>
+#include <ng/core/transform2d.hpp>
+#include <ng/core/affine2d.hpp>
+#include <ng/core/aabb2d.hpp>
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace ng
+{
+
+/**
+ * A template subtree that can be instantiated many times with node_tree::instantiate
+ * The nodes are stored in flat arrays, each node refers to its parent by index. Names are checked once when the
+ * prefab is built, so instances are created without looking for duplicate names
+ */
+class prefab
+{
+public:
+    using index_type = uint32_t;
+
+    static constexpr index_type no_parent = std::numeric_limits<index_type>::max();
+
+private:
+    friend class node_tree;
+
+    using construct_function = node* (*)(node_tree& tree, const safe_name& name);
+    using reserve_function = void (*)(node_tree& tree, std::size_t count);
+
+    // Number of nodes of each type, their pools are reserved before creating an instance
+    struct node_type_count
+    {
+        std::size_t pool_index;
+        reserve_function reserve;
+        std::size_t count;
+    };
+
+    // One element per node, parents are always added before their children
+    std::vector<construct_function> constructors_;
+    std::vector<safe_name> names_;
+    std::vector<index_type> parents_;
+
+    // The node2d of the prefab with their local transform and bounds
+    std::vector<index_type> node2d_indices_;
+    std::vector<transform2d> local_transforms_;
+
+    // Built once so instances don't compute the rotation of every node again
+    std::vector<affine2d> local_affines_;
+    std::vector<aabb2d> local_bounds_;
+
+    std::vector<node_type_count> node_types_;
+
+    /**
+     * Add a node without its transform
+     * @param name The name of the node
+     * @param parent The index of the parent
+     * @param construct Creates the node in a tree
+     * @param pool_index The index of the pool storing the type of the node
+     * @param reserve Reserves the pool storing the type of the node
+     * @return The index of the node
+     * @throw invalid_node_name When a sibling already has the name
+     */
+    index_type add(safe_name name, index_type parent, construct_function construct, std::size_t pool_index,
+                   reserve_function reserve);
+
+public:
+    prefab() = default;
+
+    /**
+     * Add a node to the prefab
+     * @tparam NodeType The type of the node, constructed with the tree and the name
+     * @param name The name of the node
+     * @param parent The index of the parent or no_parent for the first node
+     * @return The index of the node
+     * @throw invalid_node_name When a sibling already has the name
+     */
+    template<typename NodeType>
+    index_type add(safe_name name, index_type parent = no_parent)
+    {
+        static_assert(std::is_base_of_v<node, NodeType>, "Expecting valid node type");
+
+        const index_type index = add(std::move(name), parent,
+                                     [](node_tree& tree, const safe_name& node_name) -> node*
+                                     {
+                                         return tree.make_node<NodeType>(node_name);
+                                     },
+                                     node_pool_index<NodeType>(),
+                                     [](node_tree& tree, std::size_t count)
+                                     {
+                                         tree.reserve<NodeType>(count);
+                                     });
+
+        if constexpr(std::is_base_of_v<node2d, NodeType>)
+        {
+            node2d_indices_.push_back(index);
+            local_transforms_.emplace_back(glm::vec2{0.f, 0.f});
+            local_affines_.emplace_back();
+            local_bounds_.emplace_back();
+        }
+
+        return index;
+    }
+
+    /**
+     * Add a node2d to the prefab
+     * @tparam NodeType The type of the node, constructed with the tree and the name
+     * @param name The name of the node
+     * @param transform The local transform of the node
+     * @param parent The index of the parent or no_parent for the first node
+     * @return The index of the node
+     * @throw invalid_node_name When a sibling already has the name
+     */
+    template<typename NodeType>
+    index_type add(safe_name name, const transform2d& transform, index_type parent = no_parent)
+    {
+        static_assert(std::is_base_of_v<node2d, NodeType>, "Expecting node2d type");
+
+        const index_type index = add<NodeType>(std::move(name), parent);
+        local_transforms_.back() = transform;
+        local_affines_.back() = affine2d{transform};
+
+        return index;
+    }
+
+    /**
+     * Set the local bounds of a node2d of the prefab
+     * @param index The index of the node2d
+     * @param bounds The local bounds given to the instances of the node
+     */
+    void set_local_bounds(index_type index, const aabb2d& bounds);
+
+    /**
+     * Returns the name of a node of the prefab
+     * @param index The index of the node
+     * @return The name of the node
+     */
+    [[nodiscard]] const safe_name& name(index_type index) const noexcept;
+
+    /**
+     * Returns the index of the parent of a node of the prefab
+     * @param index The index of the node
+     * @return The index of the parent or no_parent for the first node
+     */
+    [[nodiscard]] index_type parent(index_type index) const noexcept;
+
+    /**
+     * Returns the number of nodes of the prefab
+     * @return The number of nodes
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * Check if the prefab has no node
+     * @return true when no node was added
+     */
+    [[nodiscard]] bool empty() const noexcept;
+};
+
+}
+
+#endif
@@ -0,0 +1,161 @@
+#ifndef NGINE_GAMEPLAY_SCENE_FILE_HPP
+#define NGINE_GAMEPLAY_SCENE_FILE_HPP
+
+#include <filesystem>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+namespace ng
+{
+
+class node;
+class node_tree;
+class node_type_registry;
+
+class scene_file_error : public std::runtime_error
+{
+public:
+    explicit scene_file_error(const char* what)
+    : std::runtime_error(what)
+    {
+
+    }
+};
+
+/**
+ * The local transform of a node2d in a scene file
+ */
+struct scene_transform
+{
+    float translation_x;
+    float translation_y;
+    float rotation;
+    float scale_x;
+    float scale_y;
+};
+
+/**
+ * The local bounds of a node2d in a scene file
+ */
+struct scene_bounds
+{
+    float min_x;
+    float min_y;
+    float max_x;
+    float max_y;
+};
+
+/**
+ * Reads a binary scene written by write_scene
+ * A scene stores a subtree as flat arrays: the type, the name and the index of the parent of every node in pre-order,
+ * then the local transform and bounds of every node2d in the same order. Types and names are indices in a table of
+ * strings, so each different string is stored once.
+ * The arrays are read in place, the view only checks that they fit in the memory and that the indices are valid
+ * @note The scene is stored with the byte order of the machine that wrote it
+ */
+class scene_view
+{
+    uint32_t node_count_;
+    uint32_t node2d_count_;
+    uint32_t type_count_;
+    uint32_t string_count_;
+
+    const uint32_t* type_names_;
+    const uint32_t* node_types_;
+    const uint32_t* node_names_;
+    const uint32_t* node_parents_;
+    const scene_transform* transforms_;
+    const scene_bounds* bounds_;
+    const uint32_t* string_offsets_;
+    const char* strings_;
+
+public:
+    static constexpr uint32_t no_parent = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * Check and read a scene stored in memory
+     * @param data The first byte of the scene, aligned on 8 bytes
+     * @param size The size of the scene in bytes
+     * @throw scene_file_error When the memory doesn't contain a valid scene or two siblings have the same name
+     * @note The memory must outlive the view
+     */
+    scene_view(const void* data, std::size_t size);
+
+    [[nodiscard]] std::size_t node_count() const noexcept;
+    [[nodiscard]] std::size_t node2d_count() const noexcept;
+    [[nodiscard]] std::size_t type_count() const noexcept;
+    [[nodiscard]] std::size_t string_count() const noexcept;
+
+    /**
+     * Returns a string of the string table
+     * @param index The index of the string
+     * @return The string
+     */
+    [[nodiscard]] std::string_view string(uint32_t index) const noexcept;
+
+    /**
+     * Returns the index of the name of each type in the string table
+     * @return type_count indices
+     */
+    [[nodiscard]] const uint32_t* type_names() const noexcept;
+
+    /**
+     * Returns the index of the type of each node
+     * @return node_count indices
+     */
+    [[nodiscard]] const uint32_t* node_types() const noexcept;
+
+    /**
+     * Returns the index of the name of each node in the string table
+     * @return node_count indices
+     */
+    [[nodiscard]] const uint32_t* node_names() const noexcept;
+
+    /**
+     * Returns the index of the parent of each node
+     * @return node_count indices, the first node is the root of the scene and has no_parent
+     */
+    [[nodiscard]] const uint32_t* node_parents() const noexcept;
+
+    /**
+     * Returns the local transform of each node2d
+     * @return node2d_count transforms
+     */
+    [[nodiscard]] const scene_transform* transforms() const noexcept;
+
+    /**
+     * Returns the local bounds of each node2d
+     * @return node2d_count bounds
+     */
+    [[nodiscard]] const scene_bounds* bounds() const noexcept;
+};
+
+/**
+ * Write a subtree as a binary scene
+ * @param subtree_root The root of the written subtree
+ * @param types The types of the nodes of the subtree
+ * @param output Receives the scene
+ * @throw std::invalid_argument When the type of a node is not registered
+ */
+void write_scene(const node* subtree_root, const node_type_registry& types, std::ostream& output);
+
+/**
+ * Load a binary scene file in a tree
+ * @param tree The tree creating the nodes
+ * @param path The path of the scene file, it is mapped in memory while the nodes are created
+ * @param types The types of the nodes of the scene
+ * @param parent The node the scene is attached to or nullptr to keep it detached
+ * @return The root of the loaded scene
+ * @throw scene_file_error When the file doesn't contain a valid scene
+ * @throw std::system_error When the file can't be read
+ */
+node* load_scene(node_tree& tree, const std::filesystem::path& path, const node_type_registry& types,
+                 node* parent = nullptr);
+
+}
+
+#endif
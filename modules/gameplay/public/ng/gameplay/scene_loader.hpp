@@ -0,0 +1,137 @@
+#ifndef NGINE_GAMEPLAY_SCENE_LOADER_HPP
+#define NGINE_GAMEPLAY_SCENE_LOADER_HPP
+
+#include "node_tree.hpp"
+
+#include <atomic>
+#include <exception>
+#include <filesystem>
+#include <thread>
+#include <cstddef>
+
+namespace ng
+{
+
+class node;
+class node_type_registry;
+
+/**
+ * Follows the creation of the nodes of a scene, it can be read and cancelled from another thread
+ */
+class scene_load_progress
+{
+    std::atomic<std::size_t> node_count_;
+    std::atomic<std::size_t> created_nodes_;
+    std::atomic<bool> cancelled_;
+
+public:
+    scene_load_progress() noexcept;
+
+    /**
+     * Called once the number of nodes of the scene is known
+     * @param node_count The number of nodes of the scene
+     */
+    void start(std::size_t node_count) noexcept;
+
+    /**
+     * Called every time a batch of nodes was created
+     * @param created_nodes The number of nodes created since the load started
+     */
+    void set_created_nodes(std::size_t created_nodes) noexcept;
+
+    /**
+     * Ask the load to stop, it stops after the batch of nodes being created
+     */
+    void cancel() noexcept;
+
+    [[nodiscard]] bool cancelled() const noexcept;
+
+    /**
+     * Returns the number of nodes of the scene
+     * @return The number of nodes or 0 when the scene was not read yet
+     */
+    [[nodiscard]] std::size_t node_count() const noexcept;
+
+    [[nodiscard]] std::size_t created_nodes() const noexcept;
+
+    /**
+     * Returns how much of the scene was created
+     * @return The ratio of created nodes, between 0 and 1
+     */
+    [[nodiscard]] float ratio() const noexcept;
+};
+
+/**
+ * Loads a scene file on a background thread
+ * The nodes are created in a tree owned by the loader, with its own pools, transforms and spatial index, so the live
+ * tree is not touched while the scene loads. Once the load is finished, commit moves the nodes to the live tree
+ * without creating anything
+ * @note Node types are constructed on the background thread, their constructor must only use their own tree
+ */
+class scene_loader
+{
+    node_tree staging_;
+    scene_load_progress progress_;
+
+    // Root of the loaded scene, nullptr until the load finished or when it was cancelled
+    node* root_;
+
+    // Thrown by commit when the load failed
+    std::exception_ptr error_;
+
+    std::atomic<bool> finished_;
+    std::thread worker_;
+
+    void load(const std::filesystem::path& path, const node_type_registry& types) noexcept;
+
+public:
+    /**
+     * Start loading a scene file
+     * @param path The path of the scene file
+     * @param types The types of the nodes of the scene, it must outlive the loader
+     */
+    scene_loader(std::filesystem::path path, const node_type_registry& types);
+
+    /**
+     * Cancel the load and wait for the background thread, the nodes that were not committed are destroyed
+     */
+    ~scene_loader();
+
+    scene_loader(const scene_loader&) = delete;
+    scene_loader& operator=(const scene_loader&) = delete;
+
+    /**
+     * Stop the load, commit returns nullptr once it stopped
+     */
+    void cancel() noexcept;
+
+    /**
+     * Check if the background thread is done with the scene
+     * @return true when the scene was loaded, when the load failed or when it was cancelled
+     */
+    [[nodiscard]] bool finished() const noexcept;
+
+    /**
+     * Block until the background thread is done with the scene
+     */
+    void wait();
+
+    [[nodiscard]] const scene_load_progress& progress() const noexcept;
+
+    /**
+     * Move the loaded nodes to a tree
+     * @param tree The tree receiving the nodes
+     * @param parent The node the scene is attached to or nullptr to keep it detached
+     * @return The root of the scene or nullptr when the load was cancelled or was already committed
+     * @throw scene_file_error When the file doesn't contain a valid scene
+     * @throw std::system_error When the file can't be read
+     * @throw invalid_node_name When the parent already has a child with the name of the root of the scene
+     * @note Blocks until the load finished, check finished first to keep the frame under budget. The world
+     *       transforms and bounds of the scene were computed by the background thread
+     */
+    node* commit(node_tree& tree, node* parent = nullptr);
+};
+
+}
+
+#endif
@@ -0,0 +1,173 @@
+#ifndef NGINE_GAMEPLAY_SPATIAL_INDEX_HPP
+#define NGINE_GAMEPLAY_SPATIAL_INDEX_HPP
+
+#include <ng/core/aabb2d.hpp>
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <vector>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace ng
+{
+
+class node2d;
+class transform_store;
+
+/**
+ * Finds the node2d whose world bounds are in a region
+ * Uses a hierarchy of loose hash grids: each level has cells twice as large as the previous level and a node is stored
+ * in the cell containing its center, on the first level whose cells are larger than its bounds. A node only overlaps
+ * the neighbours of its cell, so moving a node is O(1) and queries only visit the cells around the region
+ * @note Nodes are indexed by calling node2d::set_local_bounds. Their world bounds are refreshed when the tree updates
+ *       its world transforms, queries see the bounds of the last update
+ */
+class spatial_index
+{
+public:
+    using entry_type = uint32_t;
+
+    static constexpr entry_type invalid_entry = std::numeric_limits<entry_type>::max();
+
+private:
+    // Cells of the last level are 2^23 times larger than the cells of the first level
+    static constexpr std::size_t level_count = 24;
+
+    // Queries only read the cells, so the bounds are stored next to each other in their cell
+    struct cell_entry
+    {
+        aabb2d world_bounds;
+        node2d* indexed_node;
+    };
+
+    using cell = std::vector<cell_entry>;
+
+    struct entry
+    {
+        node2d* indexed_node;
+
+        // Elements of the map are never moved, a cell is only erased once it is empty
+        uint64_t cell_key;
+        cell* entry_cell;
+        std::size_t index_in_cell;
+
+        // Version of the world transform used to compute the world bounds
+        uint32_t world_version;
+    };
+
+    std::vector<entry> entries_;
+
+    // Non empty cells
+    std::unordered_map<uint64_t, cell> cells_;
+
+    // Number of entries stored on each level, empty levels are not visited
+    std::array<std::size_t, level_count> level_sizes_;
+
+    float cell_size_;
+
+    [[nodiscard]] std::size_t level_of(const aabb2d& bounds) const noexcept;
+    [[nodiscard]] uint64_t cell_of(const aabb2d& bounds) const noexcept;
+
+    void link(entry_type index, uint64_t key, const aabb2d& world_bounds);
+    void unlink(entry_type index) noexcept;
+
+    /**
+     * Call a function with every entry that could intersect a region
+     * @param region The region
+     * @param function Called with the index of each entry
+     */
+    template<typename Function>
+    void visit(const aabb2d& region, Function&& function) const;
+
+public:
+    /**
+     * Construct an empty index
+     * @param cell_size The size of the cells of the first level, should be close to the size of most nodes
+     */
+    explicit spatial_index(float cell_size = 64.f);
+
+    spatial_index(const spatial_index&) = delete;
+    spatial_index& operator=(const spatial_index&) = delete;
+
+    /**
+     * Add a node to the index
+     * @param n The node to add, it must not be indexed
+     * @param world_bounds The bounds of the node in world space
+     * @param world_version The version of the world transform used to compute the world bounds
+     */
+    void insert(node2d* n, const aabb2d& world_bounds, uint32_t world_version);
+
+    /**
+     * Move a node in the index
+     * @param index The entry of the node
+     * @param world_bounds The new bounds of the node in world space
+     * @param world_version The version of the world transform used to compute the world bounds
+     */
+    void update(entry_type index, const aabb2d& world_bounds, uint32_t world_version);
+
+    /**
+     * Remove a node from the index
+     * @param index The entry of the node
+     */
+    void remove(entry_type index) noexcept;
+
+    /**
+     * Move every node of another index in this index
+     * @param other The index giving its nodes, it is empty afterward
+     * @note The entries of the smaller index are moved to the larger one, cell by cell without hashing each node
+     *       again. Both indices must have the same cell size
+     */
+    void append(spatial_index& other);
+
+    /**
+     * Move the nodes whose world transform changed since their bounds were computed
+     * @param transforms The up to date transforms of the tree, the world bounds are read from the store
+     * @note Only the slots changed by the last update of the store are visited, so it must be called after every update
+     */
+    void refresh(const transform_store& transforms);
+
+    /**
+     * Find the nodes whose world bounds intersect a region
+     * @param region The region
+     * @param found Receives the found nodes, in no specific order
+     */
+    void query(const aabb2d& region, std::vector<node2d*>& found) const;
+
+    /**
+     * Find the nodes whose world bounds intersect a circle
+     * @param center The center of the circle
+     * @param radius The radius of the circle
+     * @param found Receives the found nodes, in no specific order
+     */
+    void query(const glm::vec2& center, float radius, std::vector<node2d*>& found) const;
+
+    /**
+     * Find the nodes closest to a point
+     * @param point The point
+     * @param count The maximum number of nodes to find
+     * @param found Receives the found nodes, from the closest to the farthest
+     * @note The distance to a node is the distance to its world bounds
+     */
+    void nearest(const glm::vec2& point, std::size_t count, std::vector<node2d*>& found) const;
+
+    /**
+     * Returns the world bounds of an entry
+     * @param index The entry
+     * @return The world bounds of the entry when it was last refreshed
+     */
+    [[nodiscard]] const aabb2d& world_bounds(entry_type index) const noexcept;
+
+    /**
+     * Returns the number of indexed nodes
+     * @return The number of indexed nodes
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+};
+
+}
+
+#endif
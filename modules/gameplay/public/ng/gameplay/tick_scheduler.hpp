@@ -0,0 +1,206 @@
+#ifndef NGINE_GAMEPLAY_TICK_SCHEDULER_HPP
+#define NGINE_GAMEPLAY_TICK_SCHEDULER_HPP
+
+#include "node.hpp"
+#include "node_pool.hpp"
+
+#include <ng/core/time.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+#include <typeinfo>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace ng
+{
+
+class thread_pool;
+
+using tick_group_id = std::size_t;
+
+/**
+ * Controls how the nodes of a tick group are ticked
+ */
+struct tick_group_settings
+{
+    // Minimum time between two ticks of the group, the group ticks every time the scheduler ticks when zero
+    frame_duration interval{0};
+
+    // The nodes of the group can tick at the same time from multiple threads
+    bool thread_safe = false;
+};
+
+/**
+ * Ticks the nodes registered to tick groups, one group after the other
+ * The nodes of a group are stored in one array per type of node so ticking a group calls the same function over
+ * contiguous nodes, without going through the virtual table
+ */
+class tick_scheduler
+{
+    using tick_function = void(*)(node* const* nodes, std::size_t count, frame_duration dt);
+
+    struct type_bucket
+    {
+        // Index of the type of the nodes, given by node_pool_index
+        std::size_t type;
+        tick_function tick;
+        std::vector<node*> nodes;
+    };
+
+    struct group
+    {
+        tick_group_settings settings;
+
+        // Groups ticking before this one
+        std::vector<tick_group_id> dependencies;
+
+        // Sorted by type
+        std::vector<type_bucket> buckets;
+
+        // Time since the group last ticked
+        frame_duration elapsed{0};
+    };
+
+    struct registration
+    {
+        tick_group_id group;
+        std::size_t type;
+        std::size_t index;
+    };
+
+    struct pending_registration
+    {
+        node* registered_node;
+        tick_group_id group;
+        std::size_t type;
+        tick_function tick;
+    };
+
+    std::vector<group> groups_;
+
+    // Groups sorted so every group comes after its dependencies
+    std::vector<tick_group_id> order_;
+    bool order_outdated_;
+
+    std::unordered_map<const node*, registration> registrations_;
+
+    // Nodes can't be added or removed from the arrays while ticking, removed nodes leave a nullptr behind
+    bool ticking_;
+    bool holes_;
+    std::vector<pending_registration> pending_registrations_;
+
+    void add(node* registered_node, tick_group_id group_id, std::size_t type, tick_function tick);
+    void insert(node* registered_node, tick_group_id group_id, std::size_t type, tick_function tick);
+    void sort_groups();
+    void remove_holes();
+    void tick(frame_duration dt, thread_pool* pool);
+
+    /**
+     * Tick contiguous nodes of the same type
+     * @tparam NodeType The type of the nodes
+     */
+    template<typename NodeType>
+    static void tick_nodes(node* const* nodes, std::size_t count, frame_duration dt)
+    {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            // Removed nodes leave a hole until the end of the tick
+            if(nodes[i])
+            {
+                static_cast<NodeType*>(nodes[i])->NodeType::on_tick(dt);
+            }
+        }
+    }
+
+public:
+    // Groups created with every scheduler, each one ticks after the previous one
+    static constexpr tick_group_id pre_physics = 0;
+    static constexpr tick_group_id physics = 1;
+    static constexpr tick_group_id post_physics = 2;
+    static constexpr tick_group_id late = 3;
+
+    tick_scheduler();
+
+    tick_scheduler(const tick_scheduler&) = delete;
+    tick_scheduler& operator=(const tick_scheduler&) = delete;
+
+    /**
+     * Create a new tick group
+     * @param settings How the nodes of the group are ticked
+     * @param dependencies The groups that must tick before the new group
+     * @return The identifier of the new group
+     */
+    tick_group_id add_group(const tick_group_settings& settings, std::vector<tick_group_id> dependencies = {});
+
+    /**
+     * Make a group tick after another group
+     * @param group_id The group ticking after
+     * @param dependency The group ticking before
+     * @throw std::logic_error When the dependency would make the groups depend on each other
+     */
+    void add_dependency(tick_group_id group_id, tick_group_id dependency);
+
+    /**
+     * Returns the settings of a group
+     * @param group_id The identifier of the group
+     * @return The settings of the group, they can be changed between ticks
+     */
+    [[nodiscard]] tick_group_settings& settings(tick_group_id group_id) noexcept;
+    [[nodiscard]] const tick_group_settings& settings(tick_group_id group_id) const noexcept;
+
+    /**
+     * Register a node to a group, its on_tick function is called every time the group ticks
+     * @tparam NodeType The exact type of the node
+     * @param registered_node The node to register, it can only be registered to a single group
+     * @param group_id The group of the node
+     * @throw std::invalid_argument When the node is of a type derived from NodeType
+     * @note Registering while ticking takes effect after the tick
+     */
+    template<typename NodeType>
+    void add(NodeType* registered_node, tick_group_id group_id)
+    {
+        static_assert(std::is_base_of_v<node, NodeType>, "Expecting valid node type");
+
+        // on_tick is called without the virtual table, it would skip the overrides of a derived type
+        if(typeid(*registered_node) != typeid(NodeType))
+        {
+            throw std::invalid_argument{"node registered through a base type"};
+        }
+
+        add(registered_node, group_id, node_pool_index<NodeType>(), &tick_nodes<NodeType>);
+    }
+
+    /**
+     * Stop ticking a node
+     * @param registered_node The node to remove from its group
+     */
+    void remove(const node* registered_node) noexcept;
+
+    /**
+     * Check if a node is registered to a group
+     * @param registered_node The node to check
+     * @return true when the node is registered
+     */
+    [[nodiscard]] bool contains(const node* registered_node) const noexcept;
+
+    /**
+     * Tick every group in the order of their dependencies
+     * @param dt The time elapsed since the last tick
+     * @note Groups with an interval receive the time elapsed since they last ticked
+     */
+    void tick(frame_duration dt);
+
+    /**
+     * Tick every group in the order of their dependencies, splitting thread safe groups across a pool
+     * @param dt The time elapsed since the last tick
+     * @param pool The threads ticking the thread safe groups
+     * @note The nodes of thread safe groups must not throw and must not register or remove nodes while ticking
+     */
+    void tick(frame_duration dt, thread_pool& pool);
+};
+
+}
+
+#endif
@@ -0,0 +1,350 @@
+#ifndef NGINE_GAMEPLAY_TRANSFORM_STORE_HPP
+#define NGINE_GAMEPLAY_TRANSFORM_STORE_HPP
+
+#include <ng/core/transform2d.hpp>
+#include <ng/core/affine2d.hpp>
+#include <ng/core/aabb2d.hpp>
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+
+namespace ng
+{
+
+class node2d;
+class thread_pool;
+
+/**
+ * Stores the transforms of every node2d of a tree in contiguous arrays
+ * Each node2d owns a slot, the same slot is used in every array.
+ * Slots are kept in parent before child order, grouped by depth, so the world transforms of the whole tree can be
+ * computed in a single linear pass where each parent is computed before its children
+ * @note Reparenting a node under a node stored after it, or releasing slots, only flags the order as outdated,
+ *       the arrays are sorted and compacted at the beginning of the next update.
+ *       New slots are appended after their parent, so the depth levels are only rebuilt before a parallel update
+ */
+class transform_store
+{
+public:
+    using slot_type = uint32_t;
+
+    static constexpr slot_type invalid_slot = std::numeric_limits<slot_type>::max();
+
+private:
+    enum slot_flags : uint8_t
+    {
+        // The local transform or the parent changed since the world transform was computed
+        local_changed = 1 << 0,
+
+        // The slot was added after the last capture, there is no previous world transform to interpolate from
+        previous_missing = 1 << 1,
+
+        // The world transform or the local bounds changed since the world bounds were computed
+        bounds_changed = 1 << 2,
+
+        // The bounds of a node of the subtree changed, the subtree bounds are merged again on the next update
+        subtree_bounds_outdated = 1 << 3
+    };
+
+    // Node owning each slot, nullptr when the slot was released
+    std::vector<node2d*> nodes_;
+
+    // Slot of the parent node2d of each slot or invalid_slot when the world transform is the local transform
+    std::vector<slot_type> parents_;
+
+    // Slot of the closest node2d ancestor of each slot, even through nodes without transform, or invalid_slot. Its
+    // subtree bounds include the subtree bounds of the slot, slots are sorted by these ancestors
+    std::vector<slot_type> bounds_parents_;
+
+    // Local components, kept to give back the exact local transform
+    std::vector<glm::vec2> local_translations_;
+    std::vector<float> local_rotations_;
+    std::vector<glm::vec2> local_scales_;
+
+    // Local transforms as affine transforms, built when the local transform is set
+    std::vector<affine2d> local_affines_;
+
+    // World transforms and the world transforms of the last captured tick
+    mutable std::vector<affine2d> worlds_;
+    std::vector<affine2d> previous_worlds_;
+
+    // Incremented every time a world transform changes so children can detect that they are outdated
+    mutable std::vector<uint32_t> world_versions_;
+
+    // Version of the parent world transform used to compute each world transform
+    mutable std::vector<uint32_t> parent_versions_;
+
+    mutable std::vector<uint8_t> flags_;
+
+    // Bounds of each node in its local space, empty when the node has no bounds
+    std::vector<aabb2d> local_bounds_;
+
+    // Local bounds transformed by the world transform
+    std::vector<aabb2d> world_bounds_;
+
+    // World bounds of each node merged with the subtree bounds of its children
+    std::vector<aabb2d> subtree_bounds_;
+
+    // Slots whose world bounds were computed again by the last update, in slot order
+    std::vector<slot_type> changed_bounds_;
+
+    // No world transform before this slot changed since the last update
+    slot_type first_outdated_;
+
+    // No world bounds before this slot changed since the last update, except the bounds of changed world transforms
+    slot_type first_bounds_outdated_;
+
+    // Released slots that are not compacted yet
+    std::size_t released_count_;
+
+    // A slot is stored before its closest node2d ancestor
+    bool order_outdated_;
+
+    // Slots were added or reparented since the depth levels were computed
+    bool levels_outdated_;
+
+    // First slot of each depth level, followed by the number of slots
+    std::vector<std::size_t> level_offsets_;
+
+    /**
+     * Sort the slots by depth and remove released slots
+     */
+    void sort();
+
+    /**
+     * Compute the outdated world transforms of a range of slots
+     * @param begin The first slot to update
+     * @param end The slot after the last slot to update
+     * @note The parents of the slots must be up to date
+     */
+    void update_range(slot_type begin, slot_type end) const noexcept;
+
+    void mark_outdated(slot_type slot) noexcept;
+
+    void mark_bounds_outdated(slot_type slot) noexcept;
+
+    /**
+     * Compute the changed world bounds and merge the subtree bounds of their ancestors again
+     * @param first_changed The first slot whose world transform could have changed
+     * @note Children are merged in their parent from the last slot, so the slots must be sorted
+     */
+    void update_bounds(slot_type first_changed) noexcept;
+
+public:
+    transform_store() noexcept;
+
+    /**
+     * Add a slot for a node
+     * @param n The node owning the slot
+     * @param parent The slot of the parent node2d or invalid_slot
+     * @param bounds_parent The slot of the closest node2d ancestor or invalid_slot, it is the parent when there is one
+     * @return The slot of the node
+     */
+    [[nodiscard]] slot_type add(node2d* n, slot_type parent, slot_type bounds_parent);
+
+    /**
+     * Make sure a number of slots can be added without growing the arrays
+     * @param count The number of slots that will be added
+     * @note The arrays grow at least twice larger, so reserving a few slots at a time doesn't reallocate every time
+     */
+    void reserve(std::size_t count);
+
+    /**
+     * Move every slot of another store in this store
+     * @param other The store giving its slots, it is empty afterward
+     * @note The slots of the smaller store are copied after the slots of the larger one and their node2d are given
+     *       their new slot. World transforms and versions are kept, so the slots are only computed again when they change
+     */
+    void append(transform_store& other);
+
+    /**
+     * Release the slot of a node
+     * @param slot The slot to release
+     */
+    void release(slot_type slot) noexcept;
+
+    /**
+     * Change the parent of a slot
+     * @param slot The slot to reparent
+     * @param parent The slot of the new parent node2d or invalid_slot
+     * @param bounds_parent The slot of the new closest node2d ancestor or invalid_slot, it is the parent when there is one
+     */
+    void set_parent(slot_type slot, slot_type parent, slot_type bounds_parent) noexcept;
+
+    /**
+     * Change the closest node2d ancestor of a slot, after a node without transform above it was moved
+     * @param slot The slot
+     * @param bounds_parent The slot of the new closest node2d ancestor or invalid_slot
+     * @note The world transform is kept, only the subtree bounds of the ancestors change
+     */
+    void set_bounds_parent(slot_type slot, slot_type bounds_parent) noexcept;
+
+    /**
+     * Returns the local transform of a slot
+     * @param slot The slot
+     * @return The local transform of the slot
+     */
+    [[nodiscard]] transform2d local_transform(slot_type slot) const noexcept;
+
+    /**
+     * Set the local transform of a slot
+     * @param slot The slot
+     * @param transform The new local transform
+     * @note The world transforms are not computed until they are read or updated
+     */
+    void set_local_transform(slot_type slot, const transform2d& transform) noexcept;
+
+    /**
+     * Set the local transform of a slot when its affine transform is already known
+     * @param slot The slot
+     * @param transform The new local transform
+     * @param affine The affine transform of the new local transform
+     * @note The world transforms are not computed until they are read or updated
+     */
+    void set_local_transform(slot_type slot, const transform2d& transform, const affine2d& affine) noexcept;
+
+    /**
+     * Set the world transform of a slot, the local transform is computed from the parent world transform
+     * @param slot The slot
+     * @param transform The new world transform
+     */
+    void set_world_transform(slot_type slot, const transform2d& transform) noexcept;
+
+    /**
+     * Returns the local bounds of a slot
+     * @param slot The slot
+     * @return The bounds of the slot in its local space
+     */
+    [[nodiscard]] const aabb2d& local_bounds(slot_type slot) const noexcept;
+
+    /**
+     * Set the local bounds of a slot
+     * @param slot The slot
+     * @param bounds The bounds of the slot in its local space, empty when the node has no extent
+     * @note The world bounds and the subtree bounds are computed by the next update
+     */
+    void set_local_bounds(slot_type slot, const aabb2d& bounds) noexcept;
+
+    /**
+     * Returns the world transform of a slot
+     * @param slot The slot
+     * @return The world transform of the slot
+     * @note Computes the world transform of the slot and its parents when they are outdated,
+     *       therefore it is not safe to read world transforms of the same hierarchy from multiple threads
+     */
+    [[nodiscard]] const affine2d& world(slot_type slot) const noexcept;
+
+    /**
+     * Compute every outdated world transform in a single pass over the slots
+     * @note Starts by sorting and compacting the slots if needed, which can move the slot of every node.
+     *       Then computes the world bounds of the moved slots and the subtree bounds of their ancestors
+     */
+    void update();
+
+    /**
+     * Compute every outdated world transform, one depth level at a time, splitting each level across a thread pool
+     * @param pool The threads computing the world transforms
+     * @note Each slot is computed by a single thread from its parent of the previous level,
+     *       so the results are the same as update()
+     */
+    void update(thread_pool& pool);
+
+    /**
+     * Store the world transforms as the world transforms of the previous tick
+     * @note Should be called once at the start of every tick, after update() and before any node moves
+     */
+    void capture();
+
+    /**
+     * Interpolate the world transform of every slot between the last captured tick and the current world transforms
+     * @param alpha How far the display is between the captured tick and the current world transforms
+     * @param interpolated Receives the interpolated transforms, indexed by slot
+     * @note The rotations are interpolated on the shortest arc and the scales are kept, see ng::interpolate
+     */
+    void interpolate(float alpha, std::vector<affine2d>& interpolated) const;
+
+    /**
+     * Returns the node owning each slot
+     * @return The node owning each slot, nullptr for slots released since the last update
+     */
+    [[nodiscard]] const std::vector<node2d*>& nodes() const noexcept;
+
+    /**
+     * Returns the parent slot of each slot
+     * @return The parent slot of each slot
+     */
+    [[nodiscard]] const std::vector<slot_type>& parents() const noexcept;
+
+    /**
+     * Returns the local translation of each slot
+     * @return The local translation of each slot
+     */
+    [[nodiscard]] const std::vector<glm::vec2>& local_translations() const noexcept;
+
+    /**
+     * Returns the local rotation of each slot
+     * @return The local rotation of each slot
+     */
+    [[nodiscard]] const std::vector<float>& local_rotations() const noexcept;
+
+    /**
+     * Returns the local scale of each slot
+     * @return The local scale of each slot
+     */
+    [[nodiscard]] const std::vector<glm::vec2>& local_scales() const noexcept;
+
+    /**
+     * Returns the world transform of each slot
+     * @return The world transform of each slot, only up to date after update()
+     */
+    [[nodiscard]] const std::vector<affine2d>& worlds() const noexcept;
+
+    /**
+     * Returns the world bounds of each slot
+     * @return The local bounds of each slot transformed by its world transform, only up to date after update()
+     */
+    [[nodiscard]] const std::vector<aabb2d>& world_bounds() const noexcept;
+
+    /**
+     * Returns the bounds of each slot and its descendants
+     * @return The world bounds of each slot merged with the world bounds of its descendants, only up to date after
+     *         update()
+     */
+    [[nodiscard]] const std::vector<aabb2d>& subtree_bounds() const noexcept;
+
+    /**
+     * Returns the world transform of each slot on the last captured tick
+     * @return The world transform of each slot on the last captured tick
+     */
+    [[nodiscard]] const std::vector<affine2d>& previous_worlds() const noexcept;
+
+    /**
+     * Returns the version of the world transform of each slot
+     * @return The version of each world transform, it changes every time the world transform is computed
+     */
+    [[nodiscard]] const std::vector<uint32_t>& world_versions() const noexcept;
+
+    /**
+     * Returns the slots whose world bounds were computed again by the last update
+     * @return The changed slots, in slot order
+     * @note Only the slots whose world transform or local bounds changed are listed, unless the slots were sorted
+     */
+    [[nodiscard]] const std::vector<slot_type>& changed_bounds() const noexcept;
+
+    /**
+     * Returns the first slot of each depth level, followed by the number of slots
+     * @return The offset of each depth level, only up to date after update(thread_pool&)
+     */
+    [[nodiscard]] const std::vector<std::size_t>& level_offsets() const noexcept;
+
+    /**
+     * Returns the number of slots
+     * @return The number of slots, including slots released since the last update
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+};
+
+}
+
+#endif
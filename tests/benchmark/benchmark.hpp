@@ -0,0 +1,71 @@
+#ifndef NGINE_TESTS_BENCHMARK_HPP
+#define NGINE_TESTS_BENCHMARK_HPP
+
+#include <ng/core/time.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string_view>
+
+namespace ng::benchmark
+{
+
+/**
+ * Prevent the compiler from optimizing away a computed value
+ * @param value The value that must be considered as used
+ */
+template<typename T>
+inline void keep(const T& value) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    // An empty assembly block that could read the value and any memory, without costing any instruction
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    // The pointer itself is volatile, so every store to it is kept
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * Repeatedly run a function and report how many items it processes per second
+ * @param label The name displayed with the result
+ * @param items_per_run The number of items a single call of the function processes
+ * @param function The function to measure
+ * @param minimum_duration How long the function must be repeated to get a stable measure
+ * @return The number of items processed per second
+ */
+template<typename Function>
+double measure_throughput(std::string_view label,
+                          std::size_t items_per_run,
+                          Function&& function,
+                          frame_duration minimum_duration = frame_duration{0.25})
+{
+    // Warm caches and branch predictors before measuring
+    function();
+
+    std::size_t run_count = 0;
+    const frame_clock::time_point start = frame_clock::now();
+    frame_duration elapsed{};
+    do
+    {
+        function();
+        ++run_count;
+        elapsed = frame_clock::now() - start;
+    }
+    while(elapsed < minimum_duration);
+
+    const double items = static_cast<double>(items_per_run) * static_cast<double>(run_count);
+    const double items_per_second = items / elapsed.count();
+
+    std::cout << label << ": " << items_per_second << " items/s ("
+              << (elapsed.count() * 1e9) / items << " ns/item, "
+              << (elapsed.count() * 1e3) / static_cast<double>(run_count) << " ms/run)" << std::endl;
+
+    return items_per_second;
+}
+
+}
+
+#endif
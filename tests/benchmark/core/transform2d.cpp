@@ -0,0 +1,81 @@
+#include <catch.hpp>
+#include <benchmark.hpp>
+#include <ng/core/transform2d.hpp>
+
+#include <vector>
+
+namespace
+{
+
+std::vector<glm::vec2> make_points(std::size_t count)
+{
+    std::vector<glm::vec2> points(count);
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        points[i] = glm::vec2{static_cast<float>(i % 1024), static_cast<float>(i / 1024)};
+    }
+
+    return points;
+}
+
+}
+
+TEST_CASE("Throughput of transforming points", "[benchmark][transform2d]")
+{
+    const ng::transform2d transform{glm::vec2{10.f, 13.f}, glm::radians(45.f), glm::vec2{1.2f, 1.5f}};
+
+    // Small enough to stay in cache, so we measure the kernels instead of the memory bandwidth
+    constexpr std::size_t point_count = 4096;
+
+    const std::vector<glm::vec2> points = make_points(point_count);
+    std::vector<glm::vec2> transformed_points(point_count);
+
+    ng::benchmark::measure_throughput("transform_point (one call per point)", point_count, [&]()
+    {
+        for(std::size_t i = 0; i < point_count; ++i)
+        {
+            transformed_points[i] = transform.transform_point(points[i]);
+        }
+        ng::benchmark::keep(transformed_points.front());
+    });
+
+    ng::benchmark::measure_throughput("transform_points (interleaved)", point_count, [&]()
+    {
+        transform.transform_points(points.data(), transformed_points.data(), point_count);
+        ng::benchmark::keep(transformed_points.front());
+    });
+
+    ng::benchmark::measure_throughput("transform_points (interleaved, unaligned)", point_count - 1, [&]()
+    {
+        transform.transform_points(points.data() + 1, transformed_points.data() + 1, point_count - 1);
+        ng::benchmark::keep(transformed_points.front());
+    });
+
+    ng::benchmark::measure_throughput("transform_vectors", point_count, [&]()
+    {
+        transform.transform_vectors(points.data(), transformed_points.data(), point_count);
+        ng::benchmark::keep(transformed_points.front());
+    });
+
+    std::vector<float> xs(point_count);
+    std::vector<float> ys(point_count);
+    for(std::size_t i = 0; i < point_count; ++i)
+    {
+        xs[i] = points[i].x;
+        ys[i] = points[i].y;
+    }
+
+    ng::benchmark::measure_throughput("transform_points (separate coordinates)", point_count, [&]()
+    {
+        transform.transform_points(xs.data(), ys.data(), xs.data(), ys.data(), point_count);
+        ng::benchmark::keep(xs.front());
+    });
+
+    std::vector<ng::transform2d> transforms(point_count, transform);
+
+    ng::benchmark::measure_throughput("transform_points (one transform per point)", point_count, [&]()
+    {
+        ng::transform_points(transforms.data(), points.data(), transformed_points.data(), point_count);
+        ng::benchmark::keep(transformed_points.front());
+    });
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include <catch.hpp>
+#include <benchmark.hpp>
+#include <ng/gameplay/component_store.hpp>
+#include <ng/gameplay/node_tree.hpp>
+#include <ng/core/thread_pool.hpp>
+
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+
+constexpr std::size_t particle_count = 100000;
+constexpr float dt = 1.f / 60.f;
+
+struct position
+{
+    glm::vec2 value;
+};
+
+struct velocity
+{
+    glm::vec2 value;
+};
+
+// The same data stored in the node, updated through the virtual table
+class particle_node : public ng::node
+{
+    glm::vec2 position_;
+    glm::vec2 velocity_;
+
+public:
+    particle_node(ng::node_tree& owner, ng::safe_name name, glm::vec2 velocity)
+    : ng::node{owner, std::move(name)}
+    , position_{0.f, 0.f}
+    , velocity_{velocity}
+    {
+
+    }
+
+    virtual void integrate(float step) noexcept
+    {
+        position_ += velocity_ * step;
+    }
+
+    [[nodiscard]] glm::vec2 current_position() const noexcept
+    {
+        return position_;
+    }
+};
+
+glm::vec2 initial_velocity(std::size_t index) noexcept
+{
+    return glm::vec2{static_cast<float>(index % 7), static_cast<float>(index % 11)};
+}
+
+}
+
+TEST_CASE("Throughput of updating per frame data of nodes", "[benchmark][component_store]")
+{
+    ng::node_tree tree;
+    auto root = tree.make_node<ng::node>(ng::name{"root"});
+    tree.set_root(root);
+
+    std::vector<particle_node*> particles;
+    for(std::size_t i = 0; i < particle_count; ++i)
+    {
+        particles.push_back(tree.make_node<particle_node>(ng::name{"particle" + std::to_string(i)}, initial_velocity(i)));
+        root->attach_child(particles.back());
+    }
+
+    ng::benchmark::measure_throughput("integrate 100k nodes through the virtual table", particle_count, [&]()
+    {
+        for(particle_node* particle : particles)
+        {
+            particle->integrate(dt);
+        }
+
+        ng::benchmark::keep(particles.back()->current_position());
+    });
+
+    ng::component_store& components = tree.components();
+    for(std::size_t i = 0; i < particle_count; ++i)
+    {
+        components.add<position>(particles[i], position{glm::vec2{0.f, 0.f}});
+        components.add<velocity>(particles[i], velocity{initial_velocity(i)});
+    }
+
+    ng::benchmark::measure_throughput("integrate 100k nodes from component chunks", particle_count, [&]()
+    {
+        components.for_each<position, velocity>([](ng::node&, position& p, const velocity& v)
+        {
+            p.value += v.value * dt;
+        });
+
+        ng::benchmark::keep(components.find<position>(particles.back())->value);
+    });
+
+    ng::benchmark::measure_throughput("integrate 100k nodes from component arrays", particle_count, [&]()
+    {
+        components.for_each_chunk<position, velocity>([](const ng::component_archetype& archetype, std::size_t chunk)
+        {
+            position* positions = archetype.chunk_components<position>(chunk);
+            const velocity* velocities = archetype.chunk_components<velocity>(chunk);
+
+            const std::size_t rows = archetype.chunk_rows(chunk);
+            for(std::size_t row = 0; row < rows; ++row)
+            {
+                positions[row].value += velocities[row].value * dt;
+            }
+        });
+
+        ng::benchmark::keep(components.find<position>(particles.back())->value);
+    });
+
+    ng::thread_pool pool;
+    ng::benchmark::measure_throughput("integrate 100k nodes from component chunks on a thread pool", particle_count, [&]()
+    {
+        components.for_each<position, velocity>(pool, [](ng::node&, position& p, const velocity& v)
+        {
+            p.value += v.value * dt;
+        });
+
+        ng::benchmark::keep(components.find<position>(particles.back())->value);
+    });
+}
@@ -0,0 +1,71 @@
+#include <catch.hpp>
+#include <benchmark.hpp>
+#include <ng/gameplay/event_dispatcher.hpp>
+#include <ng/gameplay/node_tree.hpp>
+#include <ng/gameplay/node.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace ng::literals;
+
+namespace
+{
+
+struct tick_event : ng::event
+{
+
+};
+
+}
+
+TEST_CASE("Throughput of broadcasting an event to a tree with few listeners", "[benchmark][event_dispatcher]")
+{
+    constexpr std::size_t fan_out = 1000;
+    constexpr std::size_t listening_interval = 100;
+
+    ng::node_tree tree;
+
+    auto root = tree.make_node<ng::node>("root"_name);
+    tree.set_root(root);
+
+    std::vector<ng::name> names;
+    for(std::size_t i = 0; i < fan_out; ++i)
+    {
+        names.emplace_back(std::to_string(i));
+    }
+
+    // 100k nodes, one percent of them listening
+    std::size_t node_count = 0;
+    std::size_t listener_count = 0;
+    std::size_t received_count = 0;
+    for(std::size_t i = 0; i < 100; ++i)
+    {
+        auto group = tree.make_node<ng::node>(names[i], root);
+        for(std::size_t j = 0; j < fan_out; ++j)
+        {
+            auto child = tree.make_node<ng::node>(names[j], group);
+            if(node_count++ % listening_interval == 0)
+            {
+                tree.events().listen<tick_event>(child, [&received_count](tick_event&)
+                {
+                    ++received_count;
+                });
+                ++listener_count;
+            }
+        }
+    }
+
+    tick_event e;
+    ng::benchmark::measure_throughput("broadcast to listeners", listener_count, [&]()
+    {
+        tree.events().broadcast(e, root);
+    });
+
+    ng::benchmark::measure_throughput("broadcast per node", node_count, [&]()
+    {
+        tree.events().broadcast(e, root);
+    });
+
+    ng::benchmark::keep(received_count);
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include <catch.hpp>
+#include <benchmark.hpp>
+#include <ng/gameplay/node2d.hpp>
+#include <ng/gameplay/node_command_buffer.hpp>
+#include <ng/gameplay/node_tree.hpp>
+#include <ng/core/thread_pool.hpp>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// 64 squads of 256 soldiers, every frame each squad replaces its burst of 16 projectiles and hands its soldiers to the next squad
+constexpr std::size_t squad_count = 64;
+constexpr std::size_t soldiers_per_squad = 256;
+constexpr std::size_t projectiles_per_burst = 16;
+constexpr std::size_t squads_per_task = 4;
+
+constexpr std::size_t changes_per_frame = squad_count * (2 + projectiles_per_burst + soldiers_per_squad);
+
+glm::vec2 position(std::size_t index) noexcept
+{
+    return glm::vec2{static_cast<float>(index % 16), static_cast<float>(index / 16)};
+}
+
+struct battle
+{
+    ng::node_tree tree;
+    std::vector<ng::node*> squads;
+
+    // Soldiers that were in each squad when the benchmark started
+    std::vector<std::vector<ng::node*>> soldiers;
+
+    std::vector<ng::name> projectile_names;
+    std::size_t frame = 0;
+
+    battle()
+    : soldiers(squad_count)
+    {
+        auto root = tree.make_node<ng::node>(ng::name{"root"});
+        tree.set_root(root);
+
+        for(std::size_t squad = 0; squad < squad_count; ++squad)
+        {
+            squads.push_back(tree.make_node<ng::node2d>(ng::name{"squad" + std::to_string(squad)},
+                                                        ng::transform2d{position(squad) * 64.f}, root));
+            for(std::size_t soldier = 0; soldier < soldiers_per_squad; ++soldier)
+            {
+                const std::size_t index = squad * soldiers_per_squad + soldier;
+                soldiers[squad].push_back(tree.make_node<ng::node2d>(ng::name{"soldier" + std::to_string(index)},
+                                                                     ng::transform2d{position(soldier)}, squads[squad]));
+            }
+        }
+
+        for(std::size_t i = 0; i < projectiles_per_burst; ++i)
+        {
+            projectile_names.emplace_back("projectile" + std::to_string(i));
+        }
+    }
+
+    [[nodiscard]] ng::node* next_squad(std::size_t squad) const noexcept
+    {
+        return squads[(squad + frame + 1) % squad_count];
+    }
+};
+
+}
+
+TEST_CASE("Throughput of structural changes recorded in command buffers", "[benchmark][node_command_buffer]")
+{
+    const ng::name burst_name{"burst"};
+
+    {
+        battle direct;
+
+        ng::benchmark::measure_throughput("change the structure of 64 squads directly", changes_per_frame, [&]()
+        {
+            for(std::size_t squad = 0; squad < squad_count; ++squad)
+            {
+                ng::node* squad_node = direct.squads[squad];
+                if(ng::node* burst = squad_node->find_child(burst_name))
+                {
+                    burst->detach_from_parent();
+                }
+
+                auto burst = direct.tree.make_node<ng::node>(burst_name, squad_node);
+                for(std::size_t i = 0; i < projectiles_per_burst; ++i)
+                {
+                    (void)direct.tree.make_node<ng::node2d>(direct.projectile_names[i], ng::transform2d{position(i)}, burst);
+                }
+
+                for(ng::node* soldier : direct.soldiers[squad])
+                {
+                    soldier->attach_to(direct.next_squad(squad));
+                }
+            }
+
+            ++direct.frame;
+            direct.tree.free_unreachable_nodes();
+        });
+    }
+
+    {
+        battle recorded;
+        ng::thread_pool pool;
+        std::vector<ng::node_command_buffer> buffers(squad_count / squads_per_task);
+
+        ng::benchmark::measure_throughput("change the structure of 64 squads with command buffers", changes_per_frame, [&]()
+        {
+            // The tree is only read while the buffers are recorded
+            pool.parallel_for(squad_count, squads_per_task, [&](std::size_t begin, std::size_t end)
+            {
+                ng::node_command_buffer& buffer = buffers[begin / squads_per_task];
+                for(std::size_t squad = begin; squad < end; ++squad)
+                {
+                    ng::node* squad_node = recorded.squads[squad];
+                    if(ng::node* burst = squad_node->find_child(burst_name))
+                    {
+                        buffer.destroy(burst);
+                    }
+
+                    auto burst = buffer.create<ng::node>(burst_name, squad_node);
+                    for(std::size_t i = 0; i < projectiles_per_burst; ++i)
+                    {
+                        (void)buffer.create<ng::node2d>(recorded.projectile_names[i], ng::transform2d{position(i)}, burst);
+                    }
+
+                    for(ng::node* soldier : recorded.soldiers[squad])
+                    {
+                        buffer.attach(recorded.next_squad(squad), soldier);
+                    }
+                }
+            });
+
+            recorded.tree.apply(buffers);
+
+            ++recorded.frame;
+            recorded.tree.free_unreachable_nodes();
+        });
+
+        REQUIRE(recorded.squads[0]->child_count() == soldiers_per_squad + 1);
+    }
+}
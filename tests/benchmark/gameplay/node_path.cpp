@@ -0,0 +1,61 @@
+#include <catch.hpp>
+#include <benchmark.hpp>
+#include <ng/gameplay/node_path.hpp>
+
+#include <string>
+#include <vector>
+
+TEST_CASE("Throughput of node path operations", "[benchmark][node_path]")
+{
+    // Paths like the ones found in scenes and scripts
+    const std::vector<std::string> path_strings = {
+        "/level/entities/player/camera",
+        "/level/entities/enemies/grunt_12/weapon/muzzle",
+        "/ui/hud/health_bar/fill",
+        "../weapon/muzzle",
+        "./sprite",
+        "/level/terrain/chunks/chunk_4_7/props/tree_203",
+        "/level/entities/enemies/../player/./camera/",
+        "sprite/animation/frames/frame_0012"
+    };
+
+    std::vector<ng::node_path> paths;
+    for(const std::string& path_string : path_strings)
+    {
+        paths.emplace_back(path_string);
+    }
+
+    const ng::node_path relative_path{"weapon/muzzle"};
+
+    ng::benchmark::measure_throughput("node_path parse", path_strings.size(), [&]()
+    {
+        for(const std::string& path_string : path_strings)
+        {
+            ng::benchmark::keep(ng::node_path::parse(path_string));
+        }
+    });
+
+    ng::benchmark::measure_throughput("node_path normalize", paths.size(), [&]()
+    {
+        for(const ng::node_path& path : paths)
+        {
+            ng::benchmark::keep(path.normalize());
+        }
+    });
+
+    ng::benchmark::measure_throughput("node_path append", paths.size(), [&]()
+    {
+        for(const ng::node_path& path : paths)
+        {
+            ng::benchmark::keep(path / relative_path);
+        }
+    });
+
+    ng::benchmark::measure_throughput("node_path string", paths.size(), [&]()
+    {
+        for(const ng::node_path& path : paths)
+        {
+            ng::benchmark::keep(path.string());
+        }
+    });
+}
\ No newline at end of file
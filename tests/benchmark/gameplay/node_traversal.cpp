@@ -0,0 +1,175 @@
+#include <catch.hpp>
+#include <benchmark.hpp>
+#include <ng/gameplay/node2d.hpp>
+#include <ng/gameplay/node_traversal.hpp>
+#include <ng/gameplay/node_tree.hpp>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// 1024 rooms of 1024 props, about a million nodes
+constexpr std::size_t rooms_per_side = 32;
+constexpr std::size_t props_per_side = 32;
+constexpr float prop_spacing = 32.f;
+constexpr float room_size = prop_spacing * props_per_side;
+constexpr std::size_t cameras_per_frame = 64;
+
+}
+
+TEST_CASE("Throughput of culling a large level", "[benchmark][node_traversal]")
+{
+    ng::node_tree tree;
+
+    auto level = tree.make_node<ng::node>(ng::name{"level"});
+    std::vector<ng::node2d*> rooms;
+
+    const ng::aabb2d prop_bounds = ng::aabb2d::from_center(glm::vec2{0.f, 0.f}, glm::vec2{12.f, 12.f});
+    std::size_t node_count = 0;
+
+    for(std::size_t room_y = 0; room_y < rooms_per_side; ++room_y)
+    {
+        for(std::size_t room_x = 0; room_x < rooms_per_side; ++room_x)
+        {
+            const glm::vec2 room_origin{static_cast<float>(room_x) * room_size, static_cast<float>(room_y) * room_size};
+            auto room = tree.make_node<ng::node2d>(ng::name{"room" + std::to_string(rooms.size())},
+                                                   ng::transform2d{room_origin}, level);
+            rooms.push_back(room);
+
+            for(std::size_t prop_y = 0; prop_y < props_per_side; ++prop_y)
+            {
+                for(std::size_t prop_x = 0; prop_x < props_per_side; ++prop_x)
+                {
+                    const glm::vec2 prop_origin{static_cast<float>(prop_x) * prop_spacing,
+                                                static_cast<float>(prop_y) * prop_spacing};
+
+                    auto prop = tree.make_node<ng::node2d>(ng::name{std::to_string(node_count++)},
+                                                           ng::transform2d{prop_origin}, room);
+                    prop->set_local_bounds(prop_bounds);
+                }
+            }
+        }
+    }
+
+    tree.set_root(level);
+    tree.update_world_transforms();
+
+    // Cameras of 1920x1080 spread across the level
+    std::vector<ng::aabb2d> cameras;
+    for(std::size_t i = 0; i < cameras_per_frame; ++i)
+    {
+        const float x = static_cast<float>((i * 7) % rooms_per_side) * room_size;
+        const float y = static_cast<float>((i * 13) % rooms_per_side) * room_size;
+
+        cameras.push_back(ng::aabb2d{glm::vec2{x, y}, glm::vec2{x + 1920.f, y + 1080.f}});
+    }
+
+    std::vector<ng::node*> pending;
+    std::vector<ng::node2d*> found;
+
+    ng::benchmark::measure_throughput("cull 1M nodes against 64 cameras, checking every node", cameras_per_frame, [&]()
+    {
+        const ng::transform_store& transforms = tree.transforms();
+
+        found.clear();
+        for(const ng::aabb2d& camera : cameras)
+        {
+            for(ng::node& n : ng::pre_order(level))
+            {
+                if(n.primary_node_type() != ng::primary_node_types::node2d)
+                {
+                    continue;
+                }
+
+                auto n2d = static_cast<ng::node2d*>(&n);
+                const ng::aabb2d& bounds = transforms.world_bounds()[n2d->transform_slot()];
+                if(!bounds.empty() && bounds.intersects(camera))
+                {
+                    found.push_back(n2d);
+                }
+            }
+        }
+
+        ng::benchmark::keep(found.size());
+    });
+
+    ng::benchmark::measure_throughput("cull 1M nodes against 64 cameras, pruning subtrees", cameras_per_frame, [&]()
+    {
+        found.clear();
+        for(const ng::aabb2d& camera : cameras)
+        {
+            ng::cull(level, camera, pending, found);
+        }
+
+        ng::benchmark::keep(found.size());
+    });
+
+    // Only the moved rooms and their ancestors aggregate their bounds again
+    std::size_t moved_room = 0;
+    ng::benchmark::measure_throughput("move 16 rooms and update the bounds", 16, [&]()
+    {
+        for(std::size_t i = 0; i < 16; ++i)
+        {
+            ng::node2d* room = rooms[moved_room++ % rooms.size()];
+            room->set_local_transform(ng::transform2d{room->local_transform().translation + glm::vec2{1.f, 0.f}});
+        }
+
+        tree.update_world_transforms();
+        ng::benchmark::keep(level->first_child());
+    });
+}
+
+TEST_CASE("Throughput of visiting the nodes of a type", "[benchmark][node_traversal]")
+{
+    // 256 groups mixing 512 node2d and 512 plain nodes
+    constexpr std::size_t group_count = 256;
+    constexpr std::size_t nodes_per_group = 1024;
+    constexpr std::size_t node_count = group_count * nodes_per_group;
+
+    ng::node_tree tree;
+    auto level = tree.make_node<ng::node>(ng::name{"level"});
+    tree.set_root(level);
+
+    for(std::size_t group = 0; group < group_count; ++group)
+    {
+        auto group_node = tree.make_node<ng::node>(ng::name{"group" + std::to_string(group)}, level);
+        for(std::size_t i = 0; i < nodes_per_group; ++i)
+        {
+            if(i % 2 == 0)
+            {
+                (void)tree.make_node<ng::node2d>(ng::name{std::to_string(i)}, group_node);
+            }
+            else
+            {
+                (void)tree.make_node<ng::node>(ng::name{std::to_string(i)}, group_node);
+            }
+        }
+    }
+
+    ng::benchmark::measure_throughput("visit the node2d of 256k nodes with a dynamic cast", node_count, [&]()
+    {
+        std::size_t visited = 0;
+        for(ng::node& n : ng::pre_order(level))
+        {
+            if(auto n2d = dynamic_cast<ng::node2d*>(&n))
+            {
+                visited += n2d->transform_slot() & 1;
+            }
+        }
+
+        ng::benchmark::keep(visited);
+    });
+
+    ng::benchmark::measure_throughput("visit the node2d of 256k nodes with their type bits", node_count, [&]()
+    {
+        std::size_t visited = 0;
+        for(ng::node2d& n2d : ng::pre_order_of<ng::node2d>(level))
+        {
+            visited += n2d.transform_slot() & 1;
+        }
+
+        ng::benchmark::keep(visited);
+    });
+}
@@ -0,0 +1,155 @@
+#include <catch.hpp>
+#include <benchmark.hpp>
+#include <ng/gameplay/node.hpp>
+#include <ng/gameplay/node_tree.hpp>
+#include <ng/gameplay/node_path.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace ng::literals;
+
+TEST_CASE("Throughput of iterating a wide node tree", "[benchmark][node_tree]")
+{
+    constexpr std::size_t fan_out = 1000;
+
+    // Children of different parents share the same names
+    std::vector<ng::name> names;
+    names.reserve(fan_out);
+    for(std::size_t i = 0; i < fan_out; ++i)
+    {
+        names.emplace_back(std::to_string(i));
+    }
+
+    ng::node_tree tree;
+
+    auto root = tree.make_node<ng::node>("root"_name);
+    for(std::size_t i = 0; i < fan_out; ++i)
+    {
+        auto child = tree.make_node<ng::node>(names[i], root);
+
+        for(std::size_t j = 0; j < fan_out; ++j)
+        {
+            (void)tree.make_node<ng::node>(names[j], child);
+        }
+    }
+
+    tree.set_root(root);
+
+    const std::size_t node_count = 1 + fan_out + fan_out * fan_out;
+
+    ng::benchmark::measure_throughput("node_tree iterator", node_count, [&]()
+    {
+        std::size_t visited = 0;
+        for(const ng::node& n : tree)
+        {
+            ++visited;
+            ng::benchmark::keep(n);
+        }
+
+        ng::benchmark::keep(visited);
+    });
+
+    ng::benchmark::measure_throughput("next_sibling", node_count - 1, [&]()
+    {
+        std::size_t visited = 0;
+        for(ng::node* child = root->first_child(); child; child = child->next_sibling())
+        {
+            for(ng::node* grand_child = child->first_child(); grand_child; grand_child = grand_child->next_sibling())
+            {
+                ++visited;
+            }
+
+            ++visited;
+        }
+
+        ng::benchmark::keep(visited);
+    });
+}
+
+
+TEST_CASE("Throughput of attaching many children to a node", "[benchmark][node_tree]")
+{
+    constexpr std::size_t child_count = 100000;
+
+    std::vector<ng::name> names;
+    names.reserve(child_count);
+    for(std::size_t i = 0; i < child_count; ++i)
+    {
+        names.emplace_back(std::to_string(i));
+    }
+
+    ng::node_tree tree;
+
+    auto parent = tree.make_node<ng::node>("parent"_name);
+
+    std::vector<ng::node*> children;
+    children.reserve(child_count);
+    for(std::size_t i = 0; i < child_count; ++i)
+    {
+        children.push_back(tree.make_node<ng::node>(names[i]));
+    }
+
+    ng::benchmark::measure_throughput("attach_child", child_count, [&]()
+    {
+        for(ng::node* child : children)
+        {
+            parent->attach_child(child);
+        }
+
+        for(ng::node* child : children)
+        {
+            parent->detach_child(child);
+        }
+    });
+
+    for(ng::node* child : children)
+    {
+        parent->attach_child(child);
+    }
+
+    ng::benchmark::measure_throughput("find_child", child_count, [&]()
+    {
+        for(const ng::name& name : names)
+        {
+            ng::benchmark::keep(parent->find_child(name));
+        }
+    });
+}
+
+TEST_CASE("Throughput of finding nodes by path", "[benchmark][node_tree]")
+{
+    constexpr std::size_t fan_out = 1000;
+    constexpr std::size_t depth = 4;
+
+    ng::node_tree tree;
+
+    auto root = tree.make_node<ng::node>("root"_name);
+    tree.set_root(root);
+
+    // Each level is a wide container, the path goes through the last child of each level
+    std::string path_string;
+    ng::node* parent = root;
+    for(std::size_t level = 0; level < depth; ++level)
+    {
+        ng::node* last_child = nullptr;
+        for(std::size_t i = 0; i < fan_out; ++i)
+        {
+            last_child = tree.make_node<ng::node>(ng::name{std::to_string(i)}, parent);
+        }
+
+        path_string += "/" + std::to_string(fan_out - 1);
+        parent = last_child;
+    }
+
+    const ng::node_path path{path_string};
+    constexpr std::size_t lookup_count = 100000;
+
+    ng::benchmark::measure_throughput("node_tree find", lookup_count, [&]()
+    {
+        for(std::size_t i = 0; i < lookup_count; ++i)
+        {
+            ng::benchmark::keep(tree.find(path));
+        }
+    });
+}
\ No newline at end of file
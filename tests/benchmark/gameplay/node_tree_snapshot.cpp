@@ -0,0 +1,101 @@
+#include <catch.hpp>
+#include <benchmark.hpp>
+#include <ng/gameplay/node_tree_snapshot.hpp>
+#include <ng/gameplay/node_tree.hpp>
+#include <ng/gameplay/node2d.hpp>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// 100 groups of 1000 node2d
+constexpr std::size_t group_count = 100;
+constexpr std::size_t nodes_per_group = 1000;
+constexpr std::size_t node_count = group_count * nodes_per_group;
+
+}
+
+TEST_CASE("Throughput of taking and restoring snapshots of a node tree", "[benchmark][node_tree_snapshot]")
+{
+    ng::node_tree tree;
+    auto level = tree.make_node<ng::node2d>(ng::name{"level"});
+    tree.set_root(level);
+
+    std::vector<ng::node2d*> groups;
+    std::vector<ng::node2d*> nodes;
+    for(std::size_t group = 0; group < group_count; ++group)
+    {
+        groups.push_back(tree.make_node<ng::node2d>(ng::name{"group" + std::to_string(group)}, level));
+        for(std::size_t i = 0; i < nodes_per_group; ++i)
+        {
+            const glm::vec2 position{static_cast<float>(group), static_cast<float>(i)};
+            nodes.push_back(tree.make_node<ng::node2d>(ng::name{std::to_string(i)}, ng::transform2d{position}, groups.back()));
+        }
+    }
+
+    tree.update_world_transforms();
+
+    ng::node_tree_snapshot before;
+    tree.snapshot(before);
+
+    ng::benchmark::measure_throughput("snapshot 100k nodes with an unchanged structure", node_count, [&]()
+    {
+        tree.snapshot(before);
+
+        ng::benchmark::keep(before.size());
+    });
+
+    ng::node_tree_snapshot after;
+    ng::benchmark::measure_throughput("snapshot 100k nodes after a structure change", node_count, [&]()
+    {
+        nodes.front()->detach_from_parent();
+        nodes.front()->attach_to(groups.front());
+
+        tree.snapshot(after);
+
+        ng::benchmark::keep(after.size());
+    });
+
+    // One node in a hundred is renamed and moved to another group
+    for(std::size_t i = 0; i < node_count; i += 100)
+    {
+        nodes[i]->rename(ng::name{"moved" + std::to_string(i)});
+        nodes[i]->attach_to(groups[(i / nodes_per_group + 1) % group_count]);
+    }
+
+    tree.snapshot(after);
+
+    ng::benchmark::measure_throughput("restore 100k nodes, one in a hundred moved", node_count * 2, [&]()
+    {
+        tree.restore(before);
+        tree.restore(after);
+
+        ng::benchmark::keep(nodes.back()->parent());
+    });
+
+    // Every node is moved without changing the structure
+    tree.restore(before);
+    for(std::size_t i = 0; i < node_count; ++i)
+    {
+        nodes[i]->set_local_transform(ng::transform2d{glm::vec2{static_cast<float>(i), 0.f}});
+    }
+
+    tree.snapshot(after);
+
+    ng::benchmark::measure_throughput("restore 100k nodes, all of them transformed", node_count * 2, [&]()
+    {
+        tree.restore(before);
+        tree.restore(after);
+
+        ng::benchmark::keep(nodes.back()->parent());
+    });
+
+    ng::benchmark::measure_throughput("restore 100k unchanged nodes", node_count, [&]()
+    {
+        tree.restore(after);
+
+        ng::benchmark::keep(nodes.back()->parent());
+    });
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include <catch.hpp>
+#include <benchmark.hpp>
+#include <ng/gameplay/node2d.hpp>
+#include <ng/gameplay/node_tree.hpp>
+#include <ng/gameplay/prefab.hpp>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+
+constexpr std::size_t instances_per_frame = 10000;
+
+// An enemy of 40 nodes: a root, 3 limbs and 12 parts on each limb
+constexpr std::size_t limb_count = 3;
+constexpr std::size_t parts_per_limb = 12;
+constexpr std::size_t nodes_per_enemy = 1 + limb_count * (1 + parts_per_limb);
+
+glm::vec2 part_position(std::size_t index) noexcept
+{
+    return glm::vec2{static_cast<float>(index % 5), static_cast<float>(index / 5)};
+}
+
+}
+
+TEST_CASE("Throughput of spawning prefab instances", "[benchmark][prefab]")
+{
+    std::vector<ng::name> limb_names;
+    std::vector<ng::name> part_names;
+    for(std::size_t i = 0; i < limb_count; ++i)
+    {
+        limb_names.emplace_back("limb" + std::to_string(i));
+    }
+
+    for(std::size_t i = 0; i < parts_per_limb; ++i)
+    {
+        part_names.emplace_back("part" + std::to_string(i));
+    }
+
+    const ng::aabb2d part_bounds = ng::aabb2d::from_center(glm::vec2{0.f, 0.f}, glm::vec2{2.f, 2.f});
+
+    ng::prefab enemy;
+    const auto root = enemy.add<ng::node2d>(ng::name{"enemy"}, ng::transform2d{glm::vec2{0.f, 0.f}});
+    for(std::size_t limb = 0; limb < limb_count; ++limb)
+    {
+        const auto limb_index = enemy.add<ng::node2d>(limb_names[limb], ng::transform2d{part_position(limb)}, root);
+        for(std::size_t part = 0; part < parts_per_limb; ++part)
+        {
+            const auto part_index = enemy.add<ng::node2d>(part_names[part], ng::transform2d{part_position(part)}, limb_index);
+            enemy.set_local_bounds(part_index, part_bounds);
+        }
+    }
+
+    REQUIRE(enemy.size() == nodes_per_enemy);
+
+    ng::node_tree tree;
+
+    // Instances stay detached so the collection frees all of them at the end of every frame, the update compacts the
+    // transform store like every frame of a game does
+    ng::benchmark::measure_throughput("spawn and free 10k enemies of 40 nodes, node by node", instances_per_frame, [&]()
+    {
+        for(std::size_t i = 0; i < instances_per_frame; ++i)
+        {
+            auto enemy_root = tree.make_node<ng::node2d>(ng::name{"enemy"}, ng::transform2d{glm::vec2{0.f, 0.f}});
+            for(std::size_t limb = 0; limb < limb_count; ++limb)
+            {
+                auto limb_node = tree.make_node<ng::node2d>(limb_names[limb]);
+                enemy_root->attach_child(limb_node);
+                limb_node->set_local_transform(ng::transform2d{part_position(limb)});
+
+                for(std::size_t part = 0; part < parts_per_limb; ++part)
+                {
+                    auto part_node = tree.make_node<ng::node2d>(part_names[part]);
+                    limb_node->attach_child(part_node);
+                    part_node->set_local_transform(ng::transform2d{part_position(part)});
+                    part_node->set_local_bounds(part_bounds);
+                }
+            }
+
+            ng::benchmark::keep(enemy_root);
+        }
+
+        tree.free_unreachable_nodes();
+        tree.update_world_transforms();
+    });
+
+    ng::benchmark::measure_throughput("spawn and free 10k enemies of 40 nodes, from a prefab", instances_per_frame, [&]()
+    {
+        for(std::size_t i = 0; i < instances_per_frame; ++i)
+        {
+            ng::benchmark::keep(tree.instantiate(enemy));
+        }
+
+        tree.free_unreachable_nodes();
+        tree.update_world_transforms();
+    });
+}
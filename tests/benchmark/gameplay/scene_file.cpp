@@ -0,0 +1,80 @@
+#include <catch.hpp>
+#include <benchmark.hpp>
+#include <ng/gameplay/node2d.hpp>
+#include <ng/gameplay/node_tree.hpp>
+#include <ng/gameplay/node_type_registry.hpp>
+#include <ng/gameplay/scene_file.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// 256 rooms of 512 props
+constexpr std::size_t room_count = 256;
+constexpr std::size_t props_per_room = 512;
+constexpr std::size_t node_count = 1 + room_count * (1 + props_per_room);
+
+glm::vec2 position(std::size_t index) noexcept
+{
+    return glm::vec2{static_cast<float>(index % 32) * 16.f, static_cast<float>(index / 32) * 16.f};
+}
+
+}
+
+TEST_CASE("Throughput of loading a scene", "[benchmark][scene_file]")
+{
+    const ng::node_type_registry types;
+    const ng::aabb2d prop_bounds = ng::aabb2d::from_center(glm::vec2{0.f, 0.f}, glm::vec2{4.f, 4.f});
+
+    std::vector<ng::name> names;
+    for(std::size_t i = 0; i < props_per_room; ++i)
+    {
+        names.emplace_back("prop" + std::to_string(i));
+    }
+
+    // Rooms and props are created one by one, the way a scene is built from a text format
+    const auto build_level = [&](ng::node_tree& tree)
+    {
+        auto level = tree.make_node<ng::node>(ng::name{"level"});
+        for(std::size_t room = 0; room < room_count; ++room)
+        {
+            auto room_node = tree.make_node<ng::node2d>(ng::name{"room" + std::to_string(room)},
+                                                        ng::transform2d{position(room) * 64.f}, level);
+            for(std::size_t prop = 0; prop < props_per_room; ++prop)
+            {
+                auto prop_node = tree.make_node<ng::node2d>(names[prop], ng::transform2d{position(prop)}, room_node);
+                prop_node->set_local_bounds(prop_bounds);
+            }
+        }
+
+        return level;
+    };
+
+    ng::node_tree tree;
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "ngine_scene_benchmark.ngscene";
+    {
+        std::ofstream file{path, std::ios::binary};
+        ng::write_scene(build_level(tree), types, file);
+    }
+
+    tree.free_unreachable_nodes();
+
+    ng::benchmark::measure_throughput("build and free a level of 130k nodes, node by node", node_count, [&]()
+    {
+        ng::benchmark::keep(build_level(tree));
+        tree.free_unreachable_nodes();
+    });
+
+    ng::benchmark::measure_throughput("load and free a level of 130k nodes from a scene file", node_count, [&]()
+    {
+        ng::benchmark::keep(ng::load_scene(tree, path, types));
+        tree.free_unreachable_nodes();
+    });
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,115 @@
+#include <catch.hpp>
+#include <benchmark.hpp>
+#include <ng/gameplay/node2d.hpp>
+#include <ng/gameplay/node_tree.hpp>
+#include <ng/gameplay/node_type_registry.hpp>
+#include <ng/gameplay/scene_file.hpp>
+#include <ng/gameplay/scene_loader.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace
+{
+
+// 256 rooms of 512 props
+constexpr std::size_t room_count = 256;
+constexpr std::size_t props_per_room = 512;
+
+glm::vec2 position(std::size_t index) noexcept
+{
+    return glm::vec2{static_cast<float>(index % 32) * 16.f, static_cast<float>(index / 32) * 16.f};
+}
+
+double milliseconds(ng::frame_duration duration) noexcept
+{
+    return duration.count() * 1e3;
+}
+
+}
+
+TEST_CASE("Frame time while a scene is loading", "[benchmark][scene_loader]")
+{
+    const ng::node_type_registry types;
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "ngine_scene_loader_benchmark.ngscene";
+
+    {
+        ng::node_tree source_tree;
+        auto level = source_tree.make_node<ng::node>(ng::name{"level"});
+        for(std::size_t room = 0; room < room_count; ++room)
+        {
+            auto room_node = source_tree.make_node<ng::node2d>(ng::name{"room" + std::to_string(room)},
+                                                               ng::transform2d{position(room) * 64.f}, level);
+            for(std::size_t prop = 0; prop < props_per_room; ++prop)
+            {
+                auto prop_node = source_tree.make_node<ng::node2d>(ng::name{"prop" + std::to_string(prop)},
+                                                                   ng::transform2d{position(prop)}, room_node);
+                prop_node->set_local_bounds(ng::aabb2d::from_center(glm::vec2{0.f, 0.f}, glm::vec2{4.f, 4.f}));
+            }
+        }
+
+        std::ofstream file{path, std::ios::binary};
+        ng::write_scene(level, types, file);
+    }
+
+    ng::node_tree tree;
+    auto root = tree.make_node<ng::node>(ng::name{"root"});
+    tree.set_root(root);
+
+    // The whole level is created during a single frame
+    {
+        const ng::frame_clock::time_point frame_start = ng::frame_clock::now();
+        ng::node* level = ng::load_scene(tree, path, types, root);
+        tree.update_world_transforms();
+        const ng::frame_duration frame = ng::frame_clock::now() - frame_start;
+
+        std::cout << "frame loading a level of 130k nodes on the main thread: " << milliseconds(frame) << " ms" << std::endl;
+
+        level->detach_from_parent();
+        tree.free_unreachable_nodes();
+    }
+
+    // Frames keep running while the level is created in the background, then a single frame commits it
+    {
+        ng::scene_loader loader{path, types};
+
+        ng::frame_duration longest_frame{};
+        ng::frame_duration commit_frame{};
+        std::size_t frame_count = 0;
+
+        for(ng::node* level = nullptr; !level; ++frame_count)
+        {
+            const ng::frame_clock::time_point frame_start = ng::frame_clock::now();
+
+            tree.update_world_transforms();
+            if(loader.finished())
+            {
+                level = loader.commit(tree, root);
+                tree.update_world_transforms();
+            }
+
+            const ng::frame_duration frame = ng::frame_clock::now() - frame_start;
+            longest_frame = std::max(longest_frame, frame);
+            if(level)
+            {
+                commit_frame = frame;
+            }
+
+            // Waiting for the next frame
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+
+        std::cout << "frame committing a level of 130k nodes loaded in the background: " << milliseconds(commit_frame)
+                  << " ms, longest of " << frame_count << " frames: " << milliseconds(longest_frame) << " ms" << std::endl;
+
+        REQUIRE(root->child_count() == 1);
+        ng::benchmark::keep(tree.spatial().size());
+    }
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,130 @@
+#include <catch.hpp>
+#include <benchmark.hpp>
+#include <ng/gameplay/node2d.hpp>
+#include <ng/gameplay/node_tree.hpp>
+#include <ng/gameplay/spatial_index.hpp>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+constexpr std::size_t node_count = 500000;
+constexpr std::size_t queries_per_frame = 10000;
+constexpr float world_size = 8192.f;
+
+/**
+ * Deterministic positions so every run measures the same distribution
+ */
+struct position_generator
+{
+    uint32_t state = 12345;
+
+    float next() noexcept
+    {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<float>(state >> 8) / static_cast<float>(1u << 24) * world_size;
+    }
+};
+
+}
+
+TEST_CASE("Throughput of moving and querying the nodes of the spatial index", "[benchmark][spatial_index]")
+{
+    ng::node_tree tree;
+
+    position_generator positions;
+    std::vector<ng::node2d*> nodes;
+    std::vector<glm::vec2> origins;
+    nodes.reserve(node_count);
+    origins.reserve(node_count);
+
+    for(std::size_t i = 0; i < node_count; ++i)
+    {
+        const glm::vec2 origin{positions.next(), positions.next()};
+
+        auto n = tree.make_node<ng::node2d>(ng::name{std::to_string(i)}, ng::transform2d{origin});
+        n->set_local_bounds(ng::aabb2d::from_center(glm::vec2{0.f, 0.f}, glm::vec2{8.f, 8.f}));
+
+        nodes.push_back(n);
+        origins.push_back(origin);
+    }
+
+    std::vector<glm::vec2> query_points;
+    for(std::size_t i = 0; i < queries_per_frame; ++i)
+    {
+        query_points.emplace_back(positions.next(), positions.next());
+    }
+
+    // Every node circles around its origin, most nodes stay in their cell from one frame to the next
+    float time = 0.f;
+    const auto move_nodes = [&]()
+    {
+        time += 0.1f;
+        for(std::size_t i = 0; i < node_count; ++i)
+        {
+            const float phase = time + static_cast<float>(i % 64);
+            const glm::vec2 offset{std::cos(phase) * 24.f, std::sin(phase) * 24.f};
+
+            nodes[i]->set_local_transform(ng::transform2d{origins[i] + offset});
+        }
+
+        tree.update_world_transforms();
+    };
+
+    std::vector<ng::node2d*> found;
+
+    ng::benchmark::measure_throughput("move 500k nodes and refresh the index", node_count, [&]()
+    {
+        move_nodes();
+        ng::benchmark::keep(tree.spatial().size());
+    });
+
+    ng::benchmark::measure_throughput("10k region queries", queries_per_frame, [&]()
+    {
+        found.clear();
+        for(const glm::vec2& point : query_points)
+        {
+            tree.spatial().query(ng::aabb2d::from_center(point, glm::vec2{32.f, 32.f}), found);
+        }
+
+        ng::benchmark::keep(found.size());
+    });
+
+    ng::benchmark::measure_throughput("10k radius queries", queries_per_frame, [&]()
+    {
+        found.clear();
+        for(const glm::vec2& point : query_points)
+        {
+            tree.spatial().query(point, 32.f, found);
+        }
+
+        ng::benchmark::keep(found.size());
+    });
+
+    ng::benchmark::measure_throughput("10k queries of the 8 nearest nodes", queries_per_frame, [&]()
+    {
+        found.clear();
+        for(const glm::vec2& point : query_points)
+        {
+            tree.spatial().nearest(point, 8, found);
+        }
+
+        ng::benchmark::keep(found.size());
+    });
+
+    ng::benchmark::measure_throughput("frame of 500k moving nodes and 10k region queries", node_count, [&]()
+    {
+        move_nodes();
+
+        found.clear();
+        for(const glm::vec2& point : query_points)
+        {
+            tree.spatial().query(ng::aabb2d::from_center(point, glm::vec2{32.f, 32.f}), found);
+        }
+
+        ng::benchmark::keep(found.size());
+    });
+}
\ No newline at end of file
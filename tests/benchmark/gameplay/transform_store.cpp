@@ -0,0 +1,130 @@
+#include <catch.hpp>
+#include <benchmark.hpp>
+#include <ng/core/thread_pool.hpp>
+#include <ng/gameplay/node2d.hpp>
+#include <ng/gameplay/node_tree.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+constexpr std::size_t node_count = 1 << 18;
+
+ng::node2d* make_node(ng::node_tree& tree, std::size_t index, ng::node2d* parent)
+{
+    const ng::transform2d transform{glm::vec2{static_cast<float>(index % 17), 1.f},
+                                    glm::radians(static_cast<float>(index % 31))};
+
+    return tree.make_node<ng::node2d>(ng::name{std::to_string(index)}, transform, parent);
+}
+
+// Every node has four children
+ng::node2d* make_balanced_tree(ng::node_tree& tree)
+{
+    std::vector<ng::node2d*> nodes{make_node(tree, 0, nullptr)};
+    nodes.reserve(node_count);
+
+    for(std::size_t i = 1; i < node_count; ++i)
+    {
+        nodes.push_back(make_node(tree, i, nodes[(i - 1) / 4]));
+    }
+
+    return nodes.front();
+}
+
+// A few long chains of nodes
+ng::node2d* make_deep_tree(ng::node_tree& tree)
+{
+    constexpr std::size_t chain_count = 64;
+
+    ng::node2d* root = make_node(tree, 0, nullptr);
+    std::vector<ng::node2d*> chains(chain_count, root);
+
+    for(std::size_t i = 1; i < node_count; ++i)
+    {
+        ng::node2d*& chain = chains[i % chain_count];
+        chain = make_node(tree, i, chain);
+    }
+
+    return root;
+}
+
+// Two levels of nodes with many children
+ng::node2d* make_wide_tree(ng::node_tree& tree)
+{
+    constexpr std::size_t children_per_node = 512;
+
+    ng::node2d* root = make_node(tree, 0, nullptr);
+    std::vector<ng::node2d*> first_level;
+
+    for(std::size_t i = 1; i < node_count; ++i)
+    {
+        if(first_level.size() < children_per_node)
+        {
+            first_level.push_back(make_node(tree, i, root));
+        }
+        else
+        {
+            make_node(tree, i, first_level[i % children_per_node]);
+        }
+    }
+
+    return root;
+}
+
+template<typename MakeTree>
+void measure_update(std::string_view shape, MakeTree&& make_tree)
+{
+    ng::node_tree tree;
+    ng::node2d* root = make_tree(tree);
+    tree.set_root(root);
+
+    float rotation = 0.f;
+    const auto move_root = [&]()
+    {
+        rotation += 0.01f;
+        root->set_local_transform(ng::transform2d{glm::vec2{0.f, 0.f}, rotation});
+    };
+
+    const std::string label{shape};
+
+    ng::benchmark::measure_throughput(label + ", 1 thread", node_count, [&]()
+    {
+        move_root();
+        tree.update_world_transforms();
+        ng::benchmark::keep(tree.transforms().worlds().back());
+    });
+
+    std::vector<std::size_t> thread_counts{2, 4, ng::thread_pool::default_worker_count() + 1};
+    std::sort(thread_counts.begin(), thread_counts.end());
+    thread_counts.erase(std::unique(thread_counts.begin(), thread_counts.end()), thread_counts.end());
+
+    for(const std::size_t thread_count : thread_counts)
+    {
+        if(thread_count < 2)
+        {
+            continue;
+        }
+
+        ng::thread_pool pool{thread_count - 1};
+
+        ng::benchmark::measure_throughput(label + ", " + std::to_string(thread_count) + " threads", node_count, [&]()
+        {
+            move_root();
+            tree.update_world_transforms(pool);
+            ng::benchmark::keep(tree.transforms().worlds().back());
+        });
+    }
+}
+
+}
+
+TEST_CASE("Throughput of updating the world transforms of a node tree", "[benchmark][transform_store]")
+{
+    measure_update("balanced tree", make_balanced_tree);
+    measure_update("deep tree", make_deep_tree);
+    measure_update("wide tree", make_wide_tree);
+}
@@ -0,0 +1,59 @@
+#include <catch.hpp>
+#include <ng/core/aabb2d.hpp>
+#include <ng/core/affine2d.hpp>
+#include <ng/core/transform2d.hpp>
+
+TEST_CASE("Axis aligned boxes can be tested against points and other boxes", "[aabb2d]")
+{
+    const ng::aabb2d box{glm::vec2{-1.f, -2.f}, glm::vec2{3.f, 2.f}};
+
+    REQUIRE_FALSE(box.empty());
+    REQUIRE(ng::aabb2d{}.empty());
+    REQUIRE(box.center() == glm::vec2{1.f, 0.f});
+    REQUIRE(box.size() == glm::vec2{4.f, 4.f});
+
+    REQUIRE(box.contains(glm::vec2{0.f, 0.f}));
+    REQUIRE(box.contains(glm::vec2{3.f, 2.f}));
+    REQUIRE_FALSE(box.contains(glm::vec2{3.5f, 0.f}));
+
+    REQUIRE(box.contains(ng::aabb2d{glm::vec2{0.f, 0.f}, glm::vec2{1.f, 1.f}}));
+    REQUIRE_FALSE(box.contains(ng::aabb2d{glm::vec2{0.f, 0.f}, glm::vec2{4.f, 1.f}}));
+
+    REQUIRE(box.intersects(ng::aabb2d{glm::vec2{2.f, 1.f}, glm::vec2{5.f, 5.f}}));
+    REQUIRE_FALSE(box.intersects(ng::aabb2d{glm::vec2{4.f, 1.f}, glm::vec2{5.f, 5.f}}));
+
+    REQUIRE(box.distance_squared(glm::vec2{0.f, 0.f}) == 0.f);
+    REQUIRE(box.distance_squared(glm::vec2{6.f, 6.f}) == Approx(25.f));
+
+    SECTION("merging an empty box gives back the other box")
+    {
+        const ng::aabb2d merged = ng::aabb2d{}.merge(box);
+
+        REQUIRE(merged.min == box.min);
+        REQUIRE(merged.max == box.max);
+    }
+
+    SECTION("merging two boxes contains both boxes")
+    {
+        const ng::aabb2d other{glm::vec2{5.f, -4.f}, glm::vec2{6.f, 0.f}};
+        const ng::aabb2d merged = box.merge(other);
+
+        REQUIRE(merged.min == glm::vec2{-1.f, -4.f});
+        REQUIRE(merged.max == glm::vec2{6.f, 2.f});
+    }
+}
+
+TEST_CASE("A transformed box contains the transformed corners of the box", "[aabb2d]")
+{
+    const ng::aabb2d box = ng::aabb2d::from_center(glm::vec2{0.f, 0.f}, glm::vec2{1.f, 1.f});
+    const ng::affine2d transform{ng::transform2d{glm::vec2{10.f, 5.f}, glm::radians(45.f), glm::vec2{2.f, 2.f}}};
+
+    const ng::aabb2d transformed = box.transform(transform);
+
+    REQUIRE(transformed.center().x == Approx(10.f));
+    REQUIRE(transformed.center().y == Approx(5.f));
+
+    // The diagonal of a square of size 4 rotated by 45 degrees is aligned with the axes
+    REQUIRE(transformed.size().x == Approx(4.f * std::sqrt(2.f)));
+    REQUIRE(transformed.size().y == Approx(4.f * std::sqrt(2.f)));
+}
\ No newline at end of file
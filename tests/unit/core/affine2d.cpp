@@ -0,0 +1,100 @@
+#include <catch.hpp>
+#include <ng/core/affine2d.hpp>
+#include <ng/core/transform2d.hpp>
+
+TEST_CASE("An affine transform behaves like the matrix of a transform", "[affine2d]")
+{
+    const ng::transform2d first{glm::vec2{10.f, -5.f}, glm::radians(30.f), glm::vec2{2.f, 0.5f}};
+    const ng::transform2d second{glm::vec2{-3.f, 7.f}, glm::radians(-60.f), glm::vec2{1.5f, 1.5f}};
+
+    const ng::affine2d first_affine{first};
+    const ng::affine2d second_affine{second};
+
+    const glm::vec2 point{4.f, 3.f};
+
+    SECTION("an affine transform has the same matrix as its transform")
+    {
+        const glm::mat3 expected = first.matrix();
+        const glm::mat3 matrix = first_affine.matrix();
+
+        for(int column = 0; column < 3; ++column)
+        {
+            for(int row = 0; row < 3; ++row)
+            {
+                REQUIRE(matrix[column][row] == Approx(expected[column][row]).margin(0.0001f));
+            }
+        }
+    }
+
+    SECTION("combining affine transforms is the same as multiplying their matrices")
+    {
+        const glm::vec2 expected = first.matrix() * second.matrix() * glm::vec3{point.x, point.y, 1.f};
+        const glm::vec2 transformed = (first_affine * second_affine).transform_point(point);
+
+        REQUIRE(transformed.x == Approx(expected.x));
+        REQUIRE(transformed.y == Approx(expected.y));
+    }
+
+    SECTION("the inverse of an affine transform cancels it")
+    {
+        const glm::vec2 transformed = first_affine.inverse().transform_point(first_affine.transform_point(point));
+
+        REQUIRE(transformed.x == Approx(point.x));
+        REQUIRE(transformed.y == Approx(point.y));
+    }
+
+    SECTION("vectors are not translated")
+    {
+        const glm::vec2 expected = first.transform_vector(point);
+        const glm::vec2 transformed = first_affine.transform_vector(point);
+
+        REQUIRE(transformed.x == Approx(expected.x));
+        REQUIRE(transformed.y == Approx(expected.y));
+    }
+}
+
+TEST_CASE("Affine transforms can be interpolated", "[affine2d]")
+{
+    const auto require_similar = [](const ng::affine2d& transform, const ng::affine2d& expected)
+    {
+        REQUIRE(transform.m00 == Approx(expected.m00).margin(0.0001f));
+        REQUIRE(transform.m01 == Approx(expected.m01).margin(0.0001f));
+        REQUIRE(transform.m10 == Approx(expected.m10).margin(0.0001f));
+        REQUIRE(transform.m11 == Approx(expected.m11).margin(0.0001f));
+        REQUIRE(transform.tx == Approx(expected.tx).margin(0.0001f));
+        REQUIRE(transform.ty == Approx(expected.ty).margin(0.0001f));
+    };
+
+    const ng::affine2d from{ng::transform2d{glm::vec2{0.f, 0.f}, glm::radians(10.f), glm::vec2{2.f, 2.f}}};
+    const ng::affine2d to{ng::transform2d{glm::vec2{10.f, -4.f}, glm::radians(170.f), glm::vec2{2.f, 2.f}}};
+
+    ng::affine2d interpolated;
+
+    SECTION("the rotation is interpolated without changing the scale")
+    {
+        ng::interpolate(&from, &to, &interpolated, 1, 0.5f);
+
+        require_similar(interpolated, ng::affine2d{ng::transform2d{glm::vec2{5.f, -2.f}, glm::radians(90.f), glm::vec2{2.f, 2.f}}});
+    }
+
+    SECTION("the rotation is interpolated on the shortest arc")
+    {
+        const ng::affine2d almost_full_turn{ng::transform2d{glm::vec2{0.f, 0.f}, glm::radians(350.f)}};
+        const ng::affine2d small_turn{ng::transform2d{glm::vec2{0.f, 0.f}, glm::radians(30.f)}};
+
+        ng::interpolate(&almost_full_turn, &small_turn, &interpolated, 1, 0.5f);
+
+        require_similar(interpolated, ng::affine2d{ng::transform2d{glm::vec2{0.f, 0.f}, glm::radians(10.f)}});
+    }
+
+    SECTION("sheared and mirrored transforms are given back at both ends")
+    {
+        const ng::affine2d sheared = from * ng::affine2d{ng::transform2d{glm::vec2{1.f, 2.f}, glm::radians(45.f), glm::vec2{3.f, -0.5f}}};
+
+        ng::interpolate(&sheared, &to, &interpolated, 1, 0.f);
+        require_similar(interpolated, sheared);
+
+        ng::interpolate(&to, &sheared, &interpolated, 1, 1.f);
+        require_similar(interpolated, sheared);
+    }
+}
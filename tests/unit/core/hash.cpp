@@ -31,4 +31,10 @@ TEST_CASE("The hash function should yield the same result everytime the same val
     const uint64_t second_hash_value = ng::hash("hello world");
 
     REQUIRE(first_hash_value == second_hash_value);
+}
+
+TEST_CASE("A hash can be extended with the rest of a value", "[hash]")
+{
+    REQUIRE(ng::hash(ng::hash("hello "), "world") == "hello world"_h);
+    REQUIRE(ng::hash(ng::hash_offset_basis, "hello world") == "hello world"_h);
 }
\ No newline at end of file
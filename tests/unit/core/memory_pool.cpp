@@ -1,6 +1,8 @@
 #include <catch.hpp>
 #include <ng/core/memory_pool.hpp>
 
+#include <vector>
+
 struct mock_fat_type
 {
     std::aligned_storage<32, alignof(std::max_align_t)>::type storage;
@@ -44,4 +46,47 @@ TEST_CASE("A memory pool will allocate correctly aligned objects", "[memory_pool
 
         pool.free(allocated_memory);
     }
-}
\ No newline at end of file
+}
+TEST_CASE("A growing memory pool allocates more memory when it is full", "[memory_pool]")
+{
+    ng::type_memory_pool<mock_fat_type> pool{4};
+
+    std::vector<void*> allocated_memory;
+    for(int i = 0; i < 100; ++i)
+    {
+        allocated_memory.push_back(pool.allocate());
+
+        REQUIRE(ng::is_address_aligned(allocated_memory.back(), alignof(mock_fat_type)));
+    }
+
+    REQUIRE(pool.size() == 100);
+    REQUIRE(pool.capacity() >= 100);
+
+    SECTION("elements allocated from the same chunk are next to each other")
+    {
+        const auto first = reinterpret_cast<std::uintptr_t>(allocated_memory[0]);
+        const auto second = reinterpret_cast<std::uintptr_t>(allocated_memory[1]);
+
+        REQUIRE(second - first == sizeof(mock_fat_type));
+    }
+
+    SECTION("reserving memory makes sure the next allocations don't grow the pool")
+    {
+        pool.reserve(1000);
+        const std::size_t capacity = pool.capacity();
+
+        for(int i = 0; i < 1000; ++i)
+        {
+            allocated_memory.push_back(pool.allocate());
+        }
+
+        REQUIRE(pool.capacity() == capacity);
+    }
+
+    for(void* memory : allocated_memory)
+    {
+        pool.free(memory);
+    }
+
+    REQUIRE(pool.size() == 0);
+}
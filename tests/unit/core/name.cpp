@@ -2,6 +2,9 @@
 #include <ng/core/hash.hpp>
 #include <ng/core/name.hpp>
 
+#include <string>
+#include <vector>
+
 static const char* known_hash_collisions[2] = {
         "8yn0iYCKYHlIj4-BwPqk",
         "GReLUrM4wMqfg9yzV3KQ"
@@ -25,4 +28,33 @@ TEST_CASE("An inline name should safely handle hash collisions", "[name]" ) {
     const ng::name name_2{known_hash_collisions[1]};
 
     REQUIRE_FALSE(name_1 == name_2);
+}
+
+TEST_CASE("Names sharing a bucket of the name table can be released in any order", "[name]")
+{
+    // More names than buckets in the name table, most buckets hold a few of them
+    constexpr std::size_t name_count = 10000;
+
+    std::vector<ng::name> released;
+    std::vector<ng::name> kept;
+    for(std::size_t i = 0; i < name_count; ++i)
+    {
+        std::vector<ng::name>& names = i < name_count / 2 ? released : kept;
+        names.emplace_back("colliding_" + std::to_string(i));
+    }
+
+    // The first names are at the end of their bucket
+    released.clear();
+
+    std::size_t lost_count = 0;
+    for(std::size_t i = 0; i < kept.size(); ++i)
+    {
+        const ng::name same{"colliding_" + std::to_string(name_count / 2 + i)};
+        if(same != kept[i])
+        {
+            ++lost_count;
+        }
+    }
+
+    REQUIRE(lost_count == 0);
 }
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include <catch.hpp>
+#include <ng/core/small_vector.hpp>
+
+#include <utility>
+
+TEST_CASE("A small vector stores its first elements inside itself", "[small_vector]")
+{
+    ng::small_vector<int, 4> vector;
+
+    for(int i = 0; i < 4; ++i)
+    {
+        vector.push_back(i);
+    }
+
+    REQUIRE(vector.size() == 4);
+    REQUIRE(vector.capacity() == 4);
+
+    SECTION("it grows once the inline capacity is full")
+    {
+        for(int i = 4; i < 100; ++i)
+        {
+            vector.push_back(i);
+        }
+
+        REQUIRE(vector.size() == 100);
+        REQUIRE(vector.capacity() >= 100);
+
+        int mismatch_count = 0;
+        for(int i = 0; i < 100; ++i)
+        {
+            if(vector[i] != i)
+            {
+                ++mismatch_count;
+            }
+        }
+
+        REQUIRE(mismatch_count == 0);
+    }
+
+    SECTION("copies have the same elements")
+    {
+        vector.push_back(4);
+
+        ng::small_vector<int, 4> copy = vector;
+        REQUIRE(copy.size() == 5);
+        REQUIRE(copy.back() == 4);
+        REQUIRE(copy.data() != vector.data());
+    }
+
+    SECTION("moving a grown vector steals its elements")
+    {
+        vector.push_back(4);
+        const int* elements = vector.data();
+
+        ng::small_vector<int, 4> moved = std::move(vector);
+        REQUIRE(moved.data() == elements);
+        REQUIRE(moved.size() == 5);
+        REQUIRE(vector.empty());
+    }
+
+    SECTION("moving an inline vector copies its elements")
+    {
+        ng::small_vector<int, 4> moved = std::move(vector);
+        REQUIRE(moved.size() == 4);
+        REQUIRE(moved[3] == 3);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include <catch.hpp>
+#include <ng/core/thread_pool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+TEST_CASE("A thread pool processes every item of a loop once", "[thread_pool]")
+{
+    ng::thread_pool pool{3};
+
+    REQUIRE(pool.worker_count() == 3);
+
+    SECTION("every item is processed once")
+    {
+        std::vector<int> processed(10000, 0);
+
+        pool.parallel_for(processed.size(), 64, [&processed](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t i = begin; i < end; ++i)
+            {
+                ++processed[i];
+            }
+        });
+
+        REQUIRE(std::all_of(processed.begin(), processed.end(), [](int count) { return count == 1; }));
+    }
+
+    SECTION("an empty loop doesn't call the function")
+    {
+        bool called = false;
+
+        pool.parallel_for(0, 64, [&called](std::size_t, std::size_t) { called = true; });
+
+        REQUIRE_FALSE(called);
+    }
+
+    SECTION("consecutive loops don't overlap")
+    {
+        std::atomic<std::size_t> total{0};
+
+        for(int i = 0; i < 100; ++i)
+        {
+            pool.parallel_for(1000, 10, [&total](std::size_t begin, std::size_t end)
+            {
+                total += end - begin;
+            });
+
+            REQUIRE(total == 1000 * static_cast<std::size_t>(i + 1));
+        }
+    }
+}
+
+TEST_CASE("A thread pool without workers runs loops on the calling thread", "[thread_pool]")
+{
+    ng::thread_pool pool{0};
+
+    std::size_t total = 0;
+    pool.parallel_for(1000, 10, [&total](std::size_t begin, std::size_t end)
+    {
+        total += end - begin;
+    });
+
+    REQUIRE(total == 1000);
+}
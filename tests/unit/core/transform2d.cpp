@@ -1,6 +1,7 @@
 #include <catch.hpp>
 #include <glm/gtc/epsilon.hpp>
 #include <ng/core/transform2d.hpp>
+#include <vector>
 
 TEST_CASE("An identity transform can be created", "[transform2d]" )
 {
@@ -222,4 +223,157 @@ TEST_CASE("A transform can transform a point", "[transform2d]")
 
         REQUIRE(transformed_point == glm::vec2{1.51471901f, 44.8198051f});
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("A transform can transform a range of points", "[transform2d]")
+{
+    const ng::transform2d transform{glm::vec2{10.f, 13.f}, glm::radians(45.f), glm::vec2{1.2f, 1.5f}};
+
+    // Odd sizes and offsets make sure both the vectorized body and the tails are covered
+    std::vector<glm::vec2> points(37);
+    for(std::size_t i = 0; i < points.size(); ++i)
+    {
+        points[i] = glm::vec2{static_cast<float>(i) * 1.5f, 20.f - static_cast<float>(i)};
+    }
+
+    const auto require_similar = [](const glm::vec2& a, const glm::vec2& b)
+    {
+        REQUIRE(glm::all(glm::epsilonEqual(a, b, 0.0001f)));
+    };
+
+    SECTION("transforming a range of points gives the same result as transforming each point")
+    {
+        for(std::size_t offset = 0; offset < 4; ++offset)
+        {
+            const std::size_t count = points.size() - offset;
+            std::vector<glm::vec2> transformed_points(count);
+
+            transform.transform_points(points.data() + offset, transformed_points.data(), count);
+
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                require_similar(transformed_points[i], transform.transform_point(points[i + offset]));
+            }
+        }
+    }
+
+    SECTION("a range of points can be transformed in place")
+    {
+        std::vector<glm::vec2> transformed_points = points;
+
+        transform.transform_points(transformed_points.data() + 1, transformed_points.data() + 1, transformed_points.size() - 1);
+
+        REQUIRE(transformed_points[0] == points[0]);
+        for(std::size_t i = 1; i < points.size(); ++i)
+        {
+            require_similar(transformed_points[i], transform.transform_point(points[i]));
+        }
+    }
+
+    SECTION("transforming a range of vectors ignores the translation")
+    {
+        std::vector<glm::vec2> transformed_vectors(points.size());
+
+        transform.transform_vectors(points.data(), transformed_vectors.data(), points.size());
+
+        for(std::size_t i = 0; i < points.size(); ++i)
+        {
+            require_similar(transformed_vectors[i], transform.transform_vector(points[i]));
+        }
+    }
+
+    SECTION("points stored as separate coordinate arrays can be transformed")
+    {
+        std::vector<float> xs(points.size());
+        std::vector<float> ys(points.size());
+        for(std::size_t i = 0; i < points.size(); ++i)
+        {
+            xs[i] = points[i].x;
+            ys[i] = points[i].y;
+        }
+
+        std::vector<float> transformed_xs(points.size());
+        std::vector<float> transformed_ys(points.size());
+        transform.transform_points(xs.data(), ys.data(), transformed_xs.data(), transformed_ys.data(), points.size());
+
+        for(std::size_t i = 0; i < points.size(); ++i)
+        {
+            require_similar(glm::vec2{transformed_xs[i], transformed_ys[i]}, transform.transform_point(points[i]));
+        }
+    }
+
+    SECTION("each point can be transformed by its own transform")
+    {
+        std::vector<ng::transform2d> transforms(points.size());
+        for(std::size_t i = 0; i < transforms.size(); ++i)
+        {
+            transforms[i] = ng::transform2d{glm::vec2{static_cast<float>(i), 2.f},
+                                            glm::radians(static_cast<float>(i) * 10.f),
+                                            glm::vec2{1.f + static_cast<float>(i) * 0.1f, 0.5f}};
+        }
+
+        std::vector<glm::vec2> transformed_points(points.size());
+        ng::transform_points(transforms.data(), points.data(), transformed_points.data(), points.size());
+
+        for(std::size_t i = 0; i < points.size(); ++i)
+        {
+            require_similar(transformed_points[i], transforms[i].transform_point(points[i]));
+        }
+    }
+}
+
+TEST_CASE("Transforms can be interpolated", "[transform2d]")
+{
+    const ng::transform2d from{glm::vec2{0.f, 10.f}, glm::radians(10.f), glm::vec2{1.f, 1.f}};
+    const ng::transform2d to{glm::vec2{10.f, 20.f}, glm::radians(30.f), glm::vec2{2.f, 3.f}};
+
+    SECTION("interpolating at the ends returns the original transforms")
+    {
+        REQUIRE(ng::interpolate(from, to, 0.f).similar(from, 0.0001f));
+        REQUIRE(ng::interpolate(from, to, 1.f).similar(to, 0.0001f));
+    }
+
+    SECTION("interpolating halfway returns the transform between both transforms")
+    {
+        const ng::transform2d expected{glm::vec2{5.f, 15.f}, glm::radians(20.f), glm::vec2{1.5f, 2.f}};
+
+        REQUIRE(ng::interpolate(from, to, 0.5f).similar(expected, 0.0001f));
+    }
+
+    SECTION("the rotation is interpolated on the shortest arc")
+    {
+        const ng::transform2d almost_full_turn{glm::vec2{}, glm::radians(350.f)};
+        const ng::transform2d small_turn{glm::vec2{}, glm::radians(10.f)};
+
+        const ng::transform2d interpolated = ng::interpolate(almost_full_turn, small_turn, 0.5f);
+
+        REQUIRE(std::abs(std::remainder(interpolated.rotation, glm::two_pi<float>())) < 0.0001f);
+    }
+
+    SECTION("ranges of transforms can be interpolated")
+    {
+        const std::vector<ng::transform2d> froms(5, from);
+        const std::vector<ng::transform2d> tos(5, to);
+        std::vector<ng::transform2d> interpolated(5);
+
+        ng::interpolate(froms.data(), tos.data(), interpolated.data(), interpolated.size(), 0.25f);
+
+        for(const ng::transform2d& transform : interpolated)
+        {
+            REQUIRE(transform.similar(ng::interpolate(from, to, 0.25f)));
+        }
+    }
+}
+
+TEST_CASE("The inverse matrix of a transform can be computed from its components", "[transform2d]")
+{
+    const ng::transform2d transform{glm::vec2{10.f, 13.f}, glm::radians(45.f), glm::vec2{1.2f, 1.5f}};
+
+    const glm::mat3 expected_matrix = glm::inverse(transform.matrix());
+    const glm::mat3 inverse_matrix = transform.inverse_matrix();
+
+    for(int i = 0; i < 3; ++i)
+    {
+        REQUIRE(glm::all(glm::epsilonEqual(expected_matrix[i], inverse_matrix[i], 0.0001f)));
+    }
+}
@@ -0,0 +1,222 @@
+#include <catch.hpp>
+#include <ng/gameplay/component_store.hpp>
+#include <ng/gameplay/node_tree.hpp>
+#include <ng/core/thread_pool.hpp>
+
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace ng::literals;
+
+namespace
+{
+
+struct velocity
+{
+    glm::vec2 value{0.f, 0.f};
+};
+
+struct health
+{
+    int points = 100;
+};
+
+std::size_t destroyed_count = 0;
+
+struct tracked
+{
+    bool moved_from = false;
+
+    tracked() = default;
+
+    tracked(tracked&& other) noexcept
+    {
+        other.moved_from = true;
+    }
+
+    tracked& operator=(tracked&& other) noexcept
+    {
+        other.moved_from = true;
+        return *this;
+    }
+
+    ~tracked()
+    {
+        if(!moved_from)
+        {
+            ++destroyed_count;
+        }
+    }
+};
+
+std::vector<ng::node*> make_nodes(ng::node_tree& tree, ng::node* parent, std::size_t count)
+{
+    std::vector<ng::node*> nodes;
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        nodes.push_back(tree.make_node<ng::node>(ng::name{"node" + std::to_string(i)}, parent));
+    }
+
+    return nodes;
+}
+
+}
+
+TEST_CASE("Components are added to nodes and found again", "[component_store]")
+{
+    ng::node_tree tree;
+    auto root = tree.make_node<ng::node>("root"_name);
+    tree.set_root(root);
+    auto ship = tree.make_node<ng::node>("ship"_name, root);
+    auto rock = tree.make_node<ng::node>("rock"_name, root);
+
+    ng::component_store& components = tree.components();
+
+    REQUIRE_FALSE(components.find<velocity>(ship));
+    REQUIRE_FALSE(components.has<velocity>(ship));
+
+    components.add<velocity>(ship, velocity{glm::vec2{1.f, 2.f}});
+    components.add<velocity>(rock, velocity{glm::vec2{3.f, 4.f}});
+    components.add<health>(ship, health{50});
+
+    REQUIRE(components.has<velocity, health>(ship));
+    REQUIRE_FALSE(components.has<velocity, health>(rock));
+    REQUIRE(components.find<velocity>(ship)->value == glm::vec2{1.f, 2.f});
+    REQUIRE(components.find<health>(ship)->points == 50);
+    REQUIRE(components.find<velocity>(rock)->value == glm::vec2{3.f, 4.f});
+    REQUIRE_FALSE(components.find<health>(rock));
+
+    REQUIRE(components.count<velocity>() == 2);
+    REQUIRE(components.count<velocity, health>() == 1);
+
+    SECTION("adding a component again replaces it")
+    {
+        components.add<health>(ship, health{10});
+
+        REQUIRE(components.find<health>(ship)->points == 10);
+        REQUIRE(components.count<health>() == 1);
+    }
+
+    SECTION("removing a component keeps the other components")
+    {
+        components.remove<velocity>(ship);
+
+        REQUIRE_FALSE(components.find<velocity>(ship));
+        REQUIRE(components.find<health>(ship)->points == 50);
+        REQUIRE(components.find<velocity>(rock)->value == glm::vec2{3.f, 4.f});
+
+        components.remove<health>(ship);
+        components.remove<health>(ship);
+
+        REQUIRE_FALSE(components.has<health>(ship));
+        REQUIRE(components.count<velocity>() == 1);
+    }
+
+    SECTION("nodes sharing the component types share an archetype")
+    {
+        components.add<health>(rock);
+
+        std::size_t used_archetypes = 0;
+        for(const auto& archetype : components.archetypes())
+        {
+            if(archetype->size() > 0)
+            {
+                ++used_archetypes;
+                REQUIRE(archetype->mask() == ng::component_mask_of<velocity, health>());
+            }
+        }
+
+        REQUIRE(used_archetypes == 1);
+        REQUIRE(components.find<health>(rock)->points == 100);
+    }
+}
+
+TEST_CASE("Components of a node are destroyed with the node", "[component_store]")
+{
+    destroyed_count = 0;
+
+    ng::node_tree tree;
+    auto root = tree.make_node<ng::node>("root"_name);
+    tree.set_root(root);
+    const std::vector<ng::node*> nodes = make_nodes(tree, root, 3);
+
+    for(ng::node* n : nodes)
+    {
+        tree.components().add<tracked>(n);
+    }
+
+    // Moving the components to another archetype doesn't destroy them
+    tree.components().add<health>(nodes[0], health{1});
+    tree.components().remove<health>(nodes[0]);
+    REQUIRE(destroyed_count == 0);
+
+    nodes[1]->detach_from_parent();
+    tree.free_unreachable_nodes();
+
+    REQUIRE(destroyed_count == 1);
+    REQUIRE(tree.components().count<tracked>() == 2);
+    REQUIRE(tree.components().has<tracked>(nodes[0]));
+    REQUIRE(tree.components().has<tracked>(nodes[2]));
+}
+
+TEST_CASE("Queries iterate the nodes having every component", "[component_store]")
+{
+    // Enough nodes to fill several chunks
+    constexpr std::size_t node_count = 5000;
+
+    ng::node_tree tree;
+    auto root = tree.make_node<ng::node>("root"_name);
+    tree.set_root(root);
+    const std::vector<ng::node*> nodes = make_nodes(tree, root, node_count);
+
+    ng::component_store& components = tree.components();
+    for(std::size_t i = 0; i < node_count; ++i)
+    {
+        components.add<velocity>(nodes[i], velocity{glm::vec2{static_cast<float>(i), 0.f}});
+        if(i % 2 == 0)
+        {
+            components.add<health>(nodes[i], health{static_cast<int>(i)});
+        }
+    }
+
+    // Removing a node from the middle of an archetype moves the last one in its place
+    components.remove<velocity>(nodes[1]);
+
+    std::size_t chunk_count = 0;
+    components.for_each_chunk<velocity>([&](const ng::component_archetype& archetype, std::size_t chunk)
+    {
+        ++chunk_count;
+        REQUIRE(archetype.chunk_rows(chunk) > 0);
+    });
+
+    REQUIRE(chunk_count > 2);
+
+    std::size_t visited = 0;
+    components.for_each<velocity>([&](ng::node& n, velocity& v)
+    {
+        REQUIRE(n.name() == ng::name{"node" + std::to_string(static_cast<std::size_t>(v.value.x))});
+        v.value.y = 1.f;
+        ++visited;
+    });
+
+    REQUIRE(visited == node_count - 1);
+    REQUIRE(components.find<velocity>(nodes[node_count - 1])->value == glm::vec2{static_cast<float>(node_count - 1), 1.f});
+
+    SECTION("nodes are visited once with multiple threads")
+    {
+        ng::thread_pool pool{3};
+        components.for_each<velocity, health>(pool, [](ng::node&, velocity& v, health& h)
+        {
+            v.value.y += static_cast<float>(h.points);
+        });
+
+        for(std::size_t i = 0; i < node_count; i += 2)
+        {
+            REQUIRE(components.find<velocity>(nodes[i])->value.y == 1.f + static_cast<float>(i));
+        }
+
+        REQUIRE(components.find<velocity>(nodes[3])->value.y == 1.f);
+    }
+}
@@ -0,0 +1,242 @@
+#include <catch.hpp>
+#include <ng/gameplay/event_dispatcher.hpp>
+#include <ng/gameplay/node_tree.hpp>
+#include <ng/gameplay/node.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace ng::literals;
+
+namespace
+{
+
+struct damage_event : ng::event
+{
+    int amount;
+
+    explicit damage_event(int amount) noexcept
+    : amount{amount}
+    {
+
+    }
+};
+
+struct shield_decorator : ng::node_decorator
+{
+
+};
+
+}
+
+TEST_CASE("Dispatched events are captured then bubbled through the ancestors of the target", "[event_dispatcher]")
+{
+    ng::node_tree tree;
+
+    auto root = tree.make_node<ng::node>("root"_name);
+    auto parent = tree.make_node<ng::node>("parent"_name, root);
+    auto target = tree.make_node<ng::node>("target"_name, parent);
+    auto sibling = tree.make_node<ng::node>("sibling"_name, parent);
+    tree.set_root(root);
+
+    ng::event_dispatcher& events = tree.events();
+
+    std::vector<std::string> received;
+    const auto record = [&received](const char* label)
+    {
+        return [&received, label](damage_event& e)
+        {
+            received.push_back(std::string{label} + ":" + std::to_string(e.phase()));
+        };
+    };
+
+    events.listen<damage_event>(root, record("root"));
+    events.listen<damage_event>(parent, record("parent"));
+    events.listen<damage_event>(target, record("target"));
+    events.listen<damage_event>(sibling, record("sibling"));
+
+    damage_event damage{10};
+
+    SECTION("every ancestor receives the event twice")
+    {
+        events.dispatch(damage, target);
+
+        const std::vector<std::string> expected = {
+            "root:1", "parent:1", "target:2", "parent:4", "root:4"
+        };
+        REQUIRE(received == expected);
+        REQUIRE(damage.target() == target);
+    }
+
+    SECTION("a listener can stop the propagation")
+    {
+        events.listen<damage_event>(parent, [](damage_event& e)
+        {
+            e.stop_propagation();
+        }, ng::event::capture);
+
+        events.dispatch(damage, target);
+
+        const std::vector<std::string> expected = {"root:1", "parent:1"};
+        REQUIRE(received == expected);
+    }
+
+    SECTION("listeners only receive the phases they asked for")
+    {
+        std::vector<ng::node*> bubbled;
+        events.listen<damage_event>(root, [&bubbled](damage_event& e)
+        {
+            bubbled.push_back(e.current_node());
+        }, ng::event::bubble);
+
+        events.dispatch(damage, target);
+
+        REQUIRE(bubbled.size() == 1);
+        REQUIRE(bubbled.front() == root);
+    }
+
+    SECTION("decorators receive the events before their node")
+    {
+        auto& shield = target->emplace_decorator<shield_decorator>();
+        REQUIRE(shield.decorated_node() == target);
+
+        events.listen<damage_event>(shield, [](damage_event& e)
+        {
+            if(e.phase() == ng::event::at_target)
+            {
+                e.stop_immediate_propagation();
+            }
+        });
+
+        events.dispatch(damage, target);
+
+        const std::vector<std::string> expected = {"root:1", "parent:1"};
+        REQUIRE(received == expected);
+    }
+
+    SECTION("unlistening while the event is sent skips the listener")
+    {
+        ng::event_dispatcher::listener_id target_listener = 0;
+        events.listen<damage_event>(parent, [&](damage_event&)
+        {
+            events.unlisten(target_listener);
+        }, ng::event::capture);
+
+        target_listener = events.listen<damage_event>(target, [&received](damage_event&)
+        {
+            received.emplace_back("removed");
+        });
+
+        events.dispatch(damage, target);
+        events.dispatch(damage, target);
+
+        REQUIRE(std::count(received.begin(), received.end(), "removed") == 0);
+    }
+}
+
+TEST_CASE("Broadcast events are sent to the listeners of a subtree", "[event_dispatcher]")
+{
+    ng::node_tree tree;
+
+    auto root = tree.make_node<ng::node>("root"_name);
+    auto parent = tree.make_node<ng::node>("parent"_name, root);
+    auto child = tree.make_node<ng::node>("child"_name, parent);
+    auto other = tree.make_node<ng::node>("other"_name, root);
+    tree.set_root(root);
+
+    ng::event_dispatcher& events = tree.events();
+
+    std::vector<ng::node*> received;
+    const auto record = [&received](damage_event& e)
+    {
+        received.push_back(e.current_node());
+    };
+
+    events.listen<damage_event>(parent, record);
+    events.listen<damage_event>(child, record);
+    events.listen<damage_event>(other, record);
+
+    damage_event damage{1};
+    events.broadcast(damage, parent);
+
+    REQUIRE(received == std::vector<ng::node*>{parent, child});
+
+    SECTION("destroyed nodes stop listening")
+    {
+        child->detach_from_parent();
+        tree.free_unreachable_nodes();
+
+        received.clear();
+        events.broadcast(damage, root);
+
+        REQUIRE(received == std::vector<ng::node*>{parent, other});
+    }
+
+    SECTION("nodes keep their order when another node stops listening")
+    {
+        events.unlisten_all(parent);
+
+        received.clear();
+        events.broadcast(damage, root);
+
+        REQUIRE(received == std::vector<ng::node*>{child, other});
+    }
+
+    SECTION("nodes destroyed while the event is sent stop receiving it")
+    {
+        ng::node* destroyed = child;
+        events.listen<damage_event>(parent, [&tree, &destroyed](damage_event&)
+        {
+            if(destroyed)
+            {
+                destroyed->detach_from_parent();
+                destroyed = nullptr;
+                tree.free_unreachable_nodes();
+            }
+        });
+
+        received.clear();
+        events.broadcast(damage, root);
+        REQUIRE(received == std::vector<ng::node*>{parent, other});
+
+        received.clear();
+        events.broadcast(damage, root);
+        REQUIRE(received == std::vector<ng::node*>{parent, other});
+    }
+}
+
+TEST_CASE("Queued events are sent together", "[event_dispatcher]")
+{
+    ng::node_tree tree;
+
+    auto root = tree.make_node<ng::node>("root"_name);
+    auto child = tree.make_node<ng::node>("child"_name, root);
+    tree.set_root(root);
+
+    ng::event_dispatcher& events = tree.events();
+
+    std::vector<int> amounts;
+    events.listen<damage_event>(child, [&](damage_event& e)
+    {
+        amounts.push_back(e.amount);
+
+        // Events queued while sending are sent by the next call
+        if(e.amount == 1)
+        {
+            events.queue<damage_event>(child, 3);
+        }
+    }, ng::event::at_target | ng::event::broadcast);
+
+    events.queue<damage_event>(child, 1);
+    events.queue_broadcast<damage_event>(root, 2);
+    REQUIRE(events.queued_count() == 2);
+
+    events.dispatch_queued();
+    REQUIRE(amounts == std::vector<int>{1, 2});
+    REQUIRE(events.queued_count() == 1);
+
+    events.dispatch_queued();
+    REQUIRE(amounts == std::vector<int>{1, 2, 3});
+    REQUIRE(events.queued_count() == 0);
+}
\ No newline at end of file
@@ -0,0 +1,270 @@
+#include <catch.hpp>
+#include <ng/gameplay/node.hpp>
+#include <ng/gameplay/node_tree.hpp>
+#include <ng/gameplay/node2d.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace ng::literals;
+
+namespace
+{
+
+class tagged_node : public ng::node
+{
+public:
+    tagged_node(ng::node_tree& owner, ng::safe_name name)
+    : ng::node{owner, std::move(name)}
+    {
+        add_node_type<tagged_node>();
+    }
+};
+
+class derived_tagged_node : public tagged_node
+{
+public:
+    using tagged_node::tagged_node;
+};
+
+std::size_t destroyed_decorator_count = 0;
+
+struct tracked_decorator : ng::node_decorator
+{
+    ~tracked_decorator() override
+    {
+        ++destroyed_decorator_count;
+    }
+};
+
+}
+
+TEST_CASE("Children of a node are linked in the order they were attached", "[node]")
+{
+    ng::node_tree tree;
+
+    auto parent = tree.make_node<ng::node>("parent"_name);
+    auto first = tree.make_node<ng::node>("first"_name, parent);
+    auto second = tree.make_node<ng::node>("second"_name, parent);
+    auto third = tree.make_node<ng::node>("third"_name, parent);
+
+    REQUIRE(parent->first_child() == first);
+    REQUIRE(parent->last_child() == third);
+    REQUIRE(first->next_sibling() == second);
+    REQUIRE(second->next_sibling() == third);
+    REQUIRE(third->next_sibling() == nullptr);
+    REQUIRE(third->previous_sibling() == second);
+    REQUIRE(first->previous_sibling() == nullptr);
+
+    SECTION("detaching a child links its siblings together")
+    {
+        second->detach_from_parent();
+
+        REQUIRE(first->next_sibling() == third);
+        REQUIRE(third->previous_sibling() == first);
+        REQUIRE(second->next_sibling() == nullptr);
+        REQUIRE(second->previous_sibling() == nullptr);
+        REQUIRE_FALSE(parent->has_child(second));
+    }
+
+    SECTION("detaching the first and last children updates the parent")
+    {
+        first->detach_from_parent();
+        third->detach_from_parent();
+
+        REQUIRE(parent->first_child() == second);
+        REQUIRE(parent->last_child() == second);
+    }
+
+    SECTION("a child attached to another parent is added after its new siblings")
+    {
+        auto other_parent = tree.make_node<ng::node>("other_parent"_name);
+        auto other_child = tree.make_node<ng::node>("other_child"_name, other_parent);
+
+        first->attach_to(other_parent);
+
+        REQUIRE(parent->first_child() == second);
+        REQUIRE(other_child->next_sibling() == first);
+        REQUIRE(other_parent->last_child() == first);
+    }
+
+    SECTION("a child can't be attached next to a sibling with the same name")
+    {
+        auto duplicate = tree.make_node<ng::node>("first"_name);
+
+        REQUIRE_THROWS_AS(duplicate->attach_to(parent), ng::invalid_node_name);
+    }
+}
+
+
+TEST_CASE("Children of a wide node are found by their name", "[node]")
+{
+    constexpr std::size_t child_count = 1000;
+
+    ng::node_tree tree;
+
+    auto parent = tree.make_node<ng::node>("parent"_name);
+
+    std::vector<ng::node*> children;
+    for(std::size_t i = 0; i < child_count; ++i)
+    {
+        children.push_back(tree.make_node<ng::node>(ng::name{std::to_string(i)}, parent));
+    }
+
+    REQUIRE(parent->child_count() == child_count);
+
+    std::size_t missing_count = 0;
+    for(std::size_t i = 0; i < child_count; ++i)
+    {
+        if(parent->find_child(ng::name{std::to_string(i)}) != children[i])
+        {
+            ++missing_count;
+        }
+    }
+
+    REQUIRE(missing_count == 0);
+    REQUIRE(parent->find_child("unknown"_name) == nullptr);
+
+    SECTION("a child can't be attached next to a sibling with the same name")
+    {
+        auto duplicate = tree.make_node<ng::node>("500"_name);
+
+        REQUIRE_THROWS_AS(duplicate->attach_to(parent), ng::invalid_node_name);
+    }
+
+    SECTION("detached children can't be found anymore")
+    {
+        for(std::size_t i = 0; i < child_count; i += 2)
+        {
+            children[i]->detach_from_parent();
+        }
+
+        REQUIRE(parent->child_count() == child_count / 2);
+
+        std::size_t mismatch_count = 0;
+        for(std::size_t i = 0; i < child_count; ++i)
+        {
+            const ng::node* expected_child = i % 2 == 0 ? nullptr : children[i];
+            if(parent->find_child(ng::name{std::to_string(i)}) != expected_child)
+            {
+                ++mismatch_count;
+            }
+        }
+
+        REQUIRE(mismatch_count == 0);
+    }
+
+    SECTION("children are still found after the node shrinks back")
+    {
+        for(std::size_t i = 3; i < child_count; ++i)
+        {
+            children[i]->detach_from_parent();
+        }
+
+        REQUIRE(parent->child_count() == 3);
+        REQUIRE(parent->find_child("0"_name) == children[0]);
+        REQUIRE(parent->find_child("2"_name) == children[2]);
+        REQUIRE(parent->find_child("3"_name) == nullptr);
+
+        children[3]->attach_to(parent);
+        REQUIRE(parent->find_child("3"_name) == children[3]);
+    }
+}
+
+TEST_CASE("Nodes know their types without a virtual call", "[node]")
+{
+    ng::node_tree tree;
+
+    auto plain = tree.make_node<ng::node>("plain"_name);
+    auto spatial = tree.make_node<ng::node2d>("spatial"_name);
+    auto tagged = tree.make_node<tagged_node>("tagged"_name);
+    auto derived = tree.make_node<derived_tagged_node>("derived"_name);
+
+    REQUIRE(plain->is_a<ng::node>());
+    REQUIRE_FALSE(plain->is_a<ng::node2d>());
+    REQUIRE_FALSE(plain->is_a<tagged_node>());
+    REQUIRE(plain->primary_node_type() == ng::primary_node_types::node);
+
+    REQUIRE(spatial->is_a<ng::node>());
+    REQUIRE(spatial->is_a<ng::node2d>());
+    REQUIRE_FALSE(spatial->is_a<tagged_node>());
+    REQUIRE(spatial->primary_node_type() == ng::primary_node_types::node2d);
+
+    REQUIRE(tagged->is_a<tagged_node>());
+    REQUIRE_FALSE(tagged->is_a<ng::node2d>());
+    REQUIRE(tagged->primary_node_type() == ng::primary_node_types::node);
+
+    SECTION("derived types inherit the types of their base")
+    {
+        REQUIRE(derived->is_a<ng::node>());
+        REQUIRE(derived->is_a<tagged_node>());
+        REQUIRE(derived->type_mask() == tagged->type_mask());
+    }
+}
+
+TEST_CASE("Decorators are kept apart from their node", "[node]")
+{
+    destroyed_decorator_count = 0;
+
+    ng::node_tree tree;
+    auto root = tree.make_node<ng::node>("root"_name);
+    tree.set_root(root);
+    auto decorated = tree.make_node<ng::node>("decorated"_name, root);
+    auto plain = tree.make_node<ng::node>("plain"_name, root);
+
+    auto& first = decorated->emplace_decorator<tracked_decorator>();
+    decorated->add_decorator(std::make_unique<tracked_decorator>());
+
+    REQUIRE(first.decorated_node() == decorated);
+    REQUIRE(decorated->decorator_count() == 2);
+    REQUIRE(plain->decorator_count() == 0);
+
+    SECTION("clearing the decorators destroys them")
+    {
+        decorated->clear_decorators();
+
+        REQUIRE(destroyed_decorator_count == 2);
+        REQUIRE(decorated->decorator_count() == 0);
+
+        plain->clear_decorators();
+        REQUIRE(destroyed_decorator_count == 2);
+    }
+
+    SECTION("decorators are destroyed with their node")
+    {
+        decorated->detach_from_parent();
+        tree.free_unreachable_nodes();
+
+        REQUIRE(destroyed_decorator_count == 2);
+    }
+
+    SECTION("decorators move with their node to a merged tree")
+    {
+        ng::node_tree other;
+        auto other_root = other.make_node<ng::node>("other"_name);
+        other.set_root(other_root);
+
+        auto moved = tree.make_node<ng::node>("moved"_name);
+        (void)moved->emplace_decorator<tracked_decorator>();
+
+        other.merge(tree, other_root);
+
+        REQUIRE(moved->decorator_count() == 1);
+        REQUIRE(decorated->decorator_count() == 2);
+        REQUIRE(destroyed_decorator_count == 0);
+    }
+}
+
+TEST_CASE("Nodes stay small", "[node]")
+{
+    // Children are linked through their siblings, decorators and large child indices live outside the node
+    REQUIRE(sizeof(ng::node) <= 14 * sizeof(void*));
+
+    ng::node_tree tree;
+    auto parent = tree.make_node<ng::node>("parent"_name);
+    auto leaf = tree.make_node<ng::node>("leaf"_name, parent);
+
+    REQUIRE(parent->decorator_count() == 0);
+    REQUIRE(leaf->decorator_count() == 0);
+    REQUIRE(leaf->leaf());
+}
\ No newline at end of file
@@ -1,13 +1,16 @@
 #include <catch.hpp>
 #include <ng/gameplay/node2d.hpp>
+#include <ng/gameplay/node_tree.hpp>
 
 using namespace ng::literals;
 
 TEST_CASE("A node2d combines it's local transform with it's parent world transform", "[node2d]")
 {
+    ng::node_tree tree;
+
     SECTION("A node2d without any parent will have its local transform equals to its world transform")
     {
-        ng::node2d node("temp"_name, ng::transform2d{glm::vec2{10.f, 10.f}, glm::radians(25.f), glm::vec2{1.2f, 1.2f}});
+        ng::node2d node(tree, "temp"_name, ng::transform2d{glm::vec2{10.f, 10.f}, glm::radians(25.f), glm::vec2{1.2f, 1.2f}});
 
         REQUIRE(node.world_transform() == node.local_transform());
     }
@@ -15,8 +18,8 @@ TEST_CASE("A node2d combines it's local transform with it's parent world transfo
     SECTION("A node2d with a parent will have its world transform affected by its parent")
     {
         const ng::transform2d child_transform{glm::vec2{5.f, 10.f}, glm::radians(10.f)};
-        ng::node2d parent_node("parent"_name, ng::transform2d{glm::vec2{10.f, 10.f}, glm::radians(25.f), glm::vec2{1.2f, 1.2f}});
-        ng::node2d child_node("child"_name, child_transform, &parent_node);
+        ng::node2d parent_node(tree, "parent"_name, ng::transform2d{glm::vec2{10.f, 10.f}, glm::radians(25.f), glm::vec2{1.2f, 1.2f}});
+        ng::node2d child_node(tree, "child"_name, child_transform, &parent_node);
 
         REQUIRE(child_node.local_transform() == child_transform);
         REQUIRE(child_node.world_transform() == parent_node.world_transform() * child_node.local_transform());
@@ -26,8 +29,8 @@ TEST_CASE("A node2d combines it's local transform with it's parent world transfo
     {
         const ng::transform2d child_transform{glm::vec2{5.f, 10.f}, glm::radians(10.f)};
 
-        ng::node parent("parent"_name);
-        ng::node2d child_node{"child"_name, child_transform, &parent};
+        ng::node parent(tree, "parent"_name);
+        ng::node2d child_node{tree, "child"_name, child_transform, &parent};
 
         REQUIRE(child_node.world_transform() == child_node.local_transform());
         REQUIRE(child_node.local_transform() == child_transform);
@@ -36,6 +39,8 @@ TEST_CASE("A node2d combines it's local transform with it's parent world transfo
 
 TEST_CASE("The world transform of a node2d can be set", "[node2d]")
 {
+    ng::node_tree tree;
+
     const ng::transform2d parent_transform{glm::vec2{10.f, 10.f},
                                            glm::radians(25.f),
                                            glm::vec2{1.2f, 1.2f}};
@@ -43,8 +48,8 @@ TEST_CASE("The world transform of a node2d can be set", "[node2d]")
     const ng::transform2d child_transform{glm::vec2{5.f, 10.f},
                                           glm::radians(10.f)};
 
-    ng::node2d parent_node("parent"_name, parent_transform);
-    ng::node2d child_node("child"_name, child_transform, &parent_node);
+    ng::node2d parent_node(tree, "parent"_name, parent_transform);
+    ng::node2d child_node(tree, "child"_name, child_transform, &parent_node);
 
     SECTION("changing world transform of child to the world transform of parent means the child has the identity transform")
     {
@@ -73,4 +78,70 @@ TEST_CASE("The world transform of a node2d can be set", "[node2d]")
         REQUIRE(child_node.world_transform() == new_transform);
         REQUIRE(expected_transform.similar(child_node.world_transform(), 0.1f));
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("The world transform of a node2d follows its parents", "[node2d]")
+{
+    ng::node_tree tree;
+
+    ng::node2d parent_node(tree, "parent"_name, ng::transform2d{glm::vec2{10.f, 10.f}});
+    ng::node2d child_node(tree, "child"_name, ng::transform2d{glm::vec2{5.f, 0.f}}, &parent_node);
+    ng::node2d grand_child_node(tree, "grand_child"_name, ng::transform2d{glm::vec2{0.f, 5.f}}, &child_node);
+
+    REQUIRE(grand_child_node.world_transform() == ng::transform2d{glm::vec2{15.f, 15.f}});
+
+    SECTION("moving a parent moves all of its children")
+    {
+        parent_node.set_local_transform(ng::transform2d{glm::vec2{20.f, 0.f}, glm::radians(90.f)});
+
+        REQUIRE(child_node.world_transform().similar(ng::transform2d{glm::vec2{20.f, 5.f}, glm::radians(90.f)}, 0.0001f));
+        REQUIRE(grand_child_node.world_transform().similar(ng::transform2d{glm::vec2{15.f, 5.f}, glm::radians(90.f)}, 0.0001f));
+    }
+
+    SECTION("setting the world transform of a parent moves all of its children")
+    {
+        child_node.set_world_transform(ng::transform2d{glm::vec2{0.f, 0.f}});
+
+        REQUIRE(child_node.local_transform().similar(ng::transform2d{glm::vec2{-10.f, -10.f}}, 0.0001f));
+        REQUIRE(grand_child_node.world_transform().similar(ng::transform2d{glm::vec2{0.f, 5.f}}, 0.0001f));
+    }
+
+    SECTION("a node2d attached to another parent follows its new parent")
+    {
+        ng::node2d other_parent_node(tree, "other_parent"_name, ng::transform2d{glm::vec2{-10.f, 0.f}});
+
+        grand_child_node.attach_to(&other_parent_node);
+
+        REQUIRE(grand_child_node.world_transform().similar(ng::transform2d{glm::vec2{-10.f, 5.f}}, 0.0001f));
+    }
+
+    SECTION("a detached node2d is no longer affected by its previous parent")
+    {
+        grand_child_node.detach_from_parent();
+
+        REQUIRE(grand_child_node.world_transform() == grand_child_node.local_transform());
+    }
+}
+
+TEST_CASE("A node tree can update all outdated world transforms at once", "[node2d]")
+{
+    ng::node_tree tree;
+
+    auto root = tree.make_node<ng::node2d>("root"_name, ng::transform2d{glm::vec2{10.f, 10.f}});
+    auto child = tree.make_node<ng::node2d>("child"_name, ng::transform2d{glm::vec2{5.f, 0.f}}, root);
+    auto container = tree.make_node<ng::node>("container"_name, child);
+    auto contained = tree.make_node<ng::node2d>("contained"_name, ng::transform2d{glm::vec2{1.f, 1.f}}, container);
+    auto grand_child = tree.make_node<ng::node2d>("grand_child"_name, ng::transform2d{glm::vec2{0.f, 5.f}}, child);
+
+    tree.set_root(root);
+    tree.update_world_transforms();
+
+    root->set_local_transform(ng::transform2d{glm::vec2{0.f, 0.f}});
+    tree.update_world_transforms();
+
+    REQUIRE(child->world_transform().similar(ng::transform2d{glm::vec2{5.f, 0.f}}, 0.0001f));
+    REQUIRE(grand_child->world_transform().similar(ng::transform2d{glm::vec2{5.f, 5.f}}, 0.0001f));
+
+    // A node2d under a node which is not a node2d is not affected by the hierarchy above it
+    REQUIRE(contained->world_transform() == contained->local_transform());
+}
@@ -0,0 +1,235 @@
+#include <catch.hpp>
+#include <node_names.hpp>
+#include <ng/gameplay/node_command_buffer.hpp>
+#include <ng/gameplay/node_tree.hpp>
+#include <ng/gameplay/node2d.hpp>
+#include <ng/core/thread_pool.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace ng::literals;
+
+namespace
+{
+
+std::size_t destroyed_count = 0;
+
+class tracked_node : public ng::node
+{
+public:
+    tracked_node(ng::node_tree& owner, ng::safe_name name, ng::node* parent = nullptr)
+    : ng::node{owner, std::move(name), parent}
+    {
+
+    }
+
+    ~tracked_node() override
+    {
+        ++destroyed_count;
+    }
+};
+
+}
+
+TEST_CASE("Recorded commands change nothing until applied", "[node_command_buffer]")
+{
+    ng::node_tree tree;
+    auto root = tree.make_node<ng::node>("root"_name);
+    tree.set_root(root);
+    auto enemy = tree.make_node<ng::node>("enemy"_name, root);
+
+    ng::node_command_buffer buffer;
+    REQUIRE(buffer.empty());
+
+    auto squad = buffer.create<ng::node>("squad"_name, root);
+    (void)buffer.create<ng::node2d>("soldier"_name, ng::transform2d{glm::vec2{10.f, 0.f}}, squad);
+    buffer.attach(squad, enemy);
+
+    REQUIRE_FALSE(buffer.empty());
+    REQUIRE(root->child_count() == 1);
+    REQUIRE(enemy->parent() == root);
+
+    tree.apply(buffer);
+
+    REQUIRE(buffer.empty());
+    REQUIRE(ng::test::child_names(root) == std::vector<std::string>{"squad"});
+    REQUIRE(tree.find("root/squad/enemy"_node) == enemy);
+
+    auto soldier = dynamic_cast<ng::node2d*>(tree.find("root/squad/soldier"_node));
+    REQUIRE(soldier);
+
+    tree.update_world_transforms();
+    REQUIRE(soldier->world_transform().similar(ng::transform2d{glm::vec2{10.f, 0.f}}, 0.0001f));
+}
+
+TEST_CASE("Only the last command of a node is applied", "[node_command_buffer]")
+{
+    ng::node_tree tree;
+    auto root = tree.make_node<ng::node>("root"_name);
+    tree.set_root(root);
+    auto left = tree.make_node<ng::node>("left"_name, root);
+    auto right = tree.make_node<ng::node>("right"_name, root);
+    auto item = tree.make_node<ng::node>("item"_name, left);
+
+    ng::node_command_buffer buffer;
+
+    SECTION("the last parent is kept")
+    {
+        buffer.detach(item);
+        buffer.attach(root, item);
+        buffer.attach(right, item);
+
+        tree.apply(buffer);
+
+        REQUIRE(item->parent() == right);
+        REQUIRE(left->child_count() == 0);
+        REQUIRE(root->child_count() == 2);
+    }
+
+    SECTION("moving a node back to its parent keeps its place")
+    {
+        (void)tree.make_node<ng::node>("other"_name, left);
+        buffer.attach(right, item);
+        buffer.attach(left, item);
+
+        tree.apply(buffer);
+
+        REQUIRE(ng::test::child_names(left) == std::vector<std::string>{"item", "other"});
+        REQUIRE(right->child_count() == 0);
+    }
+
+    SECTION("destroyed nodes are freed by the next collection")
+    {
+        destroyed_count = 0;
+        auto tracked = tree.make_node<tracked_node>("tracked"_name, left);
+
+        auto created = buffer.create<tracked_node>("created"_name, right);
+        buffer.destroy(created);
+        buffer.destroy(tracked);
+
+        tree.apply(buffer);
+        REQUIRE(right->child_count() == 0);
+        REQUIRE(left->child_count() == 1);
+        REQUIRE(destroyed_count == 0);
+
+        tree.free_unreachable_nodes();
+        REQUIRE(destroyed_count == 2);
+    }
+}
+
+TEST_CASE("Buffers are applied deterministically", "[node_command_buffer]")
+{
+    ng::node_tree tree;
+    auto root = tree.make_node<ng::node>("root"_name);
+    tree.set_root(root);
+    auto left = tree.make_node<ng::node>("left"_name, root);
+    auto right = tree.make_node<ng::node>("right"_name, root);
+    auto item = tree.make_node<ng::node>("item"_name, right);
+
+    std::vector<ng::node_command_buffer> buffers(2);
+
+    SECTION("children are attached in the order of the buffers")
+    {
+        (void)buffers[1].create<ng::node>("c"_name, left);
+        (void)buffers[0].create<ng::node>("a"_name, left);
+        (void)buffers[1].create<ng::node>("d"_name, right);
+        (void)buffers[0].create<ng::node>("b"_name, left);
+
+        tree.apply(buffers);
+
+        REQUIRE(ng::test::child_names(left) == std::vector<std::string>{"a", "b", "c"});
+        REQUIRE(ng::test::child_names(right) == std::vector<std::string>{"item", "d"});
+        REQUIRE(buffers[0].empty());
+        REQUIRE(buffers[1].empty());
+    }
+
+    SECTION("the names freed by a buffer can be used by another")
+    {
+        (void)buffers[0].create<ng::node>("item"_name, left);
+        buffers[1].attach(left, item);
+        buffers[1].detach(item);
+
+        tree.apply(buffers);
+
+        REQUIRE(ng::test::child_names(left) == std::vector<std::string>{"item"});
+        REQUIRE(tree.find("root/left/item"_node) != item);
+        REQUIRE(right->child_count() == 0);
+    }
+
+    SECTION("two nodes with the same name can swap their parent")
+    {
+        auto other_item = tree.make_node<ng::node>("item"_name, left);
+
+        buffers[0].attach(left, item);
+        buffers[1].attach(right, other_item);
+
+        tree.apply(buffers);
+
+        REQUIRE(item->parent() == left);
+        REQUIRE(other_item->parent() == right);
+        REQUIRE(left->child_count() == 1);
+        REQUIRE(right->child_count() == 1);
+    }
+
+    SECTION("attaching two children with the same name throws")
+    {
+        (void)buffers[0].create<ng::node>("item"_name, left);
+        buffers[1].attach(left, item);
+
+        REQUIRE_THROWS_AS(tree.apply(buffers), ng::invalid_node_name);
+        REQUIRE(left->child_count() == 1);
+        REQUIRE(buffers[0].empty());
+        REQUIRE(buffers[1].empty());
+    }
+}
+
+TEST_CASE("Buffers are recorded by the threads of a parallel update", "[node_command_buffer]")
+{
+    constexpr std::size_t squad_count = 64;
+    constexpr std::size_t squads_per_task = 4;
+
+    ng::node_tree tree;
+    auto root = tree.make_node<ng::node>("root"_name);
+    tree.set_root(root);
+
+    std::vector<ng::node*> squads;
+    for(std::size_t i = 0; i < squad_count; ++i)
+    {
+        squads.push_back(tree.make_node<ng::node>(ng::name{"squad" + std::to_string(i)}, root));
+    }
+
+    // Each task records to its own buffer while the tree is only read
+    std::vector<ng::node_command_buffer> buffers(squad_count / squads_per_task);
+
+    ng::thread_pool pool{3};
+    pool.parallel_for(squad_count, squads_per_task, [&](std::size_t begin, std::size_t end)
+    {
+        ng::node_command_buffer& buffer = buffers[begin / squads_per_task];
+        for(std::size_t i = begin; i < end; ++i)
+        {
+            auto leader = buffer.create<ng::node>("leader"_name, squads[i]);
+            (void)buffer.create<ng::node>("follower"_name, leader);
+
+            // Every squad joins the previous one
+            if(i > 0)
+            {
+                buffer.attach(squads[i - 1], squads[i]);
+            }
+        }
+    });
+
+    tree.apply(buffers);
+
+    REQUIRE(root->child_count() == 1);
+
+    const ng::node* squad = squads[0];
+    for(std::size_t i = 0; i < squad_count; ++i)
+    {
+        REQUIRE(squad->find_child("leader"_name)->find_child("follower"_name));
+
+        squad = squad->find_child(ng::name{"squad" + std::to_string(i + 1)});
+    }
+
+    REQUIRE_FALSE(squad);
+}
@@ -1,5 +1,9 @@
 #include <catch.hpp>
 #include <ng/gameplay/node_path.hpp>
+#include <ng/core/hash.hpp>
+
+#include <string>
+#include <unordered_map>
 
 using namespace ng::literals;
 
@@ -68,4 +72,85 @@ TEST_CASE("A path can be appended to another path", "[nodepath]")
     {
         REQUIRE("hello/world/patate"_node / "pouet/hurry"_node == "hello/world/patate/pouet/hurry"_node);
     }
+}
+
+TEST_CASE("A path can be iterated", "[nodepath]")
+{
+    const ng::node_path path{"/hello//world/"};
+
+    REQUIRE(path.size() == 3);
+
+    auto it = path.begin();
+    REQUIRE(*it == "hello");
+
+    ++it;
+    REQUIRE((*it).empty());
+
+    ++it;
+    REQUIRE(*it == "world");
+
+    ++it;
+    REQUIRE(it == path.end());
+}
+
+TEST_CASE("A path can be converted back to a string", "[nodepath]")
+{
+    SECTION("the string is the parsed string")
+    {
+        REQUIRE("/hello//world/"_node.string() == "/hello//world/");
+        REQUIRE("hello/world"_node.string() == "hello/world");
+        REQUIRE("/"_node.string() == "/");
+        REQUIRE(""_node.string().empty());
+    }
+
+    SECTION("normalized and appended paths are converted with their delimiters")
+    {
+        REQUIRE("//hello/./world//"_node.normalize().string() == "/hello/world/");
+        REQUIRE(("/hello/"_node / "world/"_node).string() == "/hello/world/");
+    }
+
+    SECTION("deep paths are not truncated")
+    {
+        std::string deep_path;
+        for(int i = 0; i < 100; ++i)
+        {
+            deep_path += "/element" + std::to_string(i);
+        }
+
+        const ng::node_path path{deep_path};
+
+        REQUIRE(path.size() == 100);
+        REQUIRE(path.string() == deep_path);
+        REQUIRE(*(--path.end()) == "element99");
+    }
+}
+
+TEST_CASE("Equal paths have the same hash", "[nodepath]")
+{
+    SECTION("the hash of a path is the hash of its string")
+    {
+        REQUIRE("/hello/world/"_node.hash() == ng::hash("/hello/world/"));
+        REQUIRE(""_node.hash() == ng::hash(""));
+    }
+
+    SECTION("appending to a path extends its hash")
+    {
+        REQUIRE(("/hello"_node / "world/"_node).hash() == "/hello/world/"_node.hash());
+        REQUIRE(("hello/"_node / "world"_node).hash() == "hello/world"_node.hash());
+    }
+
+    SECTION("normalizing a path gives the hash of the normalized string")
+    {
+        REQUIRE("//hello/./world/../world"_node.normalize().hash() == "/hello/world"_node.hash());
+    }
+
+    SECTION("paths can be used as keys of hash maps")
+    {
+        std::unordered_map<ng::node_path, int> values;
+        values["/hello/world"_node] = 1;
+        values["/hello/there"_node] = 2;
+
+        REQUIRE(values.at("/hello"_node / "world"_node) == 1);
+        REQUIRE(values.count("/hello/world/"_node) == 0);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include <catch.hpp>
+#include <ng/gameplay/node_path_table.hpp>
+
+#include <unordered_map>
+#include <string>
+
+using namespace ng::literals;
+
+TEST_CASE("A node path table stores equal paths once", "[node_path_table]")
+{
+    ng::node_path_table table;
+
+    const ng::interned_node_path first = table.intern("/level/player"_node);
+    const ng::interned_node_path second = table.intern("/level"_node / "player"_node);
+    const ng::interned_node_path other = table.intern("/level/camera"_node);
+
+    REQUIRE(first == second);
+    REQUIRE(&first.path() == &second.path());
+    REQUIRE(first != other);
+    REQUIRE(table.size() == 2);
+
+    SECTION("paths can be found without storing them")
+    {
+        REQUIRE(table.find("/level/camera"_node) == other);
+        REQUIRE(table.find("/level/enemy"_node).empty());
+        REQUIRE(table.size() == 2);
+    }
+
+    SECTION("interned paths can be used as keys of hash maps")
+    {
+        std::unordered_map<ng::interned_node_path, int> values;
+        values[first] = 1;
+        values[other] = 2;
+
+        REQUIRE(values.at(second) == 1);
+    }
+
+    SECTION("interned paths stay valid while the table grows")
+    {
+        for(int i = 0; i < 1000; ++i)
+        {
+            (void)table.intern(ng::node_path{"/level/enemy_" + std::to_string(i)});
+        }
+
+        REQUIRE(first.path() == "/level/player"_node);
+        REQUIRE(table.intern("/level/player"_node) == first);
+    }
+}
\ No newline at end of file
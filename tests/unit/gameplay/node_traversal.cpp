@@ -0,0 +1,231 @@
+#include <catch.hpp>
+#include <ng/gameplay/node_traversal.hpp>
+#include <ng/gameplay/node2d.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+
+using namespace ng::literals;
+
+namespace
+{
+
+std::vector<ng::node*> visit(ng::node_range<ng::post_order_iterator> range)
+{
+    std::vector<ng::node*> visited;
+    for(ng::node& n : range)
+    {
+        visited.push_back(&n);
+    }
+
+    return visited;
+}
+
+}
+
+TEST_CASE("A subtree can be traversed in different orders", "[node_traversal]")
+{
+    ng::node_tree tree;
+
+    auto root = tree.make_node<ng::node>("root"_name);
+    auto child = tree.make_node<ng::node>("child"_name, root);
+    auto child2 = tree.make_node<ng::node>("child2"_name, root);
+    auto child3 = tree.make_node<ng::node>("child3"_name, root);
+    auto child4 = tree.make_node<ng::node>("child4"_name, child);
+    auto child5 = tree.make_node<ng::node>("child5"_name, child3);
+    auto child6 = tree.make_node<ng::node>("child6"_name, child5);
+
+    tree.set_root(root);
+
+    SECTION("pre-order visits parents before their children")
+    {
+        std::vector<ng::node*> visited;
+        for(ng::node& n : ng::pre_order(root))
+        {
+            visited.push_back(&n);
+        }
+
+        REQUIRE(visited == std::vector<ng::node*>{root, child, child4, child2, child3, child5, child6});
+    }
+
+    SECTION("post-order visits parents after their children")
+    {
+        REQUIRE(visit(ng::post_order(root)) == std::vector<ng::node*>{child4, child, child2, child6, child5, child3, root});
+    }
+
+    SECTION("post-order only visits the subtree")
+    {
+        REQUIRE(visit(ng::post_order(child3)) == std::vector<ng::node*>{child6, child5, child3});
+        REQUIRE(visit(ng::post_order(child2)) == std::vector<ng::node*>{child2});
+    }
+
+    SECTION("breadth first visits the subtree level by level")
+    {
+        std::vector<ng::node*> queue;
+        std::vector<ng::node*> visited;
+        for(ng::node& n : ng::breadth_first(root, queue))
+        {
+            visited.push_back(&n);
+        }
+
+        REQUIRE(visited == std::vector<ng::node*>{root, child, child2, child3, child4, child5, child6});
+
+        // The queue can be reused for another traversal
+        visited.clear();
+        for(ng::node& n : ng::breadth_first(child3, queue))
+        {
+            visited.push_back(&n);
+        }
+
+        REQUIRE(visited == std::vector<ng::node*>{child3, child5, child6});
+    }
+}
+
+TEST_CASE("A subtree can be traversed from multiple threads", "[node_traversal]")
+{
+    ng::node_tree tree;
+
+    auto root = tree.make_node<ng::node>("root"_name);
+    std::vector<ng::node*> nodes{root};
+    for(std::size_t i = 1; i < 5000; ++i)
+    {
+        nodes.push_back(tree.make_node<ng::node>(ng::name{std::to_string(i)}, nodes[(i - 1) / 3]));
+    }
+
+    tree.set_root(root);
+
+    ng::thread_pool pool{3};
+    std::vector<ng::node*> work_items;
+
+    SECTION("every node is visited once")
+    {
+        std::atomic<std::size_t> visited_count{0};
+
+        ng::parallel_for_each(pool, root, work_items, [&visited_count](ng::node&)
+        {
+            ++visited_count;
+        });
+
+        REQUIRE(visited_count == nodes.size());
+    }
+
+    SECTION("a small subtree is visited without splitting it")
+    {
+        std::atomic<std::size_t> visited_count{0};
+
+        ng::parallel_for_each(pool, nodes.back(), work_items, [&visited_count](ng::node&)
+        {
+            ++visited_count;
+        });
+
+        REQUIRE(visited_count == 1);
+    }
+}
+
+TEST_CASE("Culling a subtree only visits the branches near the region", "[node_traversal]")
+{
+    ng::node_tree tree;
+
+    auto root = tree.make_node<ng::node>("root"_name);
+
+    // Two rooms far from each other, each with props around its center
+    auto near_room = tree.make_node<ng::node2d>("near_room"_name, ng::transform2d{glm::vec2{0.f, 0.f}}, root);
+    auto far_room = tree.make_node<ng::node2d>("far_room"_name, ng::transform2d{glm::vec2{1000.f, 0.f}}, root);
+
+    const ng::aabb2d prop_bounds = ng::aabb2d::from_center(glm::vec2{0.f, 0.f}, glm::vec2{1.f, 1.f});
+    auto near_prop = tree.make_node<ng::node2d>("near_prop"_name, ng::transform2d{glm::vec2{5.f, 0.f}}, near_room);
+    auto hidden_prop = tree.make_node<ng::node2d>("hidden_prop"_name, ng::transform2d{glm::vec2{50.f, 0.f}}, near_room);
+    auto far_prop = tree.make_node<ng::node2d>("far_prop"_name, ng::transform2d{glm::vec2{5.f, 0.f}}, far_room);
+    near_prop->set_local_bounds(prop_bounds);
+    hidden_prop->set_local_bounds(prop_bounds);
+    far_prop->set_local_bounds(prop_bounds);
+
+    // A plain node breaks the transform hierarchy, the node2d below it are still bounded by the far room
+    auto group = tree.make_node<ng::node>("group"_name, far_room);
+    auto grouped_prop = tree.make_node<ng::node2d>("grouped_prop"_name, ng::transform2d{glm::vec2{-5.f, 0.f}}, group);
+    grouped_prop->set_local_bounds(prop_bounds);
+
+    tree.set_root(root);
+    tree.update_world_transforms();
+
+    std::vector<ng::node*> pending;
+    std::vector<ng::node2d*> found;
+
+    SECTION("nodes intersecting the region are found")
+    {
+        ng::cull(root, ng::aabb2d::from_center(glm::vec2{0.f, 0.f}, glm::vec2{10.f, 10.f}), pending, found);
+
+        std::sort(found.begin(), found.end());
+        std::vector<ng::node2d*> expected{near_prop, grouped_prop};
+        std::sort(expected.begin(), expected.end());
+
+        REQUIRE(found == expected);
+    }
+
+    SECTION("nodes below a moved node without transform are bounded by their new node2d ancestor")
+    {
+        auto empty_room = tree.make_node<ng::node2d>("empty_room"_name, ng::transform2d{glm::vec2{2000.f, 0.f}}, root);
+        empty_room->attach_child(group);
+        tree.update_world_transforms();
+
+        ng::cull(empty_room, ng::aabb2d::from_center(glm::vec2{-5.f, 0.f}, glm::vec2{1.f, 1.f}), pending, found);
+        REQUIRE(found == std::vector<ng::node2d*>{grouped_prop});
+
+        found.clear();
+        ng::cull(far_room, ng::aabb2d::from_center(glm::vec2{-5.f, 0.f}, glm::vec2{1.f, 1.f}), pending, found);
+        REQUIRE(found.empty());
+    }
+
+    SECTION("moved nodes are found at their new position after the update")
+    {
+        far_room->set_local_transform(ng::transform2d{glm::vec2{0.f, 0.f}});
+        tree.update_world_transforms();
+
+        ng::cull(root, ng::aabb2d::from_center(glm::vec2{5.f, 0.f}, glm::vec2{1.f, 1.f}), pending, found);
+
+        std::sort(found.begin(), found.end());
+        std::vector<ng::node2d*> expected{near_prop, far_prop};
+        std::sort(expected.begin(), expected.end());
+
+        REQUIRE(found == expected);
+    }
+
+    SECTION("a region outside every subtree finds nothing")
+    {
+        ng::cull(root, ng::aabb2d::from_center(glm::vec2{500.f, 500.f}, glm::vec2{10.f, 10.f}), pending, found);
+
+        REQUIRE(found.empty());
+    }
+}
+
+
+TEST_CASE("A subtree can be traversed for a single type of node", "[node_traversal]")
+{
+    ng::node_tree tree;
+
+    auto root = tree.make_node<ng::node2d>("root"_name);
+    tree.set_root(root);
+    auto group = tree.make_node<ng::node>("group"_name, root);
+    auto first = tree.make_node<ng::node2d>("first"_name, group);
+    (void)tree.make_node<ng::node>("plain"_name, group);
+    auto second = tree.make_node<ng::node2d>("second"_name, root);
+
+    std::vector<ng::node2d*> visited;
+    for(ng::node2d& n : ng::pre_order_of<ng::node2d>(root))
+    {
+        visited.push_back(&n);
+    }
+
+    REQUIRE(visited == std::vector<ng::node2d*>{root, first, second});
+
+    SECTION("a subtree without that type is empty")
+    {
+        auto empty = tree.make_node<ng::node>("empty"_name, root);
+        (void)tree.make_node<ng::node>("child"_name, empty);
+
+        const auto range = ng::pre_order_of<ng::node2d>(empty);
+        REQUIRE(range.begin() == range.end());
+    }
+}
\ No newline at end of file
@@ -2,6 +2,9 @@
 #include <ng/gameplay/node_tree.hpp>
 #include <ng/gameplay/node.hpp>
 #include <ng/gameplay/node_path.hpp>
+#include <ng/gameplay/node2d.hpp>
+
+#include <string>
 
 using namespace ng::literals;
 
@@ -49,6 +52,76 @@ TEST_CASE("Specific node inside a tree can be found from a node path", "[node_tr
         ng::node* found_node = tree.find("/child3/child5/child7"_node);
         REQUIRE(found_node == nullptr);
     }
+
+    SECTION("can search for a node relative to another node")
+    {
+        REQUIRE(tree.find("child5/child6"_node, child3) == child6);
+        REQUIRE(tree.find("../child4"_node, child5) == child4);
+        REQUIRE(tree.find("/child3/child4"_node, child6) == child4);
+    }
+}
+
+TEST_CASE("Paths found in a node tree are resolved again when their route changes", "[node_tree]")
+{
+    ng::node_tree tree;
+
+    auto root = tree.make_node<ng::node>("root"_name);
+    auto child = tree.make_node<ng::node>("child"_name, root);
+    auto grand_child = tree.make_node<ng::node>("grand_child"_name, child);
+    auto other_child = tree.make_node<ng::node>("other_child"_name, root);
+
+    tree.set_root(root);
+
+    REQUIRE(tree.find("/child/grand_child"_node) == grand_child);
+    REQUIRE(tree.find("/child/grand_child"_node) == grand_child);
+
+    SECTION("after detaching a node on the route")
+    {
+        child->detach_from_parent();
+
+        REQUIRE(tree.find("/child/grand_child"_node) == nullptr);
+    }
+
+    SECTION("after moving the found node")
+    {
+        grand_child->attach_to(other_child);
+
+        REQUIRE(tree.find("/child/grand_child"_node) == nullptr);
+        REQUIRE(tree.find("/other_child/grand_child"_node) == grand_child);
+    }
+
+    SECTION("after renaming a node on the route")
+    {
+        child->rename("renamed"_name);
+
+        REQUIRE(tree.find("/child/grand_child"_node) == nullptr);
+        REQUIRE(tree.find("/renamed/grand_child"_node) == grand_child);
+    }
+
+    SECTION("after attaching the missing node of a path")
+    {
+        REQUIRE(tree.find("/child/missing"_node) == nullptr);
+
+        auto missing = tree.make_node<ng::node>("missing"_name, child);
+
+        REQUIRE(tree.find("/child/missing"_node) == missing);
+    }
+
+    SECTION("after renaming the root of a relative path")
+    {
+        REQUIRE(tree.find("root/child"_node) == child);
+
+        root->rename("new_root"_name);
+
+        REQUIRE(tree.find("root/child"_node) == nullptr);
+        REQUIRE(tree.find("new_root/child"_node) == child);
+    }
+
+    SECTION("a node can't be renamed like one of its siblings")
+    {
+        REQUIRE_THROWS_AS(child->rename("other_child"_name), ng::invalid_node_name);
+        REQUIRE(tree.find("/child/grand_child"_node) == grand_child);
+    }
 }
 
 TEST_CASE("Nodes inside a node tree can be iterated", "[node_tree]")
@@ -88,4 +161,232 @@ TEST_CASE("Nodes inside a node tree can be iterated", "[node_tree]")
 
     ++it;
     REQUIRE(it == tree.end());
-}
\ No newline at end of file
+}
+
+TEST_CASE("A node tree keeps the world transforms of the last captured tick", "[node_tree]")
+{
+    ng::node_tree tree;
+
+    auto root = tree.make_node<ng::node2d>("root"_name, ng::transform2d{glm::vec2{0.f, 0.f}});
+    auto child = tree.make_node<ng::node2d>("child"_name, ng::transform2d{glm::vec2{10.f, 0.f}}, root);
+    (void)tree.make_node<ng::node>("not_transformed"_name, root);
+
+    tree.set_root(root);
+
+    const ng::transform_store& transforms = tree.transforms();
+
+    SECTION("only node2d are tracked")
+    {
+        REQUIRE(transforms.size() == 2);
+    }
+
+    SECTION("a new node starts without any movement to interpolate")
+    {
+        tree.update_world_transforms();
+
+        std::vector<ng::affine2d> interpolated;
+        transforms.interpolate(0.f, interpolated);
+
+        REQUIRE(ng::transform2d{interpolated[child->transform_slot()].matrix()}.similar(ng::transform2d{glm::vec2{10.f, 0.f}}, 0.0001f));
+    }
+
+    SECTION("world transforms can be interpolated between the captured tick and the current tick")
+    {
+        tree.capture_world_transforms();
+
+        root->set_local_transform(ng::transform2d{glm::vec2{0.f, 10.f}});
+        tree.update_world_transforms();
+
+        std::vector<ng::affine2d> interpolated;
+        transforms.interpolate(0.5f, interpolated);
+
+        REQUIRE(interpolated.size() == transforms.nodes().size());
+        for(std::size_t i = 0; i < interpolated.size(); ++i)
+        {
+            const ng::transform2d expected = transforms.nodes()[i] == root
+                                           ? ng::transform2d{glm::vec2{0.f, 5.f}}
+                                           : ng::transform2d{glm::vec2{10.f, 5.f}};
+
+            REQUIRE(ng::transform2d{interpolated[i].matrix()}.similar(expected, 0.0001f));
+        }
+    }
+}
+
+TEST_CASE("The descendants of a node can be iterated", "[node_tree]")
+{
+    ng::node_tree tree;
+
+    auto root = tree.make_node<ng::node>("root"_name);
+    auto child = tree.make_node<ng::node>("child"_name, root);
+    auto grand_child = tree.make_node<ng::node>("grand_child"_name, child);
+    auto child2 = tree.make_node<ng::node>("child2"_name, root);
+
+    tree.set_root(root);
+
+    auto it = ng::node_tree::begin(child);
+    REQUIRE(&(*it) == child);
+
+    ++it;
+    REQUIRE(&(*it) == grand_child);
+
+    // The sibling of the subtree root is not part of the subtree
+    ++it;
+    REQUIRE(it == tree.end());
+    REQUIRE(child2->previous_sibling() == child);
+}
+
+namespace
+{
+
+class tracked_node : public ng::node
+{
+    std::size_t& destroyed_count_;
+
+public:
+    tracked_node(ng::node_tree& owner, ng::safe_name name, std::size_t& destroyed_count, ng::node* parent = nullptr)
+    : ng::node{owner, std::move(name), parent}
+    , destroyed_count_{destroyed_count}
+    {
+
+    }
+
+    ~tracked_node() override
+    {
+        ++destroyed_count_;
+    }
+};
+
+}
+
+TEST_CASE("A node tree frees the nodes that are no longer reachable", "[node_tree]")
+{
+    ng::node_tree tree;
+    std::size_t destroyed_count = 0;
+
+    auto root = tree.make_node<tracked_node>("root"_name, destroyed_count);
+    auto child = tree.make_node<tracked_node>("child"_name, destroyed_count, root);
+    auto detached = tree.make_node<tracked_node>("detached"_name, destroyed_count, root);
+    auto detached_child = tree.make_node<tracked_node>("detached_child"_name, destroyed_count, detached);
+
+    tree.set_root(root);
+
+    detached->detach_from_parent();
+
+    REQUIRE(tree.reachable(child));
+    REQUIRE_FALSE(tree.reachable(detached));
+    REQUIRE_FALSE(tree.reachable(detached_child));
+
+    tree.free_unreachable_nodes();
+
+    REQUIRE(destroyed_count == 2);
+    REQUIRE(root->first_child() == child);
+}
+
+TEST_CASE("A node tree can free unreachable nodes incrementally", "[node_tree]")
+{
+    ng::node_tree tree;
+    std::size_t destroyed_count = 0;
+
+    auto root = tree.make_node<tracked_node>("root"_name, destroyed_count);
+    auto kept = tree.make_node<tracked_node>("kept"_name, destroyed_count, root);
+    auto removed = tree.make_node<tracked_node>("removed"_name, destroyed_count, root);
+
+    constexpr std::size_t nodes_per_subtree = 5000;
+    for(std::size_t i = 0; i < nodes_per_subtree; ++i)
+    {
+        (void)tree.make_node<tracked_node>(ng::name{std::to_string(i)}, destroyed_count, kept);
+        (void)tree.make_node<tracked_node>(ng::name{std::to_string(i)}, destroyed_count, removed);
+    }
+
+    // Not reachable when the collection starts
+    auto moved = tree.make_node<tracked_node>("moved"_name, destroyed_count);
+
+    tree.set_root(root);
+    removed->detach_from_parent();
+
+    std::size_t step_count = 0;
+
+    // Without any budget, each step only processes a few nodes
+    REQUIRE_FALSE(tree.free_unreachable_nodes(ng::frame_duration{0}));
+    REQUIRE(tree.collecting());
+    ++step_count;
+
+    // Attached to a node that could have already been visited
+    moved->attach_to(root);
+
+    // Created during the collection
+    auto created = tree.make_node<tracked_node>("created"_name, destroyed_count, root);
+
+    while(!tree.free_unreachable_nodes(ng::frame_duration{0}))
+    {
+        ++step_count;
+    }
+
+    REQUIRE(step_count > 1);
+    REQUIRE_FALSE(tree.collecting());
+    REQUIRE(destroyed_count == nodes_per_subtree + 1);
+    REQUIRE(moved->parent() == root);
+    REQUIRE(created->parent() == root);
+}
+
+TEST_CASE("A node tree keeps the nodes attached while it frees unreachable nodes", "[node_tree]")
+{
+    ng::node_tree tree;
+    std::size_t destroyed_count = 0;
+
+    auto root = tree.make_node<tracked_node>("root"_name, destroyed_count);
+    tree.set_root(root);
+
+    // Not reachable when the collection starts, swept after the garbage
+    auto attached = tree.make_node<tracked_node>("attached"_name, destroyed_count);
+    auto attached_child = tree.make_node<tracked_node>("child"_name, destroyed_count, attached);
+
+    constexpr std::size_t garbage_count = 5000;
+    for(std::size_t i = 0; i < garbage_count; ++i)
+    {
+        (void)tree.make_node<tracked_node>(ng::name{std::to_string(i)}, destroyed_count);
+    }
+
+    // Only the root is marked, the first step already frees nodes
+    REQUIRE_FALSE(tree.free_unreachable_nodes(ng::frame_duration{0}));
+    REQUIRE(destroyed_count > 0);
+
+    attached->attach_to(root);
+
+    std::size_t step_count = 1;
+    while(!tree.free_unreachable_nodes(ng::frame_duration{0}))
+    {
+        ++step_count;
+    }
+
+    REQUIRE(step_count > 1);
+    REQUIRE(destroyed_count == garbage_count);
+    REQUIRE(root->child_count() == 1);
+    REQUIRE(attached->parent() == root);
+    REQUIRE(attached_child->parent() == attached);
+}
+
+TEST_CASE("A node tree stores nodes of the same type together", "[node_tree]")
+{
+    ng::node_tree tree;
+    tree.reserve<ng::node2d>(3);
+
+    auto first = tree.make_node<ng::node2d>("first"_name);
+    auto second = tree.make_node<ng::node2d>("second"_name);
+    auto other = tree.make_node<ng::node>("other"_name);
+    auto third = tree.make_node<ng::node2d>("third"_name);
+
+    const auto address = [](const ng::node* n) { return reinterpret_cast<std::uintptr_t>(n); };
+
+    REQUIRE(address(second) - address(first) == sizeof(ng::node2d));
+    REQUIRE(address(third) - address(second) == sizeof(ng::node2d));
+
+    SECTION("the memory of a freed node is reused by the next node of the same type")
+    {
+        tree.set_root(other);
+        tree.free_unreachable_nodes();
+
+        auto reused = tree.make_node<ng::node2d>("reused"_name);
+        REQUIRE((address(reused) == address(first) || address(reused) == address(second) || address(reused) == address(third)));
+    }
+}
@@ -0,0 +1,193 @@
+#include <catch.hpp>
+#include <node_names.hpp>
+#include <ng/gameplay/node_tree_snapshot.hpp>
+#include <ng/gameplay/node_tree.hpp>
+#include <ng/gameplay/node2d.hpp>
+
+#include <string>
+#include <vector>
+#include <utility>
+
+using namespace ng::literals;
+
+TEST_CASE("A snapshot gives back the structure of a tree", "[node_tree_snapshot]")
+{
+    ng::node_tree tree;
+    auto root = tree.make_node<ng::node>("root"_name);
+    tree.set_root(root);
+    auto left = tree.make_node<ng::node>("left"_name, root);
+    auto right = tree.make_node<ng::node>("right"_name, root);
+    auto first = tree.make_node<ng::node>("first"_name, left);
+    auto second = tree.make_node<ng::node>("second"_name, left);
+    auto third = tree.make_node<ng::node>("third"_name, left);
+    auto leaf = tree.make_node<ng::node>("leaf"_name, right);
+
+    ng::node_tree_snapshot snapshot;
+    REQUIRE(snapshot.empty());
+
+    tree.snapshot(snapshot);
+    REQUIRE(snapshot.size() == 7);
+
+    SECTION("moved nodes go back to their parent, in their order")
+    {
+        second->attach_to(right);
+        first->detach_from_parent();
+        first->attach_to(left);
+
+        tree.restore(snapshot);
+
+        REQUIRE(ng::test::child_names(left) == std::vector<std::string>{"first", "second", "third"});
+        REQUIRE(ng::test::child_names(right) == std::vector<std::string>{"leaf"});
+        REQUIRE(second->parent() == left);
+    }
+
+    SECTION("renamed nodes get their name back")
+    {
+        third->rename("renamed"_name);
+        second->rename("third"_name);
+
+        tree.restore(snapshot);
+
+        REQUIRE(ng::test::child_names(left) == std::vector<std::string>{"first", "second", "third"});
+        REQUIRE(left->find_child("third"_name) == third);
+    }
+
+    SECTION("nodes attached since the snapshot are detached")
+    {
+        auto created = tree.make_node<ng::node>("created"_name, leaf);
+        left->attach_to(created);
+
+        tree.restore(snapshot);
+
+        REQUIRE(created->parent() == nullptr);
+        REQUIRE(created->leaf());
+        REQUIRE(left->parent() == root);
+        REQUIRE(ng::test::child_names(root) == std::vector<std::string>{"left", "right"});
+        REQUIRE(leaf->leaf());
+    }
+
+    SECTION("unchanged nodes are not touched")
+    {
+        auto created = tree.make_node<ng::node>("created"_name, first);
+        const auto unchanged_child = left->first_child();
+
+        tree.restore(snapshot);
+
+        REQUIRE(created->parent() == nullptr);
+        REQUIRE(left->first_child() == unchanged_child);
+        REQUIRE(ng::test::child_names(left) == std::vector<std::string>{"first", "second", "third"});
+    }
+
+    SECTION("a snapshot can be restored several times")
+    {
+        ng::node_tree_snapshot moved;
+        leaf->attach_to(first);
+        tree.snapshot(moved);
+
+        tree.restore(snapshot);
+        REQUIRE(leaf->parent() == right);
+
+        tree.restore(moved);
+        REQUIRE(leaf->parent() == first);
+        REQUIRE(right->leaf());
+
+        tree.restore(snapshot);
+        REQUIRE(leaf->parent() == right);
+        REQUIRE(first->leaf());
+    }
+
+    SECTION("the root is given back")
+    {
+        tree.set_root(leaf);
+
+        tree.restore(snapshot);
+
+        REQUIRE(tree.root() == root);
+    }
+
+    SECTION("detached nodes are not freed before the snapshot is restored")
+    {
+        left->detach_from_parent();
+        tree.free_unreachable_nodes();
+
+        tree.restore(snapshot);
+
+        REQUIRE(left->parent() == root);
+        REQUIRE(ng::test::child_names(left) == std::vector<std::string>{"first", "second", "third"});
+    }
+
+    SECTION("a moved snapshot keeps its nodes alive")
+    {
+        ng::node_tree_snapshot moved{std::move(snapshot)};
+        REQUIRE(snapshot.empty());
+
+        right->detach_from_parent();
+        tree.free_unreachable_nodes();
+
+        tree.restore(moved);
+
+        REQUIRE(right->parent() == root);
+        REQUIRE(ng::test::child_names(right) == std::vector<std::string>{"leaf"});
+    }
+}
+
+TEST_CASE("A snapshot gives back the local transforms of a tree", "[node_tree_snapshot]")
+{
+    ng::node_tree tree;
+    auto root = tree.make_node<ng::node2d>("root"_name, ng::transform2d{glm::vec2{1.f, 2.f}});
+    tree.set_root(root);
+    auto child = tree.make_node<ng::node2d>("child"_name, ng::transform2d{glm::vec2{3.f, 4.f}, 0.5f}, root);
+    auto other = tree.make_node<ng::node2d>("other"_name, ng::transform2d{glm::vec2{5.f, 6.f}}, root);
+    tree.update_world_transforms();
+
+    ng::node_tree_snapshot snapshot;
+    tree.snapshot(snapshot);
+
+    child->set_local_transform(ng::transform2d{glm::vec2{10.f, 10.f}, 1.f, glm::vec2{2.f, 2.f}});
+    root->set_local_transform(ng::transform2d{glm::vec2{-1.f, -1.f}});
+
+    SECTION("changed transforms are set again")
+    {
+        tree.restore(snapshot);
+        tree.update_world_transforms();
+
+        REQUIRE(child->local_transform().translation == glm::vec2{3.f, 4.f});
+        REQUIRE(child->local_transform().rotation == 0.5f);
+        REQUIRE(child->local_transform().scale == glm::vec2{1.f, 1.f});
+        REQUIRE(root->local_transform().translation == glm::vec2{1.f, 2.f});
+        REQUIRE(other->world_transform().translation == glm::vec2{6.f, 8.f});
+    }
+
+    SECTION("transforms are found after their slots moved")
+    {
+        other->attach_to(child);
+        auto created = tree.make_node<ng::node2d>("created"_name, root);
+        tree.update_world_transforms();
+
+        tree.restore(snapshot);
+        tree.update_world_transforms();
+
+        REQUIRE(other->parent() == root);
+        REQUIRE(created->parent() == nullptr);
+        REQUIRE(child->local_transform().translation == glm::vec2{3.f, 4.f});
+        REQUIRE(other->world_transform().translation == glm::vec2{6.f, 8.f});
+    }
+}
+TEST_CASE("A snapshot doesn't give the transform of a freed node to a new node", "[node_tree_snapshot]")
+{
+    ng::node_tree tree;
+    auto root = tree.make_node<ng::node2d>("root"_name);
+    tree.set_root(root);
+    (void)tree.make_node<ng::node2d>("detached"_name, ng::transform2d{glm::vec2{999.f, 999.f}});
+
+    ng::node_tree_snapshot snapshot;
+    tree.snapshot(snapshot);
+
+    // The memory of a freed node would be reused by the next node2d
+    tree.free_unreachable_nodes();
+    auto created = tree.make_node<ng::node2d>("created"_name, root);
+
+    tree.restore(snapshot);
+
+    REQUIRE(created->local_transform().translation == glm::vec2{0.f, 0.f});
+}
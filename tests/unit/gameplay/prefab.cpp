@@ -0,0 +1,101 @@
+#include <catch.hpp>
+#include <ng/gameplay/prefab.hpp>
+#include <ng/gameplay/node2d.hpp>
+#include <ng/gameplay/node_tree.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace ng::literals;
+
+namespace
+{
+
+class weapon_node : public ng::node2d
+{
+public:
+    weapon_node(ng::node_tree& owner, ng::safe_name name)
+    : ng::node2d{owner, std::move(name)}
+    {
+
+    }
+};
+
+}
+
+TEST_CASE("A prefab can be instantiated many times", "[prefab]")
+{
+    ng::prefab enemy;
+
+    const auto root = enemy.add<ng::node2d>("enemy"_name, ng::transform2d{glm::vec2{0.f, 0.f}});
+    const auto body = enemy.add<ng::node2d>("body"_name, ng::transform2d{glm::vec2{0.f, 10.f}}, root);
+    const auto weapon = enemy.add<weapon_node>("weapon"_name, ng::transform2d{glm::vec2{5.f, 0.f}}, body);
+    enemy.add<ng::node>("brain"_name, root);
+    enemy.set_local_bounds(weapon, ng::aabb2d::from_center(glm::vec2{0.f, 0.f}, glm::vec2{1.f, 1.f}));
+
+    REQUIRE(enemy.size() == 4);
+    REQUIRE(enemy.parent(weapon) == body);
+
+    ng::node_tree tree;
+    auto level = tree.make_node<ng::node2d>("level"_name, ng::transform2d{glm::vec2{100.f, 0.f}});
+    tree.set_root(level);
+
+    SECTION("instances copy the names, the hierarchy and the transforms of the prefab")
+    {
+        ng::node* instance = tree.instantiate(enemy, level);
+
+        REQUIRE(instance->name() == "enemy"_name);
+        REQUIRE(instance->parent() == level);
+        REQUIRE(tree.find("level/enemy/body/weapon"_node));
+        REQUIRE(tree.find("level/enemy/brain"_node));
+
+        auto spawned_weapon = dynamic_cast<weapon_node*>(tree.find("level/enemy/body/weapon"_node));
+        REQUIRE(spawned_weapon);
+        REQUIRE(spawned_weapon->world_transform().similar(ng::transform2d{glm::vec2{105.f, 10.f}}, 0.0001f));
+        REQUIRE(spawned_weapon->local_bounds().max == glm::vec2{1.f, 1.f});
+
+        tree.update_world_transforms();
+
+        std::vector<ng::node2d*> found;
+        tree.spatial().query(ng::aabb2d::from_center(glm::vec2{105.f, 10.f}, glm::vec2{1.f, 1.f}), found);
+        REQUIRE(found == std::vector<ng::node2d*>{spawned_weapon});
+    }
+
+    SECTION("instances can be renamed to live under the same parent")
+    {
+        for(std::size_t i = 0; i < 100; ++i)
+        {
+            tree.instantiate(enemy, ng::name{"enemy" + std::to_string(i)}, level);
+        }
+
+        REQUIRE(level->child_count() == 100);
+        REQUIRE(tree.find("level/enemy42/body/weapon"_node));
+        REQUIRE(tree.find("level/enemy99/brain"_node));
+    }
+
+    SECTION("instantiating under a parent with the same name throws")
+    {
+        tree.instantiate(enemy, level);
+
+        REQUIRE_THROWS_AS(tree.instantiate(enemy, level), ng::invalid_node_name);
+    }
+
+    SECTION("an instance can stay detached")
+    {
+        ng::node* instance = tree.instantiate(enemy);
+
+        REQUIRE(instance->root());
+        REQUIRE(!tree.reachable(instance));
+    }
+}
+
+TEST_CASE("A prefab checks the names of its nodes once", "[prefab]")
+{
+    ng::prefab prefab;
+
+    const auto root = prefab.add<ng::node>("root"_name);
+    prefab.add<ng::node>("child"_name, root);
+
+    REQUIRE_THROWS_AS(prefab.add<ng::node>("child"_name, root), ng::invalid_node_name);
+    REQUIRE(prefab.size() == 2);
+}
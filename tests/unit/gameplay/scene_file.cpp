@@ -0,0 +1,188 @@
+#include <catch.hpp>
+#include <ng/gameplay/scene_file.hpp>
+#include <ng/gameplay/node2d.hpp>
+#include <ng/gameplay/node_tree.hpp>
+#include <ng/gameplay/node_type_registry.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ng::literals;
+
+namespace
+{
+
+class spawner_node : public ng::node2d
+{
+public:
+    spawner_node(ng::node_tree& owner, ng::safe_name name)
+    : ng::node2d{owner, std::move(name)}
+    {
+
+    }
+};
+
+/**
+ * Copy a written scene in memory aligned like a mapped file
+ */
+std::vector<uint64_t> aligned_copy(const std::string& bytes)
+{
+    std::vector<uint64_t> memory((bytes.size() + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    std::memcpy(memory.data(), bytes.data(), bytes.size());
+
+    return memory;
+}
+
+}
+
+TEST_CASE("A subtree can be written and loaded back as a binary scene", "[scene_file]")
+{
+    ng::node_type_registry types;
+    types.add<spawner_node>("spawner"_name);
+
+    ng::node_tree source_tree;
+    auto level = source_tree.make_node<ng::node>("level"_name);
+    auto room = source_tree.make_node<ng::node2d>("room"_name, ng::transform2d{glm::vec2{100.f, 0.f}, 0.5f}, level);
+    auto spawner = source_tree.make_node<spawner_node>("spawner"_name);
+    spawner->attach_to(room);
+    spawner->set_local_transform(ng::transform2d{glm::vec2{0.f, 10.f}, 0.f, glm::vec2{2.f, 2.f}});
+    spawner->set_local_bounds(ng::aabb2d::from_center(glm::vec2{0.f, 0.f}, glm::vec2{1.f, 1.f}));
+    (void)source_tree.make_node<ng::node>("logic"_name, level);
+
+    std::ostringstream output;
+    ng::write_scene(level, types, output);
+    const std::vector<uint64_t> scene_memory = aligned_copy(output.str());
+
+    ng::node_tree tree;
+    auto root = tree.make_node<ng::node>("root"_name);
+    tree.set_root(root);
+
+    SECTION("the loaded nodes have the same types, names, hierarchy and transforms")
+    {
+        const ng::scene_view scene{scene_memory.data(), output.str().size()};
+
+        REQUIRE(scene.node_count() == 4);
+        REQUIRE(scene.node2d_count() == 2);
+
+        ng::node* loaded = tree.load(scene, types, root);
+
+        REQUIRE(loaded->name() == "level"_name);
+        REQUIRE(loaded->parent() == root);
+        REQUIRE(tree.find("root/level/logic"_node));
+
+        auto loaded_spawner = dynamic_cast<spawner_node*>(tree.find("root/level/room/spawner"_node));
+        REQUIRE(loaded_spawner);
+        REQUIRE(loaded_spawner->local_transform().similar(spawner->local_transform(), 0.0001f));
+        REQUIRE(loaded_spawner->world_transform().similar(spawner->world_transform(), 0.0001f));
+        REQUIRE(loaded_spawner->local_bounds().min == glm::vec2{-1.f, -1.f});
+        REQUIRE(loaded_spawner->local_bounds().max == glm::vec2{1.f, 1.f});
+
+        auto loaded_room = dynamic_cast<ng::node2d*>(tree.find("root/level/room"_node));
+        REQUIRE(loaded_room);
+        REQUIRE(loaded_room->local_bounds().empty());
+    }
+
+    SECTION("a scene file is loaded by mapping it in memory")
+    {
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "ngine_scene_file_test.ngscene";
+        {
+            std::ofstream file{path, std::ios::binary};
+            file << output.str();
+        }
+
+        ng::node* loaded = ng::load_scene(tree, path, types);
+        std::filesystem::remove(path);
+
+        REQUIRE(loaded->root());
+        REQUIRE(loaded->child_count() == 2);
+        REQUIRE(dynamic_cast<spawner_node*>(tree.find("room/spawner"_node, loaded)));
+    }
+
+    SECTION("loading a type that is not registered throws")
+    {
+        const ng::node_type_registry default_types;
+        const ng::scene_view scene{scene_memory.data(), output.str().size()};
+
+        REQUIRE_THROWS_AS(tree.load(scene, default_types), ng::scene_file_error);
+    }
+
+    SECTION("writing a type that is not registered throws")
+    {
+        const ng::node_type_registry default_types;
+        std::ostringstream rejected_output;
+
+        REQUIRE_THROWS_AS(ng::write_scene(level, default_types, rejected_output), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Invalid binary scenes are rejected", "[scene_file]")
+{
+    ng::node_type_registry types;
+
+    ng::node_tree source_tree;
+    auto root = source_tree.make_node<ng::node>("root"_name);
+    (void)source_tree.make_node<ng::node2d>("child"_name, root);
+
+    std::ostringstream output;
+    ng::write_scene(root, types, output);
+    const std::string bytes = output.str();
+
+    SECTION("a truncated scene")
+    {
+        const std::vector<uint64_t> memory = aligned_copy(bytes);
+
+        REQUIRE_THROWS_AS(ng::scene_view(memory.data(), bytes.size() - 1), ng::scene_file_error);
+        REQUIRE_THROWS_AS(ng::scene_view(memory.data(), 8), ng::scene_file_error);
+    }
+
+    SECTION("a file that is not a scene")
+    {
+        std::string corrupted = bytes;
+        corrupted[0] = 'X';
+        const std::vector<uint64_t> memory = aligned_copy(corrupted);
+
+        REQUIRE_THROWS_AS(ng::scene_view(memory.data(), corrupted.size()), ng::scene_file_error);
+    }
+
+    SECTION("a node stored before its parent")
+    {
+        const std::vector<uint64_t> valid_memory = aligned_copy(bytes);
+        const ng::scene_view valid{valid_memory.data(), bytes.size()};
+
+        // Make the child its own parent
+        std::string corrupted = bytes;
+        const std::size_t child_parent_offset = reinterpret_cast<const char*>(valid.node_parents() + 1)
+                                              - reinterpret_cast<const char*>(valid_memory.data());
+        const uint32_t invalid_parent = 1;
+        std::memcpy(corrupted.data() + child_parent_offset, &invalid_parent, sizeof(invalid_parent));
+        const std::vector<uint64_t> memory = aligned_copy(corrupted);
+
+        REQUIRE_THROWS_AS(ng::scene_view(memory.data(), corrupted.size()), ng::scene_file_error);
+    }
+
+    SECTION("siblings with the same name")
+    {
+        (void)source_tree.make_node<ng::node>("sibling"_name, root);
+
+        std::ostringstream siblings_output;
+        ng::write_scene(root, types, siblings_output);
+        const std::string siblings_bytes = siblings_output.str();
+
+        const std::vector<uint64_t> valid_memory = aligned_copy(siblings_bytes);
+        const ng::scene_view valid{valid_memory.data(), siblings_bytes.size()};
+
+        // Give the name of the first child to the second one
+        std::string corrupted = siblings_bytes;
+        const std::size_t second_name_offset = reinterpret_cast<const char*>(valid.node_names() + 2)
+                                             - reinterpret_cast<const char*>(valid_memory.data());
+        const uint32_t first_name = valid.node_names()[1];
+        std::memcpy(corrupted.data() + second_name_offset, &first_name, sizeof(first_name));
+        const std::vector<uint64_t> memory = aligned_copy(corrupted);
+
+        REQUIRE_THROWS_AS(ng::scene_view(memory.data(), corrupted.size()), ng::scene_file_error);
+    }
+}
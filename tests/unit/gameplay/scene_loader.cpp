@@ -0,0 +1,166 @@
+#include <catch.hpp>
+#include <spatial_nodes.hpp>
+#include <ng/gameplay/scene_loader.hpp>
+#include <ng/gameplay/scene_file.hpp>
+#include <ng/gameplay/node2d.hpp>
+#include <ng/gameplay/node_tree.hpp>
+#include <ng/gameplay/node_type_registry.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace ng::literals;
+
+TEST_CASE("Merging a tree moves its nodes, transforms and spatial entries", "[scene_loader]")
+{
+    ng::node_tree tree;
+    auto world = tree.make_node<ng::node2d>("world"_name, ng::transform2d{glm::vec2{100.f, 0.f}});
+    tree.set_root(world);
+    auto existing = ng::test::make_bounded_node(tree, "existing", glm::vec2{0.f, 0.f}, 1.f, world);
+    tree.update_world_transforms();
+
+    ng::node_tree staging;
+    auto level = staging.make_node<ng::node2d>("level"_name, ng::transform2d{glm::vec2{0.f, 50.f}});
+    staging.set_root(level);
+    auto crate = ng::test::make_bounded_node(staging, "crate", glm::vec2{10.f, 0.f}, 1.f, level);
+    auto barrel = ng::test::make_bounded_node(staging, "barrel", glm::vec2{-10.f, 0.f}, 1.f, level);
+    (void)staging.make_node<ng::node>("logic"_name, level);
+    (void)staging.make_node<ng::node>("garbage"_name);
+    staging.update_world_transforms();
+
+    ng::node* merged = tree.merge(staging, world);
+
+    REQUIRE(merged == level);
+    REQUIRE(level->owner() == &tree);
+    REQUIRE(crate->owner() == &tree);
+    REQUIRE_FALSE(staging.root());
+    REQUIRE(staging.transforms().size() == 0);
+    REQUIRE(staging.spatial().size() == 0);
+    REQUIRE(tree.find("world/level/logic"_node));
+
+    tree.update_world_transforms();
+
+    REQUIRE(crate->world_transform().similar(ng::transform2d{glm::vec2{110.f, 50.f}}, 0.0001f));
+    REQUIRE(barrel->world_transform().similar(ng::transform2d{glm::vec2{90.f, 50.f}}, 0.0001f));
+    REQUIRE(existing->world_transform().similar(ng::transform2d{glm::vec2{100.f, 0.f}}, 0.0001f));
+    REQUIRE(tree.spatial().size() == 3);
+
+    std::vector<ng::node2d*> nodes;
+    tree.spatial().query(ng::aabb2d::from_center(glm::vec2{110.f, 50.f}, glm::vec2{2.f, 2.f}), nodes);
+    REQUIRE(nodes == std::vector<ng::node2d*>{crate});
+
+    nodes.clear();
+    tree.spatial().query(ng::aabb2d::from_center(glm::vec2{100.f, 0.f}, glm::vec2{2.f, 2.f}), nodes);
+    REQUIRE(nodes == std::vector<ng::node2d*>{existing});
+
+    SECTION("merged nodes are freed by the tree once unreachable")
+    {
+        crate->detach_from_parent();
+        tree.free_unreachable_nodes();
+
+        REQUIRE(tree.spatial().size() == 2);
+        REQUIRE(tree.find("world/level/logic"_node));
+
+        nodes.clear();
+        tree.update_world_transforms();
+        tree.spatial().query(ng::aabb2d::from_center(glm::vec2{100.f, 0.f}, glm::vec2{20.f, 60.f}), nodes);
+        REQUIRE(nodes.size() == 2);
+        REQUIRE(ng::test::found(nodes, existing));
+        REQUIRE(ng::test::found(nodes, barrel));
+    }
+
+    SECTION("merged nodes are moved like the other nodes of the tree")
+    {
+        level->set_local_transform(ng::transform2d{glm::vec2{0.f, -50.f}});
+        tree.update_world_transforms();
+
+        nodes.clear();
+        tree.spatial().query(ng::aabb2d::from_center(glm::vec2{110.f, -50.f}, glm::vec2{2.f, 2.f}), nodes);
+        REQUIRE(nodes == std::vector<ng::node2d*>{crate});
+    }
+}
+
+TEST_CASE("A scene is loaded in the background then committed to a live tree", "[scene_loader]")
+{
+    const ng::node_type_registry types;
+
+    std::ostringstream output;
+    {
+        ng::node_tree source_tree;
+        auto level = source_tree.make_node<ng::node>("level"_name);
+        for(int i = 0; i < 10; ++i)
+        {
+            (void)ng::test::make_bounded_node(source_tree, "crate" + std::to_string(i),
+                                              glm::vec2{static_cast<float>(i) * 10.f, 0.f}, 1.f, level);
+        }
+
+        ng::write_scene(level, types, output);
+    }
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "ngine_scene_loader_test.ngscene";
+    {
+        std::ofstream file{path, std::ios::binary};
+        file << output.str();
+    }
+
+    ng::node_tree tree;
+    auto root = tree.make_node<ng::node>("root"_name);
+    tree.set_root(root);
+
+    SECTION("the committed scene is part of the tree")
+    {
+        ng::scene_loader loader{path, types};
+        loader.wait();
+
+        REQUIRE(loader.finished());
+        REQUIRE(loader.progress().node_count() == 11);
+        REQUIRE(loader.progress().ratio() == 1.f);
+
+        ng::node* level = loader.commit(tree, root);
+        std::filesystem::remove(path);
+
+        REQUIRE(level);
+        REQUIRE(level->parent() == root);
+        REQUIRE(level->child_count() == 10);
+        REQUIRE_FALSE(loader.commit(tree, root));
+
+        tree.update_world_transforms();
+
+        auto crate = dynamic_cast<ng::node2d*>(tree.find("root/level/crate3"_node));
+        REQUIRE(crate);
+        REQUIRE(crate->world_transform().similar(ng::transform2d{glm::vec2{30.f, 0.f}}, 0.0001f));
+
+        std::vector<ng::node2d*> nodes;
+        tree.spatial().query(ng::aabb2d::from_center(glm::vec2{30.f, 0.f}, glm::vec2{2.f, 2.f}), nodes);
+        REQUIRE(nodes == std::vector<ng::node2d*>{crate});
+    }
+
+    SECTION("a cancelled load creates nothing more")
+    {
+        ng::scene_load_progress progress;
+        progress.cancel();
+
+        const std::string bytes = output.str();
+        std::vector<uint64_t> memory((bytes.size() + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+        std::copy(bytes.begin(), bytes.end(), reinterpret_cast<char*>(memory.data()));
+
+        REQUIRE_FALSE(tree.load(ng::scene_view{memory.data(), bytes.size()}, types, root, &progress));
+        REQUIRE(root->child_count() == 0);
+        REQUIRE(progress.node_count() == 11);
+
+        std::filesystem::remove(path);
+    }
+
+    SECTION("errors of the background thread are thrown by commit")
+    {
+        std::filesystem::remove(path);
+
+        ng::scene_loader loader{path, types};
+
+        REQUIRE_THROWS_AS(loader.commit(tree, root), std::system_error);
+    }
+}
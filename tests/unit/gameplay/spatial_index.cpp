@@ -0,0 +1,148 @@
+#include <catch.hpp>
+#include <spatial_nodes.hpp>
+#include <ng/gameplay/spatial_index.hpp>
+#include <ng/gameplay/node2d.hpp>
+#include <ng/gameplay/node_tree.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace ng::literals;
+
+TEST_CASE("The spatial index finds the nodes in a region", "[spatial_index]")
+{
+    ng::node_tree tree;
+
+    auto near_origin = ng::test::make_bounded_node(tree, "near_origin", glm::vec2{0.f, 0.f});
+    auto right = ng::test::make_bounded_node(tree, "right", glm::vec2{100.f, 0.f});
+    auto far_away = ng::test::make_bounded_node(tree, "far_away", glm::vec2{10000.f, -10000.f});
+    auto large = ng::test::make_bounded_node(tree, "large", glm::vec2{-500.f, 0.f}, 400.f);
+
+    REQUIRE(tree.spatial().size() == 4);
+
+    std::vector<ng::node2d*> nodes;
+
+    SECTION("nodes overlapping a box are found")
+    {
+        tree.spatial().query(ng::aabb2d{glm::vec2{-2.f, -2.f}, glm::vec2{99.5f, 2.f}}, nodes);
+
+        REQUIRE(nodes.size() == 2);
+        REQUIRE(ng::test::found(nodes, near_origin));
+        REQUIRE(ng::test::found(nodes, right));
+    }
+
+    SECTION("large nodes are found from their edges")
+    {
+        tree.spatial().query(ng::aabb2d{glm::vec2{-105.f, -5.f}, glm::vec2{-101.f, 5.f}}, nodes);
+
+        REQUIRE(nodes == std::vector<ng::node2d*>{large});
+    }
+
+    SECTION("nodes overlapping a circle are found")
+    {
+        tree.spatial().query(glm::vec2{50.f, 0.f}, 49.5f, nodes);
+
+        REQUIRE(nodes.size() == 2);
+        REQUIRE(ng::test::found(nodes, near_origin));
+        REQUIRE(ng::test::found(nodes, right));
+
+        nodes.clear();
+        tree.spatial().query(glm::vec2{50.f, 0.f}, 48.f, nodes);
+
+        REQUIRE(nodes.empty());
+    }
+
+    SECTION("the nearest nodes are found from the closest")
+    {
+        tree.spatial().nearest(glm::vec2{90.f, 0.f}, 2, nodes);
+
+        REQUIRE(nodes == std::vector<ng::node2d*>{right, near_origin});
+
+        nodes.clear();
+        tree.spatial().nearest(glm::vec2{90.f, 0.f}, 10, nodes);
+
+        REQUIRE(nodes.size() == 4);
+        REQUIRE(nodes.back() == far_away);
+    }
+}
+
+TEST_CASE("The spatial index follows the nodes when the world transforms are updated", "[spatial_index]")
+{
+    ng::node_tree tree;
+
+    auto parent = tree.make_node<ng::node2d>("parent"_name);
+    auto child = ng::test::make_bounded_node(tree, "child", glm::vec2{10.f, 0.f}, 1.f, parent);
+    auto other = ng::test::make_bounded_node(tree, "other", glm::vec2{-10.f, 0.f});
+
+    std::vector<ng::node2d*> nodes;
+    const ng::aabb2d moved_region{glm::vec2{995.f, -5.f}, glm::vec2{1015.f, 5.f}};
+
+    parent->set_local_transform(ng::transform2d{glm::vec2{1000.f, 0.f}});
+
+    SECTION("moves are seen once the world transforms are updated")
+    {
+        tree.spatial().query(moved_region, nodes);
+        REQUIRE(nodes.empty());
+
+        tree.update_world_transforms();
+
+        tree.spatial().query(moved_region, nodes);
+        REQUIRE(nodes == std::vector<ng::node2d*>{child});
+        REQUIRE(child->world_bounds().center().x == Approx(1010.f));
+    }
+
+    SECTION("removed nodes are not found")
+    {
+        child->set_local_bounds(ng::aabb2d{});
+        tree.update_world_transforms();
+
+        tree.spatial().query(moved_region, nodes);
+        REQUIRE(nodes.empty());
+        REQUIRE(tree.spatial().size() == 1);
+        REQUIRE(child->local_bounds().empty());
+    }
+
+    SECTION("destroyed nodes leave the index")
+    {
+        tree.set_root(other);
+        tree.free_unreachable_nodes();
+
+        REQUIRE(tree.spatial().size() == 1);
+
+        tree.update_world_transforms();
+        tree.spatial().query(ng::aabb2d{glm::vec2{-11.f, -1.f}, glm::vec2{-9.f, 1.f}}, nodes);
+
+        REQUIRE(nodes == std::vector<ng::node2d*>{other});
+    }
+}
+
+TEST_CASE("The spatial index finds every node of a crowded region", "[spatial_index]")
+{
+    ng::node_tree tree;
+
+    std::vector<ng::node2d*> expected;
+    for(int i = 0; i < 400; ++i)
+    {
+        const glm::vec2 position{static_cast<float>(i % 20) * 16.f, static_cast<float>(i / 20) * 16.f};
+        auto n = ng::test::make_bounded_node(tree, std::to_string(i), position);
+
+        // Removing nodes moves the entries of other nodes
+        if(i % 7 == 0)
+        {
+            n->set_local_bounds(ng::aabb2d{});
+        }
+        else if(position.x <= 100.f && position.y <= 100.f)
+        {
+            expected.push_back(n);
+        }
+    }
+
+    std::vector<ng::node2d*> nodes;
+    tree.spatial().query(ng::aabb2d{glm::vec2{-0.5f, -0.5f}, glm::vec2{100.f, 100.f}}, nodes);
+
+    std::sort(nodes.begin(), nodes.end());
+    std::sort(expected.begin(), expected.end());
+
+    REQUIRE(nodes == expected);
+}
\ No newline at end of file
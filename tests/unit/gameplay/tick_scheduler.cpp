@@ -0,0 +1,290 @@
+#include <catch.hpp>
+#include <ng/gameplay/tick_scheduler.hpp>
+#include <ng/gameplay/node_tree.hpp>
+#include <ng/gameplay/node.hpp>
+#include <ng/core/thread_pool.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ng::literals;
+
+namespace
+{
+
+struct recording_node : ng::node
+{
+    std::vector<std::string>* ticks;
+    std::string label;
+    ng::frame_duration last_dt{0};
+    int tick_count = 0;
+
+    recording_node(ng::node_tree& owner, ng::safe_name name, std::vector<std::string>* ticks, std::string label)
+    : ng::node(owner, std::move(name))
+    , ticks{ticks}
+    , label{std::move(label)}
+    {
+
+    }
+
+    void on_tick(ng::frame_duration dt) override
+    {
+        last_dt = dt;
+        ++tick_count;
+
+        if(ticks)
+        {
+            ticks->push_back(label);
+        }
+    }
+};
+
+struct other_recording_node : recording_node
+{
+    using recording_node::recording_node;
+
+    void on_tick(ng::frame_duration dt) override
+    {
+        recording_node::on_tick(dt);
+    }
+};
+
+struct counting_node : ng::node
+{
+    std::atomic<int>* total;
+
+    counting_node(ng::node_tree& owner, ng::safe_name name, std::atomic<int>* total)
+    : ng::node(owner, std::move(name))
+    , total{total}
+    {
+
+    }
+
+    void on_tick(ng::frame_duration) override
+    {
+        total->fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+}
+
+TEST_CASE("Tick groups tick in the order of their dependencies", "[tick_scheduler]")
+{
+    ng::node_tree tree;
+    ng::tick_scheduler& scheduler = tree.scheduler();
+
+    std::vector<std::string> ticks;
+    auto late = tree.make_node<recording_node>("late"_name, &ticks, "late");
+    auto physics = tree.make_node<recording_node>("physics"_name, &ticks, "physics");
+    auto pre_physics = tree.make_node<recording_node>("pre_physics"_name, &ticks, "pre_physics");
+    auto post_physics = tree.make_node<recording_node>("post_physics"_name, &ticks, "post_physics");
+
+    scheduler.add(late, ng::tick_scheduler::late);
+    scheduler.add(physics, ng::tick_scheduler::physics);
+    scheduler.add(pre_physics, ng::tick_scheduler::pre_physics);
+    scheduler.add(post_physics, ng::tick_scheduler::post_physics);
+
+    scheduler.tick(ng::frame_duration{0.5});
+
+    REQUIRE(ticks == std::vector<std::string>{"pre_physics", "physics", "post_physics", "late"});
+    REQUIRE(physics->last_dt == ng::frame_duration{0.5});
+
+    SECTION("A new group ticks after its dependencies")
+    {
+        const ng::tick_group_id animation = scheduler.add_group(ng::tick_group_settings{}, {ng::tick_scheduler::physics});
+        scheduler.add_dependency(ng::tick_scheduler::post_physics, animation);
+
+        auto animated = tree.make_node<recording_node>("animated"_name, &ticks, "animation");
+        scheduler.add(animated, animation);
+
+        ticks.clear();
+        scheduler.tick(ng::frame_duration{0.5});
+
+        REQUIRE(ticks == std::vector<std::string>{"pre_physics", "physics", "animation", "post_physics", "late"});
+    }
+
+    SECTION("Groups can't depend on each other")
+    {
+        REQUIRE_THROWS_AS(scheduler.add_dependency(ng::tick_scheduler::pre_physics, ng::tick_scheduler::late),
+                          std::logic_error);
+
+        ticks.clear();
+        scheduler.tick(ng::frame_duration{0.5});
+
+        REQUIRE(ticks == std::vector<std::string>{"pre_physics", "physics", "post_physics", "late"});
+    }
+
+    SECTION("Nodes can't be registered through a base type")
+    {
+        auto derived = tree.make_node<other_recording_node>("derived"_name, &ticks, "derived");
+
+        REQUIRE_THROWS_AS(scheduler.add(static_cast<recording_node*>(derived), ng::tick_scheduler::physics),
+                          std::invalid_argument);
+        REQUIRE_FALSE(scheduler.contains(derived));
+    }
+}
+
+TEST_CASE("Tick groups with an interval receive the time elapsed since they last ticked", "[tick_scheduler]")
+{
+    ng::node_tree tree;
+    ng::tick_scheduler& scheduler = tree.scheduler();
+
+    ng::tick_group_settings settings;
+    settings.interval = ng::frame_duration{1.0};
+    const ng::tick_group_id slow = scheduler.add_group(settings);
+
+    auto slow_node = tree.make_node<recording_node>("slow"_name, nullptr, "");
+    auto fast_node = tree.make_node<recording_node>("fast"_name, nullptr, "");
+    scheduler.add(slow_node, slow);
+    scheduler.add(fast_node, ng::tick_scheduler::physics);
+
+    for(int i = 0; i < 3; ++i)
+    {
+        scheduler.tick(ng::frame_duration{0.25});
+    }
+
+    REQUIRE(fast_node->tick_count == 3);
+    REQUIRE(slow_node->tick_count == 0);
+
+    scheduler.tick(ng::frame_duration{0.25});
+
+    REQUIRE(fast_node->tick_count == 4);
+    REQUIRE(slow_node->tick_count == 1);
+    REQUIRE(slow_node->last_dt == ng::frame_duration{1.0});
+}
+
+TEST_CASE("Nodes of a tick group tick grouped by type", "[tick_scheduler]")
+{
+    ng::node_tree tree;
+    ng::tick_scheduler& scheduler = tree.scheduler();
+
+    std::vector<std::string> ticks;
+    auto first = tree.make_node<recording_node>("first"_name, &ticks, "recording");
+    auto second = tree.make_node<other_recording_node>("second"_name, &ticks, "other");
+    auto third = tree.make_node<recording_node>("third"_name, &ticks, "recording");
+
+    scheduler.add(first, ng::tick_scheduler::physics);
+    scheduler.add(second, ng::tick_scheduler::physics);
+    scheduler.add(third, ng::tick_scheduler::physics);
+
+    scheduler.tick(ng::frame_duration{0.5});
+
+    REQUIRE(ticks.size() == 3);
+    REQUIRE(ticks[0] == ticks[1]);
+    REQUIRE(ticks[1] != ticks[2]);
+}
+
+TEST_CASE("Nodes stop ticking once removed", "[tick_scheduler]")
+{
+    ng::node_tree tree;
+    ng::tick_scheduler& scheduler = tree.scheduler();
+
+    auto first = tree.make_node<recording_node>("first"_name, nullptr, "");
+    auto second = tree.make_node<recording_node>("second"_name, nullptr, "");
+    auto third = tree.make_node<recording_node>("third"_name, nullptr, "");
+
+    scheduler.add(first, ng::tick_scheduler::physics);
+    scheduler.add(second, ng::tick_scheduler::physics);
+    scheduler.add(third, ng::tick_scheduler::physics);
+
+    REQUIRE(scheduler.contains(second));
+
+    scheduler.remove(first);
+    scheduler.tick(ng::frame_duration{0.5});
+
+    REQUIRE_FALSE(scheduler.contains(first));
+    REQUIRE(first->tick_count == 0);
+    REQUIRE(second->tick_count == 1);
+    REQUIRE(third->tick_count == 1);
+
+    SECTION("Unreachable nodes are removed when freed")
+    {
+        tree.free_unreachable_nodes();
+
+        scheduler.tick(ng::frame_duration{0.5});
+    }
+}
+
+namespace
+{
+
+struct spawning_node : ng::node
+{
+    recording_node* spawned;
+    recording_node* removed;
+
+    spawning_node(ng::node_tree& owner, ng::safe_name name, recording_node* spawned, recording_node* removed)
+    : ng::node(owner, std::move(name))
+    , spawned{spawned}
+    , removed{removed}
+    {
+
+    }
+
+    void on_tick(ng::frame_duration) override
+    {
+        owner()->scheduler().add(spawned, ng::tick_scheduler::physics);
+        owner()->scheduler().remove(removed);
+    }
+};
+
+}
+
+TEST_CASE("Nodes added or removed while ticking change the next tick", "[tick_scheduler]")
+{
+    ng::node_tree tree;
+    ng::tick_scheduler& scheduler = tree.scheduler();
+
+    auto spawned = tree.make_node<recording_node>("spawned"_name, nullptr, "");
+    auto removed = tree.make_node<recording_node>("removed"_name, nullptr, "");
+    auto other = tree.make_node<recording_node>("other"_name, nullptr, "");
+    auto spawner = tree.make_node<spawning_node>("spawner"_name, spawned, removed);
+
+    scheduler.add(spawner, ng::tick_scheduler::pre_physics);
+    scheduler.add(removed, ng::tick_scheduler::physics);
+    scheduler.add(other, ng::tick_scheduler::physics);
+
+    scheduler.tick(ng::frame_duration{0.5});
+
+    REQUIRE(spawned->tick_count == 0);
+    REQUIRE(removed->tick_count == 0);
+    REQUIRE(other->tick_count == 1);
+    REQUIRE(scheduler.contains(spawned));
+
+    scheduler.remove(spawner);
+    scheduler.tick(ng::frame_duration{0.5});
+
+    REQUIRE(spawned->tick_count == 1);
+    REQUIRE(other->tick_count == 2);
+
+    scheduler.remove(other);
+    scheduler.tick(ng::frame_duration{0.5});
+
+    REQUIRE(spawned->tick_count == 2);
+    REQUIRE(other->tick_count == 2);
+}
+
+TEST_CASE("Thread safe tick groups tick their nodes from multiple threads", "[tick_scheduler]")
+{
+    ng::node_tree tree;
+    ng::tick_scheduler& scheduler = tree.scheduler();
+    ng::thread_pool pool{3};
+
+    scheduler.settings(ng::tick_scheduler::physics).thread_safe = true;
+
+    std::atomic<int> total{0};
+    constexpr int node_count = 1000;
+    for(int i = 0; i < node_count; ++i)
+    {
+        auto n = tree.make_node<counting_node>(ng::safe_name{"node" + std::to_string(i)}, &total);
+        scheduler.add(n, ng::tick_scheduler::physics);
+    }
+
+    scheduler.tick(ng::frame_duration{0.5}, pool);
+    REQUIRE(total == node_count);
+
+    scheduler.tick(ng::frame_duration{0.5});
+    REQUIRE(total == 2 * node_count);
+}
\ No newline at end of file
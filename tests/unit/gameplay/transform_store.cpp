@@ -0,0 +1,239 @@
+#include <catch.hpp>
+#include <ng/gameplay/node2d.hpp>
+#include <ng/gameplay/node_tree.hpp>
+#include <ng/core/thread_pool.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace ng::literals;
+
+namespace
+{
+
+bool parents_before_children(const ng::transform_store& transforms)
+{
+    for(std::size_t slot = 0; slot < transforms.size(); ++slot)
+    {
+        const ng::transform_store::slot_type parent = transforms.parents()[slot];
+
+        if(parent != ng::transform_store::invalid_slot && parent >= slot)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
+
+TEST_CASE("The transform store keeps parents before their children", "[transform_store]")
+{
+    ng::node_tree tree;
+
+    auto root = tree.make_node<ng::node2d>("root"_name, ng::transform2d{glm::vec2{10.f, 0.f}});
+    auto child = tree.make_node<ng::node2d>("child"_name, ng::transform2d{glm::vec2{0.f, 10.f}}, root);
+    auto other_root = tree.make_node<ng::node2d>("other_root"_name, ng::transform2d{glm::vec2{-10.f, 0.f}});
+
+    tree.set_root(root);
+    tree.update_world_transforms();
+
+    const ng::transform_store& transforms = tree.transforms();
+
+    REQUIRE(parents_before_children(transforms));
+
+    SECTION("reparenting a node under a node stored after it sorts the slots on the next update")
+    {
+        child->attach_to(other_root);
+        root->attach_to(other_root);
+        tree.update_world_transforms();
+
+        REQUIRE(parents_before_children(transforms));
+        REQUIRE(transforms.parents()[root->transform_slot()] == other_root->transform_slot());
+        REQUIRE(transforms.nodes()[child->transform_slot()] == child);
+
+        REQUIRE(ng::transform2d{transforms.worlds()[child->transform_slot()].matrix()}.similar(ng::transform2d{glm::vec2{-10.f, 10.f}}, 0.0001f));
+        REQUIRE(ng::transform2d{transforms.worlds()[root->transform_slot()].matrix()}.similar(ng::transform2d{glm::vec2{0.f, 0.f}}, 0.0001f));
+    }
+
+    SECTION("released slots are compacted on the next update")
+    {
+        child->detach_from_parent();
+        tree.set_root(other_root);
+        tree.free_unreachable_nodes();
+        tree.update_world_transforms();
+
+        REQUIRE(transforms.size() == 1);
+        REQUIRE(transforms.nodes()[other_root->transform_slot()] == other_root);
+    }
+}
+
+TEST_CASE("The transform store updates world transforms in a single pass", "[transform_store]")
+{
+    ng::node_tree tree;
+
+    auto root = tree.make_node<ng::node2d>("root"_name);
+    ng::node2d* parent = root;
+    for(int i = 0; i < 8; ++i)
+    {
+        parent = tree.make_node<ng::node2d>("level"_name, ng::transform2d{glm::vec2{1.f, 0.f}}, parent);
+    }
+
+    tree.set_root(root);
+
+    root->set_local_transform(ng::transform2d{glm::vec2{0.f, 0.f}, glm::radians(90.f)});
+    tree.update_world_transforms();
+
+    const ng::affine2d& deepest = tree.transforms().worlds()[parent->transform_slot()];
+    REQUIRE(deepest.transform_point(glm::vec2{0.f, 0.f}).x == Approx(0.f).margin(0.0001f));
+    REQUIRE(deepest.transform_point(glm::vec2{0.f, 0.f}).y == Approx(8.f));
+}
+
+TEST_CASE("Updating world transforms with multiple threads gives the same results", "[transform_store]")
+{
+    ng::node_tree tree;
+
+    auto root = tree.make_node<ng::node2d>("root"_name);
+    std::vector<ng::node2d*> parents{root};
+    for(std::size_t i = 0; i < 20000; ++i)
+    {
+        ng::node2d* parent = parents[i / 4];
+        const ng::transform2d transform{glm::vec2{static_cast<float>(i % 7), 1.f}, glm::radians(static_cast<float>(i % 13))};
+
+        parents.push_back(tree.make_node<ng::node2d>(ng::name{std::to_string(i)}, transform, parent));
+    }
+
+    tree.set_root(root);
+    tree.update_world_transforms();
+
+    root->set_local_transform(ng::transform2d{glm::vec2{5.f, 5.f}, glm::radians(30.f)});
+    parents[1000]->set_local_transform(ng::transform2d{glm::vec2{-5.f, 2.f}});
+
+    std::vector<ng::affine2d> expected(parents.size());
+    for(std::size_t i = 0; i < parents.size(); ++i)
+    {
+        expected[i] = parents[i]->world_affine();
+    }
+
+    root->set_local_transform(ng::transform2d{glm::vec2{0.f, 0.f}});
+    tree.update_world_transforms();
+    root->set_local_transform(ng::transform2d{glm::vec2{5.f, 5.f}, glm::radians(30.f)});
+
+    ng::thread_pool pool{3};
+    tree.update_world_transforms(pool);
+
+    const std::vector<std::size_t>& level_offsets = tree.transforms().level_offsets();
+    REQUIRE(level_offsets.back() == parents.size());
+
+    std::size_t different_count = 0;
+    for(std::size_t i = 0; i < parents.size(); ++i)
+    {
+        const ng::affine2d& world = tree.transforms().worlds()[parents[i]->transform_slot()];
+
+        if(world.tx != expected[i].tx || world.ty != expected[i].ty
+        || world.m00 != expected[i].m00 || world.m01 != expected[i].m01
+        || world.m10 != expected[i].m10 || world.m11 != expected[i].m11)
+        {
+            ++different_count;
+        }
+    }
+
+    REQUIRE(different_count == 0);
+}
+
+TEST_CASE("The transform store aggregates the bounds of every subtree", "[transform_store]")
+{
+    ng::node_tree tree;
+
+    auto root = tree.make_node<ng::node2d>("root"_name, ng::transform2d{glm::vec2{0.f, 0.f}});
+    auto left = tree.make_node<ng::node2d>("left"_name, ng::transform2d{glm::vec2{-100.f, 0.f}}, root);
+    auto right = tree.make_node<ng::node2d>("right"_name, ng::transform2d{glm::vec2{100.f, 0.f}}, root);
+    auto leaf = tree.make_node<ng::node2d>("leaf"_name, ng::transform2d{glm::vec2{0.f, 50.f}}, right);
+
+    const ng::aabb2d unit_bounds = ng::aabb2d::from_center(glm::vec2{0.f, 0.f}, glm::vec2{1.f, 1.f});
+    root->set_local_bounds(unit_bounds);
+    left->set_local_bounds(unit_bounds);
+    leaf->set_local_bounds(unit_bounds);
+
+    tree.set_root(root);
+    tree.update_world_transforms();
+
+    REQUIRE(leaf->subtree_bounds().min == glm::vec2{99.f, 49.f});
+    REQUIRE(leaf->subtree_bounds().max == glm::vec2{101.f, 51.f});
+
+    // Nodes without bounds still contain the bounds of their children
+    REQUIRE(right->subtree_bounds().min == glm::vec2{99.f, 49.f});
+    REQUIRE(right->subtree_bounds().max == glm::vec2{101.f, 51.f});
+
+    REQUIRE(root->subtree_bounds().min == glm::vec2{-101.f, -1.f});
+    REQUIRE(root->subtree_bounds().max == glm::vec2{101.f, 51.f});
+
+    SECTION("moving a node updates the bounds of its ancestors")
+    {
+        right->set_local_transform(ng::transform2d{glm::vec2{200.f, 0.f}});
+        tree.update_world_transforms();
+
+        REQUIRE(leaf->subtree_bounds().max == glm::vec2{201.f, 51.f});
+        REQUIRE(root->subtree_bounds().max == glm::vec2{201.f, 51.f});
+    }
+
+    SECTION("only the moved nodes are reported as changed")
+    {
+        right->set_local_transform(ng::transform2d{glm::vec2{200.f, 0.f}});
+        tree.update_world_transforms();
+
+        std::vector<ng::node2d*> changed;
+        for(ng::transform_store::slot_type slot : tree.transforms().changed_bounds())
+        {
+            changed.push_back(tree.transforms().nodes()[slot]);
+        }
+
+        std::sort(changed.begin(), changed.end());
+        std::vector<ng::node2d*> expected{right, leaf};
+        std::sort(expected.begin(), expected.end());
+
+        REQUIRE(changed == expected);
+    }
+
+    SECTION("growing the bounds of a node updates the bounds of its ancestors")
+    {
+        leaf->set_local_bounds(ng::aabb2d::from_center(glm::vec2{0.f, 0.f}, glm::vec2{10.f, 10.f}));
+        tree.update_world_transforms();
+
+        REQUIRE(right->subtree_bounds().min == glm::vec2{90.f, 40.f});
+        REQUIRE(root->subtree_bounds().max == glm::vec2{110.f, 60.f});
+    }
+
+    SECTION("reparenting a node shrinks the bounds of its previous parent")
+    {
+        leaf->attach_to(left);
+        tree.update_world_transforms();
+
+        REQUIRE(right->subtree_bounds().empty());
+        REQUIRE(left->subtree_bounds().min == glm::vec2{-101.f, -1.f});
+        REQUIRE(left->subtree_bounds().max == glm::vec2{-99.f, 51.f});
+        REQUIRE(root->subtree_bounds().max == glm::vec2{1.f, 51.f});
+    }
+
+    SECTION("freeing a node shrinks the bounds of its previous parent")
+    {
+        right->detach_from_parent();
+        tree.free_unreachable_nodes();
+        tree.update_world_transforms();
+
+        REQUIRE(root->subtree_bounds().min == glm::vec2{-101.f, -1.f});
+        REQUIRE(root->subtree_bounds().max == glm::vec2{1.f, 1.f});
+    }
+
+    SECTION("updating with multiple threads aggregates the same bounds")
+    {
+        ng::thread_pool pool{2};
+
+        right->set_local_transform(ng::transform2d{glm::vec2{200.f, 0.f}});
+        tree.update_world_transforms(pool);
+
+        REQUIRE(root->subtree_bounds().max == glm::vec2{201.f, 51.f});
+    }
+}
@@ -0,0 +1,30 @@
+#ifndef NGINE_TESTS_NODE_NAMES_HPP
+#define NGINE_TESTS_NODE_NAMES_HPP
+
+#include <ng/gameplay/node.hpp>
+
+#include <string>
+#include <vector>
+
+namespace ng::test
+{
+
+/**
+ * Returns the names of the children of a node
+ * @param parent The node
+ * @return The names of the children, in their order
+ */
+inline std::vector<std::string> child_names(const node* parent)
+{
+    std::vector<std::string> names;
+    for(const node* child = parent->first_child(); child; child = child->next_sibling())
+    {
+        names.emplace_back(child->name().c_str());
+    }
+
+    return names;
+}
+
+}
+
+#endif
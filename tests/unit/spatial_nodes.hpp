@@ -0,0 +1,50 @@
+#ifndef NGINE_TESTS_SPATIAL_NODES_HPP
+#define NGINE_TESTS_SPATIAL_NODES_HPP
+
+#include <ng/gameplay/node2d.hpp>
+#include <ng/gameplay/node_tree.hpp>
+#include <ng/core/aabb2d.hpp>
+#include <ng/core/name.hpp>
+#include <ng/core/transform2d.hpp>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace ng::test
+{
+
+/**
+ * Create a node with square bounds centered on its position
+ * @param tree The tree owning the node
+ * @param name The name of the node
+ * @param position The local position of the node
+ * @param half_size Half of the size of the bounds
+ * @param parent The parent of the node or nullptr
+ * @return The created node
+ */
+inline node2d* make_bounded_node(node_tree& tree, const std::string& name, const glm::vec2& position,
+                                 float half_size = 1.f, node* parent = nullptr)
+{
+    auto n = tree.make_node<node2d>(ng::name{name}, transform2d{position}, parent);
+    n->set_local_bounds(aabb2d::from_center(glm::vec2{0.f, 0.f}, glm::vec2{half_size}));
+
+    return n;
+}
+
+/**
+ * Check if a node is part of the nodes returned by a query
+ * @param nodes The returned nodes
+ * @param n The node to look for
+ * @return true when the node was returned
+ */
+inline bool found(const std::vector<node2d*>& nodes, const node2d* n)
+{
+    return std::find(nodes.begin(), nodes.end(), n) != nodes.end();
+}
+
+}
+
+#endif